@@ -21,6 +21,7 @@
 
 #include "ODApplication.h"
 
+#include "gamemap/MapBenchmark.h"
 #include "network/ODServer.h"
 #include "network/ODClient.h"
 #include "network/ServerMode.h"
@@ -29,13 +30,16 @@
 #include "render/Gui.h"
 #include "render/ODFrameListener.h"
 #include "render/TextRenderer.h"
+#include "utils/BenchmarkReport.h"
 #include "utils/ConfigManager.h"
+#include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/LogSinkConsole.h"
 #include "utils/LogSinkFile.h"
 #include "utils/LogSinkOgre.h"
 #include "utils/Random.h"
 #include "utils/ResourceManager.h"
+#include "utils/StartupTimings.h"
 
 #include <OgreErrorDialog.h>
 #include <OgreRenderWindow.h>
@@ -43,8 +47,10 @@
 #include <Overlay/OgreOverlaySystem.h>
 #include <RTShaderSystem/OgreShaderGenerator.h>
 
+#include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <fstream>
@@ -59,7 +65,9 @@ void ODApplication::startGame(boost::program_options::variables_map& options)
     logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
     logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkFile(resMgr.getLogFile())));
 
-    if(resMgr.isServerMode())
+    if(resMgr.isBenchmarkMode())
+        startBenchmark();
+    else if(resMgr.isServerMode())
         startServer();
     else
         startClient();
@@ -71,8 +79,11 @@ void ODApplication::startServer()
 
     OD_LOG_INF("Initializing");
 
+    StartupTimings startupTimings;
     Random::initialize();
-    ConfigManager configManager(resMgr.getConfigPath(), "", resMgr.getSoundPath());
+    ConfigManager configManager(resMgr.getConfigPath(), "", resMgr.getSoundPath(), &startupTimings);
+    configManager.waitDefinitionsLoaded();
+    startupTimings.logReport();
     OD_LOG_INF("Launching server");
 
     const std::string& creator = resMgr.getServerModeCreator();
@@ -94,9 +105,74 @@ void ODApplication::startServer()
     server.stopServer();
 }
 
+void ODApplication::startBenchmark()
+{
+    ResourceManager& resMgr = ResourceManager::getSingleton();
+
+    OD_LOG_INF("Initializing");
+
+    StartupTimings startupTimings;
+    Random::initialize();
+    ConfigManager configManager(resMgr.getConfigPath(), "", resMgr.getSoundPath(), &startupTimings);
+    configManager.waitDefinitionsLoaded();
+    startupTimings.logReport();
+
+    // The server is not started. It is only needed because the game map sends its notifications through it
+    ODServer server;
+
+    std::vector<std::string> levels;
+    for(const std::string& path : { resMgr.getGameLevelPathSkirmish(), resMgr.getGameLevelPathMultiplayer() })
+    {
+        for(const std::string& file : ResourceManager::listAllFiles(path))
+        {
+            if(boost::filesystem::path(file).extension() == ".level")
+                levels.push_back(file);
+        }
+    }
+    // The directory order depends on the file system
+    std::sort(levels.begin(), levels.end());
+
+    std::vector<BenchmarkResult> results;
+    for(const std::string& level : levels)
+        MapBenchmark::runLevel(level, results);
+
+    BenchmarkReport::sortResults(results);
+    std::ofstream output(resMgr.getBenchmarkOutput());
+    if(!output.is_open())
+    {
+        OD_LOG_ERR("Cannot write benchmark results to " + resMgr.getBenchmarkOutput());
+        return;
+    }
+    output << BenchmarkReport::toJson(results);
+    output.close();
+    OD_LOG_INF("Benchmark results written to " + resMgr.getBenchmarkOutput());
+
+    if(resMgr.getBenchmarkBaseline().empty())
+        return;
+
+    std::ifstream baselineFile(resMgr.getBenchmarkBaseline());
+    std::vector<BenchmarkResult> baseline;
+    if(!BenchmarkReport::fromJson(baselineFile, baseline))
+    {
+        OD_LOG_ERR("Cannot read benchmark baseline " + resMgr.getBenchmarkBaseline());
+        return;
+    }
+
+    // Timings vary from one run to another. Only changes greater than this are reported as slower
+    const double tolerance = 0.1;
+    std::string report;
+    uint32_t nbRegressions = BenchmarkReport::compare(results, baseline, tolerance, report);
+    OD_LOG_INF("Comparison with " + resMgr.getBenchmarkBaseline() + ":\n" + report);
+    if(nbRegressions > 0)
+        OD_LOG_WRN(Helper::toString(nbRegressions) + " benchmarks are slower or return different results than the baseline");
+    else
+        OD_LOG_INF("No regression compared to the baseline");
+}
+
 void ODApplication::startClient()
 {
     ResourceManager& resMgr = ResourceManager::getSingleton();
+    StartupTimings startupTimings;
 
     {
         //NOTE: This prevents a segmentation fault from OpenGL on exit.
@@ -113,8 +189,10 @@ void ODApplication::startClient()
     // N.B: We don't use any ogre.cfg file, hence setting the file path value to "".
     Ogre::Root ogreRoot(resMgr.getPluginsPath(), "");
 
+    // The definition files are parsed in background threads while Ogre and its resources
+    // are initialized
     ConfigManager configManager(resMgr.getConfigPath(), resMgr.getUserCfgFile(),
-        resMgr.getSoundPath());
+        resMgr.getSoundPath(), &startupTimings);
 
     if (!configManager.initVideoConfig(ogreRoot))
         return;
@@ -122,11 +200,15 @@ void ODApplication::startClient()
     // Needed for the TextRenderer and the Render Manager
     Ogre::OverlaySystem overlaySystem;
 
+    sf::Time start = startupTimings.getElapsedTime();
     Ogre::RenderWindow* renderWindow = ogreRoot.initialise(true, "OpenDungeons " + VERSION);
+    startupTimings.addPhase("render window", "main", start, startupTimings.getElapsedTime());
 
     //NOTE: This is currently done here as it has to be done after initialising mRoot,
     // but before running initialiseAllResourceGroups()
+    start = startupTimings.getElapsedTime();
     resMgr.setupOgreResources(ogreRoot.getRenderSystem()->getNativeShadingLanguageVersion());
+    startupTimings.addPhase("resource locations", "main", start, startupTimings.getElapsedTime());
 
     // Setup Icon (On Windows)
     // NOTE: On linux at least, the icon is usually handled through desktop files.
@@ -151,7 +233,12 @@ void ODApplication::startClient()
         return;
     }
 
+    start = startupTimings.getElapsedTime();
     Ogre::ResourceGroupManager::getSingletonPtr()->initialiseAllResourceGroups();
+    startupTimings.addPhase("resource groups", "main", start, startupTimings.getElapsedTime());
+
+    configManager.waitDefinitionsLoaded();
+    startupTimings.logReport();
 
     MusicPlayer musicPlayer(resMgr.getMusicPath(), resMgr.listAllMusicFiles());
     SoundEffectsManager soundEffectsManager;
@@ -169,6 +256,13 @@ void ODApplication::startClient()
     ODFrameListener frameListener(resMgr.getConfigPath() + "mainmenuscene.cfg",
         renderWindow, &overlaySystem, &gui);
 
+    // Spectators directly watch the game relayed by the server instead of going through the menus
+    if(!resMgr.getSpectateHost().empty() &&
+       !client.spectate(resMgr.getSpectateHost(), resMgr.getSpectatorPort(), configManager.getClientConnectionTimeout()))
+    {
+        OD_LOG_ERR("Could not spectate the game relayed by " + resMgr.getSpectateHost());
+    }
+
     ogreRoot.addFrameListener(&frameListener);
     ogreRoot.startRendering();
 
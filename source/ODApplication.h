@@ -64,6 +64,9 @@ private:
     void startClient();
     //! \brief Server mode. Creates only the needed to launch a level. Note that this is to be used without gui
     void startServer();
+    //! \brief Benchmark mode. Times the map algorithms on every official level without gui and
+    //! writes the results (see MapBenchmark)
+    void startBenchmark();
 };
 
 #endif // ODAPPLICATION_H
@@ -33,12 +33,17 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 const int32_t pointsPerWallSpot = 50;
 const int32_t handicapPerTileOffset = 20;
 
 BaseAI::BaseAI(GameMap& gameMap, Player& player):
     mGameMap(gameMap),
-    mPlayer(player)
+    mPlayer(player),
+    mRoomPlacementSeat(nullptr),
+    mRoomPlacementVersion(0)
 {
 }
 
@@ -232,40 +237,15 @@ bool BaseAI::computePointsForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
 {
     int tileX = tile->getX();
     int tileY = tile->getY();
-    bool isOk = true;
-
-    // We check if the tile is reachable. No need to compute if the tile is behind rocks
-    points = 0;
-    // We start by searching for a place fitting the min size. If we find it,
-    // we increase tile by tile until the max size. If not, no need to continue
-    for(int32_t xx = 0; xx < wantedSize; ++xx)
-    {
-        for(int32_t yy = 0; yy < wantedSize; ++yy)
-        {
-            Tile* t;
-            if(bottomLeft2TopRight)
-                t  = mGameMap.getTile(tileX + xx, tileY + yy);
-            else
-                t  = mGameMap.getTile(tileX - xx, tileY - yy);
-
-            if(t == nullptr)
-            {
-                isOk = false;
-                break;
-            }
 
-            if(!shouldGroundTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            {
-                isOk = false;
-                break;
-            }
-        }
+    refreshRoomPlacementPlanes(mPlayerSeat);
 
-        if(!isOk)
-            break;
-    }
-
-    if(!isOk)
+    points = 0;
+    // Every tile of the square should be suitable. Tiles outside the map are not counted
+    int32_t squareX = bottomLeft2TopRight ? tileX : tileX - wantedSize + 1;
+    int32_t squareY = bottomLeft2TopRight ? tileY : tileY - wantedSize + 1;
+    uint32_t nbTiles = static_cast<uint32_t>(wantedSize * wantedSize);
+    if(mRoomGroundTable.count(squareX, squareY, wantedSize, wantedSize) < nbTiles)
         return false;
 
     // If we don't want to consider walls, we stop here (for example for rooms that do not have bonus
@@ -273,57 +253,39 @@ bool BaseAI::computePointsForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
     if(!useWalls)
         return true;
 
-    // We search points for first wall. That's not exactly how the activespots will be computed but it will be enough (especially
+    // We search points for each wall. That's not exactly how the activespots will be computed but it will be enough (especially
     // when the room size is even)
-    int nbConsecutiveTiles;
-    int nbActiveWallSpots;
-    // We search points for first wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
-    {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t  = mGameMap.getTile(tileX - 1, tileY + kk);
-        else
-            t  = mGameMap.getTile(tileX + 1, tileY - kk);
-        if(t == nullptr)
-            continue;
+    int32_t dir = bottomLeft2TopRight ? 1 : -1;
+    points += computeWallActiveSpots(tileX - dir, tileY, 0, dir, wantedSize) * pointsPerWallSpot;
+    points += computeWallActiveSpots(tileX + dir * wantedSize, tileY, 0, dir, wantedSize) * pointsPerWallSpot;
+    points += computeWallActiveSpots(tileX, tileY - dir, dir, 0, wantedSize) * pointsPerWallSpot;
+    points += computeWallActiveSpots(tileX, tileY + dir * wantedSize, dir, 0, wantedSize) * pointsPerWallSpot;
 
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            ++nbConsecutiveTiles;
-        else
-            nbConsecutiveTiles = 0;
+    return true;
+}
 
-        if(nbActiveWallSpots == 0)
-        {
-            if(nbConsecutiveTiles >= 3)
-            {
-                nbConsecutiveTiles = 0;
-                ++nbActiveWallSpots;
-            }
-        }
-        else if(nbConsecutiveTiles >= 2)
-        {
-            nbConsecutiveTiles = 0;
-            ++nbActiveWallSpots;
-        }
+int32_t BaseAI::computeWallActiveSpots(int32_t startX, int32_t startY, int32_t dirX, int32_t dirY, int32_t wantedSize)
+{
+    // At least 3 walls are needed for an active spot. If there are not enough on this side,
+    // no need to check them one by one
+    int32_t endX = startX + dirX * (wantedSize - 1);
+    int32_t endY = startY + dirY * (wantedSize - 1);
+    if(mRoomWallTable.count(std::min(startX, endX), std::min(startY, endY),
+        std::abs(endX - startX) + 1, std::abs(endY - startY) + 1) < 3)
+    {
+        return 0;
     }
-    points += nbActiveWallSpots * pointsPerWallSpot;
-    // We search points for second wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
+
+    int nbConsecutiveTiles = 0;
+    int nbActiveWallSpots = 0;
     for(int32_t kk = 0; kk < wantedSize; ++kk)
     {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t = mGameMap.getTile(tileX + wantedSize, tileY + kk);
-        else
-            t = mGameMap.getTile(tileX - wantedSize, tileY - kk);
-        if(t == nullptr)
+        int32_t xx = startX + dirX * kk;
+        int32_t yy = startY + dirY * kk;
+        if(mGameMap.getTile(xx, yy) == nullptr)
             continue;
 
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
+        if(mRoomWallPlane.get(xx, yy))
             ++nbConsecutiveTiles;
         else
             nbConsecutiveTiles = 0;
@@ -342,132 +304,53 @@ bool BaseAI::computePointsForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
             ++nbActiveWallSpots;
         }
     }
-    points += nbActiveWallSpots * pointsPerWallSpot;
-    // We search points for first wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
-    {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t = mGameMap.getTile(tileX + kk, tileY - 1);
-        else
-            t = mGameMap.getTile(tileX - kk, tileY + 1);
-        if(t == nullptr)
-            continue;
 
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            ++nbConsecutiveTiles;
-        else
-            nbConsecutiveTiles = 0;
+    return nbActiveWallSpots;
+}
 
-        if(nbActiveWallSpots == 0)
-        {
-            if(nbConsecutiveTiles >= 3)
-            {
-                nbConsecutiveTiles = 0;
-                ++nbActiveWallSpots;
-            }
-        }
-        else if(nbConsecutiveTiles >= 2)
-        {
-            nbConsecutiveTiles = 0;
-            ++nbActiveWallSpots;
-        }
-    }
-    points += nbActiveWallSpots * pointsPerWallSpot;
-    // We search points for first wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
+void BaseAI::refreshRoomPlacementPlanes(Seat* playerSeat)
+{
+    if((mRoomPlacementSeat == playerSeat) &&
+       (mRoomPlacementVersion == mGameMap.getTilePlanesVersion()) &&
+       (mRoomGroundPlane.getSizeX() == mGameMap.getMapSizeX()) &&
+       (mRoomGroundPlane.getSizeY() == mGameMap.getMapSizeY()))
     {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t = mGameMap.getTile(tileX + kk, tileY + wantedSize);
-        else
-            t = mGameMap.getTile(tileX - kk, tileY - wantedSize);
-        if(t == nullptr)
-            continue;
-
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            ++nbConsecutiveTiles;
-        else
-            nbConsecutiveTiles = 0;
+        return;
+    }
 
-        if(nbActiveWallSpots == 0)
-        {
-            if(nbConsecutiveTiles >= 3)
-            {
-                nbConsecutiveTiles = 0;
-                ++nbActiveWallSpots;
-            }
-        }
-        else if(nbConsecutiveTiles >= 2)
+    mRoomPlacementSeat = playerSeat;
+    mRoomPlacementVersion = mGameMap.getTilePlanesVersion();
+    mRoomGroundPlane.resize(mGameMap.getMapSizeX(), mGameMap.getMapSizeY());
+    mRoomWallPlane.resize(mGameMap.getMapSizeX(), mGameMap.getMapSizeY());
+    for(int32_t yy = 0; yy < mGameMap.getMapSizeY(); ++yy)
+    {
+        for(int32_t xx = 0; xx < mGameMap.getMapSizeX(); ++xx)
         {
-            nbConsecutiveTiles = 0;
-            ++nbActiveWallSpots;
+            Tile* tile = mGameMap.getTile(xx, yy);
+            mRoomGroundPlane.set(xx, yy, shouldGroundTileBeConsideredForBestPlaceForRoom(tile, playerSeat));
+            mRoomWallPlane.set(xx, yy, shouldWallTileBeConsideredForBestPlaceForRoom(tile, playerSeat));
         }
     }
-    points += nbActiveWallSpots * pointsPerWallSpot;
-
-    return true;
+    mRoomGroundTable.update(mRoomGroundPlane);
+    mRoomWallTable.update(mRoomWallPlane);
 }
 
 bool BaseAI::digWayToTile(Tile* tileStart, Tile* tileEnd)
 {
-    // We find a way to tileEnd. We search in reverse order to stop when we reach the first
-    // accessible tile
-
-    // Set a diggable path up to the first gold spot for the given team color, by the first available worker
+    // We look for the way to tileEnd that needs the least digging from the tiles our workers
+    // can reach from tileStart. Gold tiles are cheap to dig so that we get some on the way
     Seat* seat = mPlayer.getSeat();
     Creature* worker = mGameMap.getWorkerForPathFinding(seat);
     if (worker == nullptr)
         return false;
 
-    std::list<Tile*> pathToDig = mGameMap.path(tileEnd, tileStart, worker, seat, true);
-    if (pathToDig.empty())
+    std::vector<Tile*> tilesToDig;
+    if(!mGameMap.findTilesToDig(*worker, seat, tileStart, tileEnd, true, tilesToDig))
         return false;
 
-    // We search for the first reachable tile in the list
-    bool isPathFound = false;
-    for(std::list<Tile*>::iterator it = pathToDig.begin(); it != pathToDig.end();)
-    {
-        Tile* tile = *it;
-        if(!isPathFound &&
-           (tile->getFullness() == 0.0) &&
-           (mGameMap.pathExists(worker, tileStart, tile)))
-        {
-            isPathFound = true;
-        }
-
-        if(isPathFound)
-        {
-            it = pathToDig.erase(it);
-            continue;
-        }
-
-        // If the tile should be dug, we check if one of its neighboors can be reached.
-        // If yes, we will stop after digging it to avoid digging through a wall as much as
-        // possible
-        for(Tile* t : tile->getAllNeighbors())
-        {
-            if(!isPathFound &&
-               (t->getFullness() == 0.0) &&
-               (mGameMap.pathExists(worker, tileStart, t)))
-            {
-                // we let the iterator increment because we want to dig the currently
-                // tested tile
-                isPathFound = true;
-                break;
-            }
-        }
-
-        ++it;
-    }
-
-    for(Tile* tile : pathToDig)
+    for(Tile* tile : tilesToDig)
     {
-        if (tile && tile->isDiggable(seat))
+        if (tile->isDiggable(seat))
             tile->setMarkedForDigging(true, &mPlayer);
     }
 
@@ -18,6 +18,9 @@
 #ifndef BASEAI_H
 #define BASEAI_H
 
+#include "gamemap/TileAreaTable.h"
+#include "gamemap/TileBitPlane.h"
+
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -66,6 +69,24 @@ protected:
 private:
     bool shouldGroundTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* playerSeat);
     bool shouldWallTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* playerSeat);
+
+    //! \brief Refreshes the room placement planes and their summed-area tables if the map tiles changed
+    //! since they were computed (or if they were computed for another seat)
+    void refreshRoomPlacementPlanes(Seat* playerSeat);
+
+    //! \brief Returns the number of wall active spots along the room side starting at (startX, startY)
+    //! and going in the direction (dirX, dirY) for wantedSize tiles
+    int32_t computeWallActiveSpots(int32_t startX, int32_t startY, int32_t dirX, int32_t dirY, int32_t wantedSize);
+
+    //! \brief Tiles where shouldGroundTileBeConsideredForBestPlaceForRoom (respectively
+    //! shouldWallTileBeConsideredForBestPlaceForRoom) is true for mRoomPlacementSeat.
+    //! Thanks to the summed-area tables, checking if a room fits somewhere is done in constant time
+    TileBitPlane mRoomGroundPlane;
+    TileBitPlane mRoomWallPlane;
+    TileAreaTable mRoomGroundTable;
+    TileAreaTable mRoomWallTable;
+    Seat* mRoomPlacementSeat;
+    uint32_t mRoomPlacementVersion;
 };
 
 #endif // BASEAI_H
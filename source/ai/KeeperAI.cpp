@@ -383,94 +383,24 @@ bool KeeperAI::lookForGold()
         return false;
 
     Tile* central = getDungeonTemple()->getCentralTile();
-    int widerSide = mGameMap.getMapSizeX() > mGameMap.getMapSizeY() ?
-        mGameMap.getMapSizeX() : mGameMap.getMapSizeY();
 
-    // We search for the closest gold tile
+    // We search for the closest gold tiles. If there are several ones at the same
+    // distance, we randomly pick one to try to not be too predictable. Many tiles can
+    // be at the same squared distance (12 for a distance of 5 for example) so we get
+    // the closest one and then every tile at its distance
+    const TileBitPlane& goldPlane = mGameMap.getTileTypePlane(TileType::gold);
+    const TileBitPlane* fullPlane = &mGameMap.getFullTilePlane();
+    std::vector<Tile*> goldTiles = mGameMap.findNearestTiles(central->getX(), central->getY(),
+        goldPlane, fullPlane, 1, -1);
     Tile* firstGoldTile = nullptr;
-    for(int32_t distance = 1; distance < widerSide; ++distance)
+    if(!goldTiles.empty())
     {
-        for(int k = 0; k <= distance; ++k)
-        {
-            Tile* t;
-            // North-East
-            t = mGameMap.getTile(central->getX() + k, central->getY() + distance);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                // If we already have a tile at same distance, we randomly change to
-                // try to not be too predictable
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // North-West
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - k, central->getY() + distance);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // South-East
-            t = mGameMap.getTile(central->getX() + k, central->getY() - distance);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // South-West
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - k, central->getY() - distance);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // East-North
-            t = mGameMap.getTile(central->getX() + distance, central->getY() + k);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // East-South
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() + distance, central->getY() - k);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // West-North
-            t = mGameMap.getTile(central->getX() - distance, central->getY() + k);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // West-South
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - distance, central->getY() - k);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-
-            if(firstGoldTile != nullptr)
-                break;
-        }
-
-        // If we found a tile, no need to continue
-        if(firstGoldTile != nullptr)
-            break;
+        int diffX = goldTiles.front()->getX() - central->getX();
+        int diffY = goldTiles.front()->getY() - central->getY();
+        int distBest = diffX * diffX + diffY * diffY;
+        goldTiles = mGameMap.findNearestTiles(central->getX(), central->getY(),
+            goldPlane, fullPlane, 0, distBest);
+        firstGoldTile = goldTiles[Random::Uint(0, static_cast<unsigned int>(goldTiles.size()) - 1)];
     }
 
     // No more gold
@@ -20,9 +20,27 @@
 #include "entities/Creature.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/ObjectPool.h"
 
 #include <istream>
 
+const std::size_t CreatureAction::MAX_ACTION_SIZE = 128;
+
+namespace
+{
+ObjectPool sCreatureActionPool("CreatureAction", CreatureAction::MAX_ACTION_SIZE);
+} // namespace <none>
+
+void* CreatureAction::operator new(std::size_t size)
+{
+    return sCreatureActionPool.allocate(size);
+}
+
+void CreatureAction::operator delete(void* ptr, std::size_t size)
+{
+    sCreatureActionPool.release(ptr, size);
+}
+
 std::string CreatureAction::toString(CreatureActionType actionType)
 {
     switch (actionType)
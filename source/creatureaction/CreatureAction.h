@@ -18,8 +18,8 @@
 #ifndef CREATUREACTION_H
 #define CREATUREACTION_H
 
+#include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <istream>
 
 class Creature;
@@ -77,11 +77,19 @@ public:
     inline int32_t getNbTurnsActive() const
     { return mNbTurnsActive; }
 
-    //! Returns a pointer to the given action from CreatureAction class. Note that
-    //! we don't want to do stuff in the child classes because many actions will
-    //! pop themselves which might result in errors. Instead, we expect every action
-    //! to call the expected action from CreatureAction with the good parameters.
-    virtual std::function<bool()> action() = 0;
+    //! Executes the action for the current turn. Returns true if the creature should
+    //! process its next action within the same turn. Note that many actions will pop
+    //! themselves, which deletes them. That's why every action is expected to forward
+    //! to a static handler, with its members passed as parameters. The handler must not
+    //! use members passed by reference once it has popped the action.
+    virtual bool execute() = 0;
+
+    //! \brief Actions are pushed and popped very often. They are allocated from a pool
+    //! (see ObjectPool). Actions bigger than MAX_ACTION_SIZE are allocated from the heap
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
+    static const std::size_t MAX_ACTION_SIZE;
 
     static std::string toString(CreatureActionType actionType);
 
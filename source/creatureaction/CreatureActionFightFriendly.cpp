@@ -45,10 +45,9 @@ CreatureActionFightFriendly::~CreatureActionFightFriendly()
         mEntityAttack->removeGameEntityListener(this);
 }
 
-std::function<bool()> CreatureActionFightFriendly::action()
+bool CreatureActionFightFriendly::execute()
 {
-    return std::bind(&CreatureActionFightFriendly::handleFight,
-        std::ref(mCreature), mEntityAttack, mKoOpponent, mTilesFilter, mNotifyPlayerIfHit);
+    return handleFight(mCreature, mEntityAttack, mKoOpponent, mTilesFilter, mNotifyPlayerIfHit);
 }
 
 bool CreatureActionFightFriendly::handleFight(Creature& creature, GameEntity* entityAttack, bool koOpponent, const std::vector<Tile*>& tilesFilter, bool notifyPlayerIfHit)
@@ -29,12 +29,9 @@
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
 
-#include <functional>
-
-std::function<bool()> CreatureActionFindHome::action()
+bool CreatureActionFindHome::execute()
 {
-    return std::bind(&CreatureActionFindHome::handleFindHome,
-        std::ref(mCreature), mForced);
+    return handleFindHome(mCreature, mForced);
 }
 
 bool CreatureActionFindHome::handleFindHome(Creature& creature, bool forced)
@@ -29,10 +29,9 @@
 
 static const int NB_TURN_FLEE_MAX = 5;
 
-std::function<bool()> CreatureActionFlee::action()
+bool CreatureActionFlee::execute()
 {
-    return std::bind(&CreatureActionFlee::handleFlee,
-        std::ref(mCreature), getNbTurns());
+    return handleFlee(mCreature, getNbTurns());
 }
 
 bool CreatureActionFlee::handleFlee(Creature& creature, int32_t nbTurns)
@@ -61,7 +60,7 @@ bool CreatureActionFlee::handleFlee(Creature& creature, int32_t nbTurns)
         // We can go to one dungeon temple
         Room* room = tempRooms[Random::Int(0, tempRooms.size() - 1)];
         Tile* tile = room->getCoveredTile(0);
-        std::list<Tile*> result = creature.getGameMap()->path(&creature, tile);
+        std::list<Tile*> result = creature.getGameMap()->pathToSharedTarget(&creature, tile);
         // If we are not too near from the dungeon temple, we go there
         if(result.size() > 5)
         {
@@ -31,10 +31,9 @@
 #include "utils/MakeUnique.h"
 #include "utils/Random.h"
 
-std::function<bool()> CreatureActionGetFee::action()
+bool CreatureActionGetFee::execute()
 {
-    return std::bind(&CreatureActionGetFee::handleGetFee,
-        std::ref(mCreature));
+    return handleGetFee(mCreature);
 }
 
 bool CreatureActionGetFee::handleGetFee(Creature& creature)
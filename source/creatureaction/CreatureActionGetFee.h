@@ -33,7 +33,7 @@ public:
     CreatureActionType getType() const override
     { return CreatureActionType::getFee; }
 
-    std::function<bool()> action() override;
+    bool execute() override;
 
     static bool handleGetFee(Creature& creature);
 };
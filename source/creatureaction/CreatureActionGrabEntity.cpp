@@ -43,10 +43,9 @@ CreatureActionGrabEntity::~CreatureActionGrabEntity()
     }
 }
 
-std::function<bool()> CreatureActionGrabEntity::action()
+bool CreatureActionGrabEntity::execute()
 {
-    return std::bind(&CreatureActionGrabEntity::handleGrabEntity,
-        std::ref(mCreature), std::ref(mEntityToCarry));
+    return handleGrabEntity(mCreature, mEntityToCarry);
 }
 
 bool CreatureActionGrabEntity::handleGrabEntity(Creature& creature, GameEntity* entityToCarry)
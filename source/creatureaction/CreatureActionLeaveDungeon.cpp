@@ -30,10 +30,9 @@
 #include "utils/LogManager.h"
 #include "utils/Random.h"
 
-std::function<bool()> CreatureActionLeaveDungeon::action()
+bool CreatureActionLeaveDungeon::execute()
 {
-    return std::bind(&CreatureActionLeaveDungeon::handleLeaveDungeon,
-        std::ref(mCreature));
+    return handleLeaveDungeon(mCreature);
 }
 
 bool CreatureActionLeaveDungeon::handleLeaveDungeon(Creature& creature)
@@ -23,11 +23,11 @@
 #include "entities/Tile.h"
 #include "game/Player.h"
 #include "game/Seat.h"
+#include "game/WorkerJobBoard.h"
 #include "gamemap/GameMap.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
-#include "utils/Random.h"
 
 CreatureActionSearchEntityToCarry::CreatureActionSearchEntityToCarry(Creature& creature, bool forced) :
     CreatureAction(creature),
@@ -41,10 +41,9 @@ CreatureActionSearchEntityToCarry::~CreatureActionSearchEntityToCarry()
     mCreature.getSeat()->getPlayer()->notifyWorkerStopsAction(mCreature, getType());
 }
 
-std::function<bool()> CreatureActionSearchEntityToCarry::action()
+bool CreatureActionSearchEntityToCarry::execute()
 {
-    return std::bind(&CreatureActionSearchEntityToCarry::handleSearchEntityToCarry,
-        std::ref(mCreature), mForced);
+    return handleSearchEntityToCarry(mCreature, mForced);
 }
 
 bool CreatureActionSearchEntityToCarry::handleSearchEntityToCarry(Creature& creature, bool forced)
@@ -57,100 +56,52 @@ bool CreatureActionSearchEntityToCarry::handleSearchEntityToCarry(Creature& crea
         return true;
     }
 
+    if(!forced)
+    {
+        // The job board gives each carrying worker its own entity
+        GameEntity* entity = creature.getSeat()->getWorkerJobBoard().findEntityToCarry(creature);
+        if(entity == nullptr)
+        {
+            // No entity to carry. We can do something else
+            creature.popAction();
+            return true;
+        }
+
+        creature.pushAction(Utils::make_unique<CreatureActionGrabEntity>(creature, *entity));
+        return true;
+    }
+
+    // If we are forced to carry something, we consider only entities on our tile
     std::vector<Building*> buildings = creature.getGameMap()->getReachableBuildingsPerSeat(creature.getSeat(), myTile, &creature);
-    std::vector<GameEntity*> carryableEntities = creature.getGameMap()->getCarryableEntities(&creature, creature.getTilesWithinSightRadius());
-    std::vector<Tile*> carryableEntityInMyTileClients;
-    std::vector<GameEntity*> availableEntities;
+    std::vector<GameEntity*> carryableEntities;
+    myTile->fillWithCarryableEntities(&creature, carryableEntities);
+    GameEntity* entityToCarry = nullptr;
     EntityCarryType highestPriority = EntityCarryType::notCarryable;
-    // If a carryable entity of highest priority is in my tile, I proceed it
-    GameEntity* carryableEntityInMyTile = nullptr;
     for(GameEntity* entity : carryableEntities)
     {
-        // We check that the carryable entity is reachable
-        Tile* carryableEntTile = entity->getPositionTile();
-        if(!creature.getGameMap()->pathExists(&creature, myTile, carryableEntTile))
-            continue;
-
-        // If we are forced to carry something, we consider only entities on our tile
-        if(forced && (myTile != carryableEntTile))
+        EntityCarryType carryType = entity->getEntityCarryType(&creature);
+        if(carryType <= highestPriority)
             continue;
 
-        // We check if the current entity is highest or equal to the older one (if any)
-        if(entity->getEntityCarryType(&creature) > highestPriority)
+        // We check if a buildings wants this entity
+        for(Building* building : buildings)
         {
-            // We check if a buildings wants this entity
-            std::vector<Tile*> tilesDest;
-            for(Building* building : buildings)
-            {
-                if(building->hasCarryEntitySpot(entity))
-                {
-                    Tile* tile = building->getCoveredTile(0);
-                    tilesDest.push_back(tile);
-                }
-            }
+            if(!building->hasCarryEntitySpot(entity))
+                continue;
 
-            if(!tilesDest.empty())
-            {
-                // We found a reachable building for a higher priority entity. We use this from now on
-                carryableEntityInMyTile = nullptr;
-                availableEntities.clear();
-                availableEntities.push_back(entity);
-                highestPriority = entity->getEntityCarryType(&creature);
-                if(myTile == carryableEntTile)
-                {
-                    carryableEntityInMyTile = entity;
-                    carryableEntityInMyTileClients = tilesDest;
-                }
-            }
-        }
-        else if(entity->getEntityCarryType(&creature) == highestPriority)
-        {
-            // We check if a buildings wants this entity
-            std::vector<Tile*> tilesDest;
-            for(Building* building : buildings)
-            {
-                if(building->hasCarryEntitySpot(entity))
-                {
-                    Tile* tile = building->getCoveredTile(0);
-                    tilesDest.push_back(tile);
-                }
-            }
-
-            if(!tilesDest.empty())
-            {
-                // We found a reachable building for a higher priority entity. We use this from now on
-                availableEntities.push_back(entity);
-                if((myTile == carryableEntTile) &&
-                   (carryableEntityInMyTile == nullptr))
-                {
-                    carryableEntityInMyTile = entity;
-                    carryableEntityInMyTileClients = tilesDest;
-                }
-            }
-        }
-        else
-        {
-            // Entity with lower priority. We don't proceed
+            entityToCarry = entity;
+            highestPriority = carryType;
+            break;
         }
     }
 
-    if(availableEntities.empty())
+    if(entityToCarry == nullptr)
     {
         // No entity to carry. We can do something else
         creature.popAction();
         return true;
     }
 
-    // If a carryable entity is in my tile, I take it
-    if(carryableEntityInMyTile != nullptr)
-    {
-        creature.pushAction(Utils::make_unique<CreatureActionGrabEntity>(creature, *carryableEntityInMyTile));
-        return true;
-    }
-
-    // We randomly choose one of the visible carryable entities
-    uint32_t index = Random::Uint(0,availableEntities.size()-1);
-    GameEntity* entity = availableEntities[index];
-    creature.pushAction(Utils::make_unique<CreatureActionGrabEntity>(creature, *entity));
+    creature.pushAction(Utils::make_unique<CreatureActionGrabEntity>(creature, *entityToCarry));
     return true;
 }
@@ -34,10 +34,9 @@
 #include "utils/MakeUnique.h"
 #include "utils/Random.h"
 
-std::function<bool()> CreatureActionSearchFood::action()
+bool CreatureActionSearchFood::execute()
 {
-    return std::bind(&CreatureActionSearchFood::handleSearchFood,
-        std::ref(mCreature), mForced);
+    return handleSearchFood(mCreature, mForced);
 }
 
 bool CreatureActionSearchFood::handleSearchFood(Creature& creature, bool forced)
@@ -22,8 +22,8 @@
 #include "entities/Tile.h"
 #include "game/Player.h"
 #include "game/Seat.h"
+#include "game/WorkerJobBoard.h"
 #include "gamemap/GameMap.h"
-#include "gamemap/Pathfinding.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
@@ -40,10 +40,9 @@ CreatureActionSearchGroundTileToClaim::~CreatureActionSearchGroundTileToClaim()
     mCreature.getSeat()->getPlayer()->notifyWorkerStopsAction(mCreature, getType());
 }
 
-std::function<bool()> CreatureActionSearchGroundTileToClaim::action()
+bool CreatureActionSearchGroundTileToClaim::execute()
 {
-    return std::bind(&CreatureActionSearchGroundTileToClaim::handleSearchGroundTileToClaim,
-        std::ref(mCreature), getNbTurns(), mForced);
+    return handleSearchGroundTileToClaim(mCreature, getNbTurns(), mForced);
 }
 
 bool CreatureActionSearchGroundTileToClaim::handleSearchGroundTileToClaim(Creature& creature, int32_t nbTurns, bool forced)
@@ -96,7 +95,8 @@ bool CreatureActionSearchGroundTileToClaim::handleSearchGroundTileToClaim(Creatu
     // The tile we are standing on is already claimed or is not currently
     // claimable, find candidates for claiming.
     // Start by checking the neighbor tiles of the one we are already in
-    std::vector<Tile*> neighbors = myTile->getAllNeighbors();
+    TileNeighbors myNeighbors = myTile->getAllNeighbors();
+    std::vector<Tile*> neighbors(myNeighbors.begin(), myNeighbors.end());
     std::random_shuffle(neighbors.begin(), neighbors.end());
     for(Tile* tile : neighbors)
     {
@@ -125,48 +125,12 @@ bool CreatureActionSearchGroundTileToClaim::handleSearchGroundTileToClaim(Creatu
         }
     }
 
-    // If we still haven't found a tile to claim, we try to take the closest one
-    float distBest = -1;
-    Tile* tileToClaim = nullptr;
-    for (Tile* tile : creature.getTilesWithinSightRadius())
+    // If we still haven't found a tile to claim, we ask the job board for one
+    Tile* jobTile = nullptr;
+    Tile* workTile = nullptr;
+    if(creature.getSeat()->getWorkerJobBoard().findJob(creature, WorkerJobType::claimGround, jobTile, workTile))
     {
-        // if this tile is not fully claimed yet or the tile is of another player's color
-        if(tile == nullptr)
-            continue;
-        if(tile->isFullTile())
-            continue;
-        if(!tile->isGroundClaimable(creature.getSeat()))
-            continue;
-        if(!creature.getGameMap()->pathExists(&creature, myTile, tile))
-            continue;
-        if(!tile->canWorkerClaim(creature))
-            continue;
-
-        float dist = Pathfinding::squaredDistanceTile(*myTile, *tile);
-        if((distBest != -1) && (distBest <= dist))
-            continue;
-
-        // Check to see if one of the tile's neighbors is claimed for our color
-        for (Tile* neigh : tile->getAllNeighbors())
-        {
-            if(neigh->isFullTile())
-                continue;
-            if(!neigh->isClaimedForSeat(creature.getSeat()))
-                continue;
-            if(neigh->getClaimedPercentage() < 1.0)
-                continue;
-
-            distBest = dist;
-            tileToClaim = tile;
-            break;
-        }
-    }
-
-    // Check if we found a tile
-    if(tileToClaim != nullptr)
-    {
-        // We lock the tile
-        creature.pushAction(Utils::make_unique<CreatureActionClaimGroundTile>(creature, *tileToClaim));
+        creature.pushAction(Utils::make_unique<CreatureActionClaimGroundTile>(creature, *jobTile));
         return true;
     }
 
@@ -29,7 +29,7 @@ public:
     CreatureActionType getType() const override
     { return CreatureActionType::searchGroundTileToClaim; }
 
-    std::function<bool()> action() override;
+    bool execute() override;
 
     static bool handleSearchGroundTileToClaim(Creature& creature, int32_t nbTurns, bool forced);
 
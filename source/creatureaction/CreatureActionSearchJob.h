@@ -36,7 +36,7 @@ public:
     CreatureActionType getType() const override
     { return CreatureActionType::searchJob; }
 
-    std::function<bool()> action() override;
+    bool execute() override;
 
     static bool handleSearchJob(Creature& creature, bool forced);
 
@@ -20,12 +20,13 @@
 #include "creatureaction/CreatureActionDigTile.h"
 #include "creatureaction/CreatureActionGrabEntity.h"
 #include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
 #include "entities/Tile.h"
 #include "entities/TreasuryObject.h"
 #include "game/Player.h"
 #include "game/Seat.h"
+#include "game/WorkerJobBoard.h"
 #include "gamemap/GameMap.h"
-#include "gamemap/Pathfinding.h"
 #include "rooms/Room.h"
 #include "utils/Helper.h"
 #include "utils/MakeUnique.h"
@@ -43,10 +44,9 @@ CreatureActionSearchTileToDig::~CreatureActionSearchTileToDig()
     mCreature.getSeat()->getPlayer()->notifyWorkerStopsAction(mCreature, getType());
 }
 
-std::function<bool()> CreatureActionSearchTileToDig::action()
+bool CreatureActionSearchTileToDig::execute()
 {
-    return std::bind(&CreatureActionSearchTileToDig::handleSearchTileToDig,
-        std::ref(mCreature), getNbTurns(), mForced);
+    return handleSearchTileToDig(mCreature, getNbTurns(), mForced);
 }
 
 bool CreatureActionSearchTileToDig::handleSearchTileToDig(Creature& creature, int32_t nbTurns, bool forced)
@@ -108,42 +108,13 @@ bool CreatureActionSearchTileToDig::handleSearchTileToDig(Creature& creature, in
         return true;
     }
 
-    // Find the closest tile to dig
-    float distBest = -1;
-    Tile* tileToDig = nullptr;
-    Tile* tilePos = nullptr;
-    for (Tile* tile : creature.getTilesWithinSightRadius())
+    // Ask the job board for a tile to dig. The board gives each digging worker its own tile
+    Tile* jobTile = nullptr;
+    Tile* workTile = nullptr;
+    if((tempPlayer != nullptr) &&
+       creature.getSeat()->getWorkerJobBoard().findJob(creature, WorkerJobType::dig, jobTile, workTile))
     {
-        // Check to see whether the tile is marked for digging
-        if(!tile->getMarkedForDigging(tempPlayer))
-            continue;
-
-        // and there is still room to work on it
-        std::vector<Tile*> tiles;
-        tile->canWorkerDig(creature, tiles);
-        if(tiles.empty())
-            continue;
-
-        // We search for the closest neighbor tile
-        for (Tile* neighborTile : tiles)
-        {
-            if (!creature.getGameMap()->pathExists(&creature, myTile, neighborTile))
-                continue;
-
-            float dist = Pathfinding::squaredDistanceTile(*myTile, *neighborTile);
-            if((distBest != -1) && (distBest <= dist))
-                continue;
-
-            distBest = dist;
-            tileToDig = tile;
-            tilePos = neighborTile;
-        }
-    }
-
-    if((tileToDig != nullptr) && (tilePos != nullptr))
-    {
-        // We also push the dig action to lock the tile to make sure not every worker will try to go to the same tile
-        creature.pushAction(Utils::make_unique<CreatureActionDigTile>(creature, *tileToDig, *tilePos));
+        creature.pushAction(Utils::make_unique<CreatureActionDigTile>(creature, *jobTile, *workTile));
         return true;
     }
 
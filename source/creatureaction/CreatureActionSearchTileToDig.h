@@ -29,7 +29,7 @@ public:
     CreatureActionType getType() const override
     { return CreatureActionType::searchTileToDig; }
 
-    std::function<bool()> action() override;
+    bool execute() override;
 
     static bool handleSearchTileToDig(Creature& creature, int32_t nbTurns, bool forced);
 
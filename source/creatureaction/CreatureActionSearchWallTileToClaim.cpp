@@ -22,8 +22,8 @@
 #include "entities/Tile.h"
 #include "game/Player.h"
 #include "game/Seat.h"
+#include "game/WorkerJobBoard.h"
 #include "gamemap/GameMap.h"
-#include "gamemap/Pathfinding.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
@@ -39,10 +39,9 @@ CreatureActionSearchWallTileToClaim::~CreatureActionSearchWallTileToClaim()
 {
     mCreature.getSeat()->getPlayer()->notifyWorkerStopsAction(mCreature, getType());
 }
-std::function<bool()> CreatureActionSearchWallTileToClaim::action()
+bool CreatureActionSearchWallTileToClaim::execute()
 {
-    return std::bind(&CreatureActionSearchWallTileToClaim::handleSearchWallTileToClaim,
-        std::ref(mCreature), getNbTurns(), mForced);
+    return handleSearchWallTileToClaim(mCreature, getNbTurns(), mForced);
 }
 
 bool CreatureActionSearchWallTileToClaim::handleSearchWallTileToClaim(Creature& creature, int32_t nbTurns, bool forced)
@@ -84,38 +83,12 @@ bool CreatureActionSearchWallTileToClaim::handleSearchWallTileToClaim(Creature&
         return true;
     }
 
-    // Find paths to all of the neighbor tiles for all of the visible wall tiles.
-    float distBest = -1;
-    Tile* tileToClaim = nullptr;
-    for(Tile* tile : creature.getTilesWithinSightRadius())
+    // Ask the job board for a wall to claim
+    Tile* jobTile = nullptr;
+    Tile* workTile = nullptr;
+    if(creature.getSeat()->getWorkerJobBoard().findJob(creature, WorkerJobType::claimWall, jobTile, workTile))
     {
-        // Check to see whether the tile is a claimable wall
-        if(tile->getMarkedForDigging(tempPlayer))
-            continue;
-        if(!tile->isWallClaimable(creature.getSeat()))
-            continue;
-        if (!tile->canWorkerClaim(creature))
-            continue;
-
-        // and can be reached by the creature
-        for(Tile* neigh : tile->getAllNeighbors())
-        {
-            if(!creature.getGameMap()->pathExists(&creature, myTile, neigh))
-                continue;
-
-            float dist = Pathfinding::squaredDistanceTile(*myTile, *neigh);
-            if((distBest != -1) && (distBest <= dist))
-                continue;
-
-            distBest = dist;
-            tileToClaim = tile;
-        }
-    }
-
-    if(tileToClaim != nullptr)
-    {
-        // We also push the dig action to lock the tile to make sure not every worker will try to go to the same tile
-        creature.pushAction(Utils::make_unique<CreatureActionClaimWallTile>(creature, *tileToClaim));
+        creature.pushAction(Utils::make_unique<CreatureActionClaimWallTile>(creature, *jobTile));
         return true;
     }
 
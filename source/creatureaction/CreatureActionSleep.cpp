@@ -27,10 +27,9 @@
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
 
-std::function<bool()> CreatureActionSleep::action()
+bool CreatureActionSleep::execute()
 {
-    return std::bind(&CreatureActionSleep::handleSleep,
-        std::ref(mCreature), getNbTurnsActive());
+    return handleSleep(mCreature, getNbTurnsActive());
 }
 
 bool CreatureActionSleep::handleSleep(Creature& creature, int32_t nbTurnsActive)
@@ -35,7 +35,7 @@ public:
     CreatureActionType getType() const override
     { return CreatureActionType::stealFreeGold; }
 
-    std::function<bool()> action() override;
+    bool execute() override;
 
     static bool handleStealFreeGold(Creature& creature);
 };
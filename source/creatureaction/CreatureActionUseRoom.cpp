@@ -56,10 +56,9 @@ CreatureActionUseRoom::~CreatureActionUseRoom()
     }
 }
 
-std::function<bool()> CreatureActionUseRoom::action()
+bool CreatureActionUseRoom::execute()
 {
-    return std::bind(&CreatureActionUseRoom::handleJob,
-        std::ref(mCreature), mRoom, mForced);
+    return handleJob(mCreature, mRoom, mForced);
 }
 
 bool CreatureActionUseRoom::handleJob(Creature& creature, Room* room, bool forced)
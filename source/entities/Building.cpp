@@ -23,6 +23,7 @@
 #include "game/Player.h"
 #include "game/Seat.h"
 #include "gamemap/GameMap.h"
+#include "goals/Goal.h"
 #include "network/ODServer.h"
 #include "render/RenderManager.h"
 #include "utils/Helper.h"
@@ -295,7 +296,10 @@ double Building::takeDamage(GameEntity* attacker, double absoluteDamage, double
     }
 
     if(!isAlive)
+    {
         fireEntityDead();
+        getGameMap()->notifyGoalEvent(Goal::EventRooms);
+    }
 
     Player* player = getSeat()->getPlayer();
     if (player == nullptr)
@@ -25,6 +25,7 @@
 #include "gamemap/GameMap.h"
 #include "rooms/Room.h"
 #include "rooms/RoomType.h"
+#include "utils/ObjectPool.h"
 #include "utils/Random.h"
 #include "utils/LogManager.h"
 
@@ -33,6 +34,21 @@
 const int32_t NB_TURNS_OUTSIDE_HATCHERY_BEFORE_DIE = 30;
 const int32_t NB_TURNS_DIE_BEFORE_REMOVE = 5;
 
+namespace
+{
+ObjectPool sChickenEntityPool("ChickenEntity", sizeof(ChickenEntity));
+} // namespace <none>
+
+void* ChickenEntity::operator new(std::size_t size)
+{
+    return sChickenEntityPool.allocate(size);
+}
+
+void ChickenEntity::operator delete(void* ptr, std::size_t size)
+{
+    sChickenEntityPool.release(ptr, size);
+}
+
 ChickenEntity::ChickenEntity(GameMap* gameMap, const std::string& hatcheryName) :
     RenderedMovableEntity(gameMap, hatcheryName, "Chicken", 0.0f, false),
     mChickenState(ChickenState::free),
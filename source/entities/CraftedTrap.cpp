@@ -27,10 +27,26 @@
 #include "traps/TrapType.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/ObjectPool.h"
 #include "utils/Random.h"
 
 #include <iostream>
 
+namespace
+{
+ObjectPool sCraftedTrapPool("CraftedTrap", sizeof(CraftedTrap));
+} // namespace <none>
+
+void* CraftedTrap::operator new(std::size_t size)
+{
+    return sCraftedTrapPool.allocate(size);
+}
+
+void CraftedTrap::operator delete(void* ptr, std::size_t size)
+{
+    sCraftedTrapPool.release(ptr, size);
+}
+
 CraftedTrap::CraftedTrap(GameMap* gameMap, const std::string& workshopName, TrapType trapType) :
     RenderedMovableEntity(gameMap, workshopName, TrapManager::getMeshFromTrapType(trapType), 0.0f, false),
     mTrapType(trapType)
@@ -20,6 +20,7 @@
 
 #include "entities/RenderedMovableEntity.h"
 
+#include <cstddef>
 #include <string>
 #include <iosfwd>
 
@@ -37,6 +38,10 @@ public:
     CraftedTrap(GameMap* gameMap, const std::string& workshopName, TrapType trapType);
     CraftedTrap(GameMap* gameMap);
 
+    //! \brief Crafted traps are allocated from a pool (see ObjectPool)
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     virtual GameEntityType getObjectType() const override;
 
     TrapType getTrapType() const
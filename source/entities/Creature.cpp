@@ -45,6 +45,7 @@
 #include "creatureskill/CreatureSkill.h"
 #include "entities/ChickenEntity.h"
 #include "entities/CreatureDefinition.h"
+#include "entities/CreatureStats.h"
 #include "entities/GameEntityType.h"
 #include "entities/Tile.h"
 #include "entities/TreasuryObject.h"
@@ -56,6 +57,7 @@
 #include "gamemap/GameMap.h"
 #include "gamemap/Pathfinding.h"
 #include "giftboxes/GiftBoxSkill.h"
+#include "goals/Goal.h"
 #include "network/ODClient.h"
 #include "network/ODServer.h"
 #include "network/ServerNotification.h"
@@ -71,6 +73,7 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
+#include "utils/ObjectPool.h"
 #include "utils/Random.h"
 
 #include <CEGUI/Event.h>
@@ -143,6 +146,21 @@ CreatureParticuleEffect::~CreatureParticuleEffect()
     mEffect = nullptr;
 }
 
+namespace
+{
+ObjectPool sCreaturePool("Creature", sizeof(Creature));
+} // namespace <none>
+
+void* Creature::operator new(std::size_t size)
+{
+    return sCreaturePool.allocate(size);
+}
+
+void Creature::operator delete(void* ptr, std::size_t size)
+{
+    sCreaturePool.release(ptr, size);
+}
+
 Creature::Creature(GameMap* gameMap, const CreatureDefinition* definition, Seat* seat, Ogre::Vector3 position) :
     MovableGameEntity        (gameMap),
     mPhysicalDefense         (3.0),
@@ -188,7 +206,9 @@ Creature::Creature(GameMap* gameMap, const CreatureDefinition* definition, Seat*
     mSeatPrison              (nullptr),
     mNbTurnsTorture          (0),
     mNbTurnsPrison           (0),
-    mActiveSlapsCount        (0)
+    mActiveSlapsCount        (0),
+    mIsInGameMap             (false),
+    mLedgerSeat              (nullptr)
 
 {
     //TODO: This should be set in initialiser list in parent classes
@@ -266,7 +286,9 @@ Creature::Creature(GameMap* gameMap) :
     mSeatPrison              (nullptr),
     mNbTurnsTorture          (0),
     mNbTurnsPrison           (0),
-    mActiveSlapsCount        (0)
+    mActiveSlapsCount        (0),
+    mIsInGameMap             (false),
+    mLedgerSeat              (nullptr)
 {
 }
 
@@ -331,6 +353,8 @@ GameEntityType Creature::getObjectType() const
 void Creature::addToGameMap()
 {
     getGameMap()->addCreature(this);
+    mIsInGameMap = true;
+    refreshSeatLedger();
     getGameMap()->addAnimatedObject(this);
     getGameMap()->addClientUpkeepEntity(this);
 
@@ -345,6 +369,8 @@ void Creature::removeFromGameMap()
     fireEntityRemoveFromGameMap();
     removeEntityFromPositionTile();
     getGameMap()->removeCreature(this);
+    mIsInGameMap = false;
+    refreshSeatLedger();
     getGameMap()->removeAnimatedObject(this);
     getGameMap()->removeClientUpkeepEntity(this);
 
@@ -654,6 +680,7 @@ void Creature::setHP(double nHP)
         mHp = nHP;
 
     computeCreatureOverlayHealthValue();
+    refreshSeatLedger();
 }
 
 void Creature::heal(double hp)
@@ -661,6 +688,7 @@ void Creature::heal(double hp)
     mHp = std::min(mHp + hp, mMaxHP);
 
     computeCreatureOverlayHealthValue();
+    refreshSeatLedger();
 }
 
 bool Creature::isAlive() const
@@ -845,6 +873,7 @@ void Creature::doUpkeep()
         mHp = 0;
         computeCreatureOverlayHealthValue();
         computeCreatureOverlayMoodValue();
+        refreshSeatLedger();
     }
 
     // Handle creature death
@@ -903,6 +932,8 @@ void Creature::doUpkeep()
     if (mHp > getMaxHp())
         mHp = getMaxHp();
 
+    refreshSeatLedger();
+
     computeCreatureOverlayHealthValue();
 
     // Rogue creatures are not affected by wakefulness/hunger
@@ -1004,10 +1035,7 @@ void Creature::doUpkeep()
         if (mActions.empty())
             loopBack = handleIdleAction();
         else
-        {
-            std::function<bool()> func = mActions.back().get()->action();
-            loopBack = func();
-        }
+            loopBack = mActions.back()->execute();
     } while (loopBack && loops < 20);
 
     if(!mActions.empty())
@@ -1101,7 +1129,7 @@ bool Creature::handleIdleAction()
             uint32_t index = Random::Uint(0,reachableCallToWars.size()-1);
             Spell* callToWar = reachableCallToWars[index];
             Tile* callToWarTile = callToWar->getPositionTile();
-            std::list<Tile*> tempPath = getGameMap()->path(this, callToWarTile);
+            std::list<Tile*> tempPath = getGameMap()->pathToSharedTarget(this, callToWarTile);
             // If we are 5 tiles from the call to war, we don't go there
             if(tempPath.size() >= 5)
             {
@@ -1283,7 +1311,7 @@ bool Creature::searchBestTargetInList(const std::vector<GameEntity*>& listObject
         std::vector<Tile*> coveredTiles = entity->getCoveredTiles();
         for(Tile* tile : coveredTiles)
         {
-            if(std::find(mVisibleTiles.begin(), mVisibleTiles.end(), tile) == mVisibleTiles.end())
+            if(!isTileVisible(tile))
                 continue;
 
             int dist = Pathfinding::squaredDistanceTile(*tile, *myTile);
@@ -1657,6 +1685,17 @@ void Creature::updateTilesInSight()
 
     // Only the tiles the creature can "see".
     mVisibleTiles = getGameMap()->visibleTiles(posTile->getX(), posTile->getY(), mDefinition->getSightRadius());
+    mVisibleTilesWindow.reset(posTile->getX(), posTile->getY(), mDefinition->getSightRadius());
+    for(Tile* tile : mVisibleTiles)
+        mVisibleTilesWindow.set(tile->getX(), tile->getY());
+}
+
+bool Creature::isTileVisible(const Tile* tile) const
+{
+    if(tile == nullptr)
+        return false;
+
+    return mVisibleTilesWindow.get(tile->getX(), tile->getY());
 }
 
 std::vector<GameEntity*> Creature::getVisibleEnemyObjects()
@@ -1883,6 +1922,8 @@ void Creature::createStatsWindow()
     rootWindow->addChild(mStatsWindow);
     mStatsWindow->show();
 
+    mStats = Utils::make_unique<CreatureStats>();
+
     updateStatsWindow("Loading...");
 }
 
@@ -1898,6 +1939,7 @@ void Creature::destroyStatsWindow()
 
         mStatsWindow->destroy();
         mStatsWindow = nullptr;
+        mStats.reset();
     }
 }
 
@@ -1910,62 +1952,79 @@ void Creature::updateStatsWindow(const std::string& txt)
     textWindow->setText(txt);
 }
 
-std::string Creature::getStatsText()
+void Creature::importStatsFromPacket(ODPacket& is)
 {
-    // The creatures are not refreshed at each turn so this information is relevant in the server
-    // GameMap only
-    const std::string formatTitleOn = "[font='MedievalSharp-12'][colour='CCBBBBFF']";
-    const std::string formatTitleOff = "[font='MedievalSharp-10'][colour='FFFFFFFF']";
-
-    std::stringstream tempSS;
-    tempSS << formatTitleOn << "Characteristics" << formatTitleOff << std::endl;
-    tempSS << "Level: " << getLevel() << std::endl;
-    tempSS << "Experience: " << mExp << std::endl;
-    tempSS << "HP: " << getHP() << " / " << mMaxHP << std::endl;
-    tempSS << "Gold: " << mGoldCarried << std::endl;
-    if (!getDefinition()->isWorker())
+    // The window may have been closed before the server got the unsubscription. The server
+    // sends a full record again when the window is opened
+    if(mStats == nullptr)
     {
-        tempSS << "Wakefulness: " << mWakefulness << std::endl;
-        tempSS << "Hunger: " << mHunger << std::endl;
+        OD_LOG_INF("name=" + getName() + ", dropping stats received while the stats window is closed");
+        return;
     }
-    tempSS << "Move speed (G/W/L): " << getMoveSpeedGround() << " / "
-        << getMoveSpeedWater() << " / " << getMoveSpeedLava() << std::endl;
-    tempSS << "Weapons:" << std::endl;
-    if(mWeaponL == nullptr)
-        tempSS << " - Left: none" << std::endl;
-    else
-        tempSS << " - Left: " << mWeaponL->getName() << " | Damage (P/M/E): " << mWeaponL->getPhysicalDamage()
-               << " / " << mWeaponL->getMagicalDamage() << " / " << mWeaponL->getElementDamage() << std::endl;
-    if(mWeaponR == nullptr)
-        tempSS << " - Right: none" << std::endl;
-    else
-        tempSS << " - Right: " << mWeaponR->getName() << " | Damage (P/M/E): " << mWeaponR->getPhysicalDamage()
-               << " / " << mWeaponR->getMagicalDamage() << " / " << mWeaponR->getElementDamage() << std::endl;
-    tempSS << "Defense (P/M/E): " << getPhysicalDefense() << " / " << getMagicalDefense() << " / " << getElementDefense() << std::endl;
-    if (getDefinition()->isWorker())
+
+    if(!mStats->importFromPacket(is))
     {
-        tempSS << "Dig rate: " << getDigRate() << std::endl;
-        tempSS << "Dance rate: " << mClaimRate << std::endl;
+        OD_LOG_ERR("name=" + getName());
+        return;
     }
 
-    tempSS << formatTitleOn << "\nDebugging information" << formatTitleOff << std::endl;
-    tempSS << "Seat and team IDs: " << getSeat()->getId() << " / " << getSeat()->getTeamId() << std::endl;
-    tempSS << "Position: " << Helper::toString(getPosition()) << std::endl;
-    tempSS << "Actions:";
-    for(const std::unique_ptr<CreatureAction>& ca : mActions)
+    // A delta sent for a previous subscription can arrive after the window is opened
+    // again. We wait for the full record before displaying anything
+    if((mStats->mImportedFields & CreatureStats::FieldAll) != CreatureStats::FieldAll)
     {
-        tempSS << " " << CreatureAction::toString(ca.get()->getType());
+        OD_LOG_INF("name=" + getName() + ", waiting for the full stats record");
+        return;
     }
-    tempSS << std::endl;
-    tempSS << "Destinations:";
-    for(const Ogre::Vector3& dest : mWalkQueue)
+
+    updateStatsWindow(mStats->toString());
+}
+
+void Creature::fillStats(CreatureStats& stats) const
+{
+    stats.mIsWorker = getDefinition()->isWorker();
+    stats.mLevel = getLevel();
+    stats.mExp = mExp;
+    stats.mHp = mHp;
+    stats.mMaxHP = mMaxHP;
+    stats.mGoldCarried = mGoldCarried;
+    stats.mWakefulness = mWakefulness;
+    stats.mHunger = mHunger;
+    stats.mMoveSpeedGround = getMoveSpeedGround();
+    stats.mMoveSpeedWater = getMoveSpeedWater();
+    stats.mMoveSpeedLava = getMoveSpeedLava();
+    stats.mWeaponL = CreatureStats::WeaponStats();
+    if(mWeaponL != nullptr)
     {
-        tempSS << " " << Helper::toStringWithoutZ(dest);
+        stats.mWeaponL.mEquipped = true;
+        stats.mWeaponL.mName = mWeaponL->getName();
+        stats.mWeaponL.mPhysicalDamage = mWeaponL->getPhysicalDamage();
+        stats.mWeaponL.mMagicalDamage = mWeaponL->getMagicalDamage();
+        stats.mWeaponL.mElementDamage = mWeaponL->getElementDamage();
     }
-    tempSS << std::endl;
-    tempSS << "Mood: " << CreatureMood::toString(mMoodValue) << std::endl;
-    tempSS << "Mood points: " << Helper::toString(mMoodPoints) << std::endl;
-    return tempSS.str();
+    stats.mWeaponR = CreatureStats::WeaponStats();
+    if(mWeaponR != nullptr)
+    {
+        stats.mWeaponR.mEquipped = true;
+        stats.mWeaponR.mName = mWeaponR->getName();
+        stats.mWeaponR.mPhysicalDamage = mWeaponR->getPhysicalDamage();
+        stats.mWeaponR.mMagicalDamage = mWeaponR->getMagicalDamage();
+        stats.mWeaponR.mElementDamage = mWeaponR->getElementDamage();
+    }
+    stats.mPhysicalDefense = getPhysicalDefense();
+    stats.mMagicalDefense = getMagicalDefense();
+    stats.mElementDefense = getElementDefense();
+    stats.mDigRate = getDigRate();
+    stats.mClaimRate = mClaimRate;
+    stats.mSeatId = getSeat()->getId();
+    stats.mTeamId = getSeat()->getTeamId();
+    stats.mPosition = getPosition();
+    stats.mActions.clear();
+    for(const std::unique_ptr<CreatureAction>& ca : mActions)
+        stats.mActions.push_back(ca->getType());
+
+    stats.mDestinations.assign(mWalkQueue.begin(), mWalkQueue.end());
+    stats.mMoodValue = mMoodValue;
+    stats.mMoodPoints = mMoodPoints;
 }
 
 double Creature::takeDamage(GameEntity* attacker, double absoluteDamage, double physicalDamage, double magicalDamage, double elementDamage,
@@ -1992,6 +2051,7 @@ double Creature::takeDamage(GameEntity* attacker, double absoluteDamage, double
 
     computeCreatureOverlayHealthValue();
     computeCreatureOverlayMoodValue();
+    refreshSeatLedger();
 
     if(!isAlive())
         fireEntityDead();
@@ -2526,6 +2586,7 @@ void Creature::slap()
     addCreatureEffect(effect);
     mHp -= mMaxHP * ConfigManager::getSingleton().getSlapDamagePercent() / 100.0;
     computeCreatureOverlayHealthValue();
+    refreshSeatLedger();
 }
 
 void Creature::fireAddEntity(Seat* seat, bool async)
@@ -2775,6 +2836,8 @@ void Creature::setupDefinition(GameMap& gameMap, const CreatureDefinition& defau
 
         computeCreatureOverlayHealthValue();
     }
+
+    refreshSeatLedger();
 }
 
 void Creature::fireCreatureSound(CreatureSound sound)
@@ -3037,10 +3100,99 @@ void Creature::checkWalkPathValid()
     if(!stop)
         return;
 
-    // There is an unpassable tile in our way. We stop what we are doing
+    // There is an unpassable tile in our way. If we can go around it, we keep going where we were
+    // going. Otherwise, we stop what we are doing
+    if(repairWalkPath())
+        return;
+
     clearDestinations(EntityAnimation::idle_anim, true, true);
 }
 
+bool Creature::repairWalkPath()
+{
+    // Each repair removes at least one blocked part of the path. If the path is blocked in too
+    // many places, it is not worth it
+    const uint32_t maxRepairs = 4;
+    std::vector<Ogre::Vector3> waypoints(mWalkQueue.begin(), mWalkQueue.end());
+    bool repaired = false;
+    for(uint32_t nbRepairs = 0; nbRepairs < maxRepairs; ++nbRepairs)
+    {
+        // We look for the first blocked waypoint
+        uint32_t blockedIndex = 0;
+        for(; blockedIndex < waypoints.size(); ++blockedIndex)
+        {
+            const Ogre::Vector3& dest = waypoints[blockedIndex];
+            Tile* tile = getGameMap()->getTile(Helper::round(dest.x), Helper::round(dest.y));
+            if(tile == nullptr)
+                return false;
+            if(!canGoThroughTile(tile))
+                break;
+        }
+
+        if(blockedIndex >= waypoints.size())
+        {
+            if(repaired)
+                replaceWalkPath(waypoints);
+
+            return true;
+        }
+
+        // We go from the waypoint before the blocked one to the first reachable one after it
+        Tile* startTile;
+        if(blockedIndex == 0)
+        {
+            startTile = getPositionTile();
+        }
+        else
+        {
+            const Ogre::Vector3& dest = waypoints[blockedIndex - 1];
+            startTile = getGameMap()->getTile(Helper::round(dest.x), Helper::round(dest.y));
+        }
+
+        if(startTile == nullptr)
+            return false;
+
+        uint32_t resumeIndex = blockedIndex + 1;
+        Tile* resumeTile = nullptr;
+        for(; resumeIndex < waypoints.size(); ++resumeIndex)
+        {
+            const Ogre::Vector3& dest = waypoints[resumeIndex];
+            Tile* tile = getGameMap()->getTile(Helper::round(dest.x), Helper::round(dest.y));
+            if(tile == nullptr)
+                return false;
+            if(!canGoThroughTile(tile))
+                continue;
+
+            resumeTile = tile;
+            break;
+        }
+
+        // If the destination itself is blocked, there is nothing to repair
+        if(resumeTile == nullptr)
+            return false;
+
+        std::list<Tile*> detour = getGameMap()->path(startTile, resumeTile, this, getSeat());
+        if(detour.empty())
+            return false;
+
+        for(Tile* tile : detour)
+        {
+            if(!canGoThroughTile(tile))
+                return false;
+        }
+
+        std::vector<Ogre::Vector3> detourWaypoints;
+        tileToVector3(detour, detourWaypoints, true, 0.0);
+        std::vector<Ogre::Vector3> newWaypoints(waypoints.begin(), waypoints.begin() + blockedIndex);
+        newWaypoints.insert(newWaypoints.end(), detourWaypoints.begin(), detourWaypoints.end());
+        newWaypoints.insert(newWaypoints.end(), waypoints.begin() + resumeIndex + 1, waypoints.end());
+        waypoints.swap(newWaypoints);
+        repaired = true;
+    }
+
+    return false;
+}
+
 void Creature::setJobCooldown(int val)
 {
     // If the creature has been slapped, its cooldown is decreased
@@ -3219,11 +3371,40 @@ void Creature::leaveDungeon()
     pushAction(Utils::make_unique<CreatureActionLeaveDungeon>(*this));
 }
 
+void Creature::refreshSeatLedger()
+{
+    if(!getIsOnServerMap())
+        return;
+
+    // When loading a level, creatures are added to the gamemap before their definition is
+    // set. setupDefinition will refresh the ledger once it is known
+    if(mDefinition == nullptr)
+        return;
+
+    // Creatures are counted in their seat ledger while they are in the gamemap and alive
+    Seat* seat = nullptr;
+    if(mIsInGameMap && isAlive())
+        seat = getSeat();
+
+    if(seat == mLedgerSeat)
+        return;
+
+    if(mLedgerSeat != nullptr)
+        mLedgerSeat->removeCreatureFromLedger(*this);
+
+    if(seat != nullptr)
+        seat->addCreatureToLedger(*this);
+
+    mLedgerSeat = seat;
+    getGameMap()->notifyGoalEvent(Goal::EventCreatures);
+}
+
 void Creature::changeSeat(Seat* newSeat)
 {
     OD_LOG_INF("creature=" + getName() + " changes side from seatId=" + Helper::toString(getSeat()->getId()) + " to seatId=" + Helper::toString(newSeat->getId()));
     OD_ASSERT_TRUE_MSG(getSeat() != newSeat, "creature=" + getName() + ", seatId=" + Helper::toString(newSeat->getId()));
     setSeat(newSeat);
+    refreshSeatLedger();
     mMoodValue = CreatureMoodLevel::Neutral;
     mMoodPoints = 0;
     mWakefulness = 100;
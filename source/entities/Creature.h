@@ -22,11 +22,13 @@
 #define CREATURE_H
 
 #include "entities/MovableGameEntity.h"
+#include "gamemap/TileWindowPlane.h"
 
 #include <OgreVector2.h>
 #include <OgreVector3.h>
 #include <CEGUI/EventArgs.h>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -37,6 +39,7 @@ class CreatureEffect;
 class CreatureDefinition;
 class CreatureOverlayStatus;
 class CreatureSkill;
+class CreatureStats;
 class GameMap;
 class ODPacket;
 class Room;
@@ -117,6 +120,10 @@ public:
     Creature(GameMap* gameMap, const CreatureDefinition* definition, Seat* seat, Ogre::Vector3 position = Ogre::Vector3(0.0f,0.0f,0.0f));
     virtual ~Creature();
 
+    //! \brief Creatures are allocated from a pool (see ObjectPool)
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     static const uint32_t NB_OVERLAY_HEALTH_VALUES;
 
     virtual GameEntityType getObjectType() const;
@@ -130,7 +137,13 @@ public:
     void destroyStatsWindow();
     bool CloseStatsWindow(const CEGUI::EventArgs& /*e*/);
     void updateStatsWindow(const std::string& txt);
-    std::string getStatsText();
+
+    //! \brief Fills the given record with the values displayed in the stats window. The
+    //! creatures are not refreshed at each turn so this is relevant in the server GameMap only
+    void fillStats(CreatureStats& stats) const;
+
+    //! \brief Applies the changes received from the server to the displayed stats (client side)
+    void importStatsFromPacket(ODPacket& is);
 
     //! \brief Get the level of the object
     inline unsigned int getLevel() const
@@ -398,6 +411,10 @@ public:
     inline const std::vector<Tile*>& getVisibleTiles() const
     { return mVisibleTiles; }
 
+    //! \brief Returns true if the given tile is within getVisibleTiles(). Unlike searching the
+    //! list, this is done in constant time
+    bool isTileVisible(const Tile* tile) const;
+
     inline const std::vector<Tile*>& getTilesWithinSightRadius() const
     { return mTilesWithinSightRadius; }
 
@@ -518,6 +535,10 @@ public:
     //! example if a door is closed)
     void checkWalkPathValid();
 
+    //! \brief Tries to replace the part of the walk path going through the tiles the creature cannot
+    //! go through anymore with a detour. Returns true if the whole path is valid afterwards
+    bool repairWalkPath();
+
     bool isTired() const;
 
     bool isHungry() const;
@@ -675,6 +696,8 @@ private:
     std::string     mWeaponDropDeath;
 
     CEGUI::Window*  mStatsWindow;
+    //! \brief Stats displayed in the stats window (client side). Created with the window
+    std::unique_ptr<CreatureStats> mStats;
     int32_t         mNbTurnsWithoutBattle;
 
     //! \brief Every tiles within the creature sight radius, used for common actions.
@@ -684,6 +707,9 @@ private:
     //! used for actions linked to enemies.
     std::vector<Tile*>              mVisibleTiles;
 
+    //! \brief Same tiles as mVisibleTiles, used to know if a tile is visible in constant time
+    TileWindowPlane                 mVisibleTilesWindow;
+
     std::vector<GameEntity*>        mVisibleEnemyObjects;
     std::vector<GameEntity*>        mVisibleAlliedObjects;
     std::vector<GameEntity*>        mReachableAlliedObjects;
@@ -758,6 +784,12 @@ private:
     //! \brief Counts the number of active slaps affecting the creature
     uint32_t                        mActiveSlapsCount;
 
+    //! \brief true between addToGameMap and removeFromGameMap
+    bool                            mIsInGameMap;
+
+    //! \brief Seat whose ledger counts this creature (nullptr if not counted). Used on server side only
+    Seat*                           mLedgerSeat;
+
     //! \brief Skills the creature can use
     std::vector<CreatureSkillData> mSkillData;
 
@@ -779,6 +811,10 @@ private:
     void computeMood();
 
     void computeCreatureOverlayMoodValue();
+
+    //! \brief Updates the seat ledger counting this creature. Should be called each time the
+    //! creature is added/removed from the gamemap, changes seat or its HP changes
+    void refreshSeatLedger();
 };
 
 #endif // CREATURE_H
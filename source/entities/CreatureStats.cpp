@@ -0,0 +1,361 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "entities/CreatureStats.h"
+
+#include "creatureaction/CreatureAction.h"
+#include "creaturemood/CreatureMood.h"
+#include "network/ODPacket.h"
+#include "utils/Helper.h"
+
+#include <sstream>
+
+const uint32_t CreatureStats::FieldWorker = 0x0001;
+const uint32_t CreatureStats::FieldLevel = 0x0002;
+const uint32_t CreatureStats::FieldHP = 0x0004;
+const uint32_t CreatureStats::FieldGold = 0x0008;
+const uint32_t CreatureStats::FieldNeeds = 0x0010;
+const uint32_t CreatureStats::FieldMoveSpeed = 0x0020;
+const uint32_t CreatureStats::FieldWeaponL = 0x0040;
+const uint32_t CreatureStats::FieldWeaponR = 0x0080;
+const uint32_t CreatureStats::FieldDefense = 0x0100;
+const uint32_t CreatureStats::FieldWorkRates = 0x0200;
+const uint32_t CreatureStats::FieldSeat = 0x0400;
+const uint32_t CreatureStats::FieldPosition = 0x0800;
+const uint32_t CreatureStats::FieldActions = 0x1000;
+const uint32_t CreatureStats::FieldDestinations = 0x2000;
+const uint32_t CreatureStats::FieldMood = 0x4000;
+const uint32_t CreatureStats::FieldAll = 0x7FFF;
+
+bool CreatureStats::WeaponStats::operator==(const WeaponStats& other) const
+{
+    if(mEquipped != other.mEquipped)
+        return false;
+
+    // The values of a missing weapon are not displayed
+    if(!mEquipped)
+        return true;
+
+    return (mName == other.mName) &&
+        (mPhysicalDamage == other.mPhysicalDamage) &&
+        (mMagicalDamage == other.mMagicalDamage) &&
+        (mElementDamage == other.mElementDamage);
+}
+
+static void exportWeaponToPacket(ODPacket& os, const CreatureStats::WeaponStats& weapon)
+{
+    os << weapon.mEquipped;
+    if(weapon.mEquipped)
+        os << weapon.mName << weapon.mPhysicalDamage << weapon.mMagicalDamage << weapon.mElementDamage;
+}
+
+static bool importWeaponFromPacket(ODPacket& is, CreatureStats::WeaponStats& weapon)
+{
+    if(!(is >> weapon.mEquipped))
+        return false;
+
+    if(!weapon.mEquipped)
+        return true;
+
+    return is >> weapon.mName >> weapon.mPhysicalDamage >> weapon.mMagicalDamage >> weapon.mElementDamage;
+}
+
+static void exportWeaponToStream(std::ostream& os, const std::string& hand, const CreatureStats::WeaponStats& weapon)
+{
+    if(!weapon.mEquipped)
+    {
+        os << " - " << hand << ": none" << std::endl;
+        return;
+    }
+
+    os << " - " << hand << ": " << weapon.mName << " | Damage (P/M/E): " << weapon.mPhysicalDamage
+       << " / " << weapon.mMagicalDamage << " / " << weapon.mElementDamage << std::endl;
+}
+
+CreatureStats::CreatureStats() :
+    mIsWorker(false),
+    mLevel(0),
+    mExp(0.0),
+    mHp(0.0),
+    mMaxHP(0.0),
+    mGoldCarried(0),
+    mWakefulness(0.0),
+    mHunger(0.0),
+    mMoveSpeedGround(0.0),
+    mMoveSpeedWater(0.0),
+    mMoveSpeedLava(0.0),
+    mPhysicalDefense(0.0),
+    mMagicalDefense(0.0),
+    mElementDefense(0.0),
+    mDigRate(0.0),
+    mClaimRate(0.0),
+    mSeatId(-1),
+    mTeamId(-1),
+    mPosition(Ogre::Vector3::ZERO),
+    mMoodValue(CreatureMoodLevel::Neutral),
+    mMoodPoints(0),
+    mImportedFields(0)
+{
+}
+
+uint32_t CreatureStats::getChangedFields(const CreatureStats& other) const
+{
+    uint32_t fields = 0;
+    if(mIsWorker != other.mIsWorker)
+        fields |= FieldWorker;
+    if((mLevel != other.mLevel) || (mExp != other.mExp))
+        fields |= FieldLevel;
+    if((mHp != other.mHp) || (mMaxHP != other.mMaxHP))
+        fields |= FieldHP;
+    if(mGoldCarried != other.mGoldCarried)
+        fields |= FieldGold;
+    if((mWakefulness != other.mWakefulness) || (mHunger != other.mHunger))
+        fields |= FieldNeeds;
+    if((mMoveSpeedGround != other.mMoveSpeedGround) ||
+       (mMoveSpeedWater != other.mMoveSpeedWater) ||
+       (mMoveSpeedLava != other.mMoveSpeedLava))
+    {
+        fields |= FieldMoveSpeed;
+    }
+    if(mWeaponL != other.mWeaponL)
+        fields |= FieldWeaponL;
+    if(mWeaponR != other.mWeaponR)
+        fields |= FieldWeaponR;
+    if((mPhysicalDefense != other.mPhysicalDefense) ||
+       (mMagicalDefense != other.mMagicalDefense) ||
+       (mElementDefense != other.mElementDefense))
+    {
+        fields |= FieldDefense;
+    }
+    if((mDigRate != other.mDigRate) || (mClaimRate != other.mClaimRate))
+        fields |= FieldWorkRates;
+    if((mSeatId != other.mSeatId) || (mTeamId != other.mTeamId))
+        fields |= FieldSeat;
+    if(mPosition != other.mPosition)
+        fields |= FieldPosition;
+    if(mActions != other.mActions)
+        fields |= FieldActions;
+    if(mDestinations != other.mDestinations)
+        fields |= FieldDestinations;
+    if((mMoodValue != other.mMoodValue) || (mMoodPoints != other.mMoodPoints))
+        fields |= FieldMood;
+
+    return fields;
+}
+
+void CreatureStats::exportToPacket(ODPacket& os, uint32_t fields) const
+{
+    os << fields;
+    if((fields & FieldWorker) != 0)
+        os << mIsWorker;
+    if((fields & FieldLevel) != 0)
+        os << static_cast<uint32_t>(mLevel) << mExp;
+    if((fields & FieldHP) != 0)
+        os << mHp << mMaxHP;
+    if((fields & FieldGold) != 0)
+        os << mGoldCarried;
+    if((fields & FieldNeeds) != 0)
+        os << mWakefulness << mHunger;
+    if((fields & FieldMoveSpeed) != 0)
+        os << mMoveSpeedGround << mMoveSpeedWater << mMoveSpeedLava;
+    if((fields & FieldWeaponL) != 0)
+        exportWeaponToPacket(os, mWeaponL);
+    if((fields & FieldWeaponR) != 0)
+        exportWeaponToPacket(os, mWeaponR);
+    if((fields & FieldDefense) != 0)
+        os << mPhysicalDefense << mMagicalDefense << mElementDefense;
+    if((fields & FieldWorkRates) != 0)
+        os << mDigRate << mClaimRate;
+    if((fields & FieldSeat) != 0)
+        os << static_cast<int32_t>(mSeatId) << static_cast<int32_t>(mTeamId);
+    if((fields & FieldPosition) != 0)
+        os << mPosition;
+    if((fields & FieldActions) != 0)
+    {
+        os << static_cast<uint32_t>(mActions.size());
+        for(CreatureActionType type : mActions)
+            os << static_cast<uint32_t>(type);
+    }
+    if((fields & FieldDestinations) != 0)
+    {
+        os << static_cast<uint32_t>(mDestinations.size());
+        for(const Ogre::Vector3& dest : mDestinations)
+            os << dest;
+    }
+    if((fields & FieldMood) != 0)
+        os << static_cast<uint32_t>(mMoodValue) << mMoodPoints;
+}
+
+bool CreatureStats::importFromPacket(ODPacket& is)
+{
+    uint32_t fields;
+    if(!(is >> fields))
+        return false;
+
+    if((fields & FieldWorker) != 0)
+    {
+        if(!(is >> mIsWorker))
+            return false;
+    }
+    if((fields & FieldLevel) != 0)
+    {
+        uint32_t level;
+        if(!(is >> level >> mExp))
+            return false;
+        mLevel = level;
+    }
+    if((fields & FieldHP) != 0)
+    {
+        if(!(is >> mHp >> mMaxHP))
+            return false;
+    }
+    if((fields & FieldGold) != 0)
+    {
+        if(!(is >> mGoldCarried))
+            return false;
+    }
+    if((fields & FieldNeeds) != 0)
+    {
+        if(!(is >> mWakefulness >> mHunger))
+            return false;
+    }
+    if((fields & FieldMoveSpeed) != 0)
+    {
+        if(!(is >> mMoveSpeedGround >> mMoveSpeedWater >> mMoveSpeedLava))
+            return false;
+    }
+    if((fields & FieldWeaponL) != 0)
+    {
+        if(!importWeaponFromPacket(is, mWeaponL))
+            return false;
+    }
+    if((fields & FieldWeaponR) != 0)
+    {
+        if(!importWeaponFromPacket(is, mWeaponR))
+            return false;
+    }
+    if((fields & FieldDefense) != 0)
+    {
+        if(!(is >> mPhysicalDefense >> mMagicalDefense >> mElementDefense))
+            return false;
+    }
+    if((fields & FieldWorkRates) != 0)
+    {
+        if(!(is >> mDigRate >> mClaimRate))
+            return false;
+    }
+    if((fields & FieldSeat) != 0)
+    {
+        int32_t seatId;
+        int32_t teamId;
+        if(!(is >> seatId >> teamId))
+            return false;
+        mSeatId = seatId;
+        mTeamId = teamId;
+    }
+    if((fields & FieldPosition) != 0)
+    {
+        if(!(is >> mPosition))
+            return false;
+    }
+    if((fields & FieldActions) != 0)
+    {
+        uint32_t nb;
+        if(!(is >> nb))
+            return false;
+        mActions.clear();
+        for(uint32_t i = 0; i < nb; ++i)
+        {
+            uint32_t type;
+            if(!(is >> type))
+                return false;
+            mActions.push_back(static_cast<CreatureActionType>(type));
+        }
+    }
+    if((fields & FieldDestinations) != 0)
+    {
+        uint32_t nb;
+        if(!(is >> nb))
+            return false;
+        mDestinations.clear();
+        for(uint32_t i = 0; i < nb; ++i)
+        {
+            Ogre::Vector3 dest;
+            if(!(is >> dest))
+                return false;
+            mDestinations.push_back(dest);
+        }
+    }
+    if((fields & FieldMood) != 0)
+    {
+        uint32_t moodValue;
+        if(!(is >> moodValue >> mMoodPoints))
+            return false;
+        mMoodValue = static_cast<CreatureMoodLevel>(moodValue);
+    }
+
+    mImportedFields |= fields;
+    return true;
+}
+
+std::string CreatureStats::toString() const
+{
+    const std::string formatTitleOn = "[font='MedievalSharp-12'][colour='CCBBBBFF']";
+    const std::string formatTitleOff = "[font='MedievalSharp-10'][colour='FFFFFFFF']";
+
+    std::stringstream tempSS;
+    tempSS << formatTitleOn << "Characteristics" << formatTitleOff << std::endl;
+    tempSS << "Level: " << mLevel << std::endl;
+    tempSS << "Experience: " << mExp << std::endl;
+    tempSS << "HP: " << mHp << " / " << mMaxHP << std::endl;
+    tempSS << "Gold: " << mGoldCarried << std::endl;
+    if (!mIsWorker)
+    {
+        tempSS << "Wakefulness: " << mWakefulness << std::endl;
+        tempSS << "Hunger: " << mHunger << std::endl;
+    }
+    tempSS << "Move speed (G/W/L): " << mMoveSpeedGround << " / "
+        << mMoveSpeedWater << " / " << mMoveSpeedLava << std::endl;
+    tempSS << "Weapons:" << std::endl;
+    exportWeaponToStream(tempSS, "Left", mWeaponL);
+    exportWeaponToStream(tempSS, "Right", mWeaponR);
+    tempSS << "Defense (P/M/E): " << mPhysicalDefense << " / " << mMagicalDefense << " / " << mElementDefense << std::endl;
+    if (mIsWorker)
+    {
+        tempSS << "Dig rate: " << mDigRate << std::endl;
+        tempSS << "Dance rate: " << mClaimRate << std::endl;
+    }
+
+    tempSS << formatTitleOn << "\nDebugging information" << formatTitleOff << std::endl;
+    tempSS << "Seat and team IDs: " << mSeatId << " / " << mTeamId << std::endl;
+    tempSS << "Position: " << Helper::toString(mPosition) << std::endl;
+    tempSS << "Actions:";
+    for(CreatureActionType type : mActions)
+    {
+        tempSS << " " << CreatureAction::toString(type);
+    }
+    tempSS << std::endl;
+    tempSS << "Destinations:";
+    for(const Ogre::Vector3& dest : mDestinations)
+    {
+        tempSS << " " << Helper::toStringWithoutZ(dest);
+    }
+    tempSS << std::endl;
+    tempSS << "Mood: " << CreatureMood::toString(mMoodValue) << std::endl;
+    tempSS << "Mood points: " << Helper::toString(mMoodPoints) << std::endl;
+    return tempSS.str();
+}
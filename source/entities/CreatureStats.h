@@ -0,0 +1,123 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CREATURESTATS_H
+#define CREATURESTATS_H
+
+#include <OgreVector3.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ODPacket;
+
+enum class CreatureActionType;
+enum class CreatureMoodLevel;
+
+//! \brief Values displayed in the creature stats window. They are filled on the server and
+//! streamed to the clients that have the window opened. Only the fields that changed since
+//! the last record sent to a client are exported (see getChangedFields). The text displayed
+//! is built on the client side with toString.
+class CreatureStats
+{
+public:
+    //! \brief Bits used in the changed fields mask. Each bit covers a group of values
+    //! that are displayed together
+    static const uint32_t FieldWorker;
+    static const uint32_t FieldLevel;
+    static const uint32_t FieldHP;
+    static const uint32_t FieldGold;
+    static const uint32_t FieldNeeds;
+    static const uint32_t FieldMoveSpeed;
+    static const uint32_t FieldWeaponL;
+    static const uint32_t FieldWeaponR;
+    static const uint32_t FieldDefense;
+    static const uint32_t FieldWorkRates;
+    static const uint32_t FieldSeat;
+    static const uint32_t FieldPosition;
+    static const uint32_t FieldActions;
+    static const uint32_t FieldDestinations;
+    static const uint32_t FieldMood;
+    static const uint32_t FieldAll;
+
+    struct WeaponStats
+    {
+        WeaponStats() :
+            mEquipped(false),
+            mPhysicalDamage(0.0),
+            mMagicalDamage(0.0),
+            mElementDamage(0.0)
+        {}
+
+        bool operator==(const WeaponStats& other) const;
+        bool operator!=(const WeaponStats& other) const
+        { return !(*this == other); }
+
+        bool mEquipped;
+        std::string mName;
+        double mPhysicalDamage;
+        double mMagicalDamage;
+        double mElementDamage;
+    };
+
+    CreatureStats();
+
+    //! \brief Returns the mask of the fields that differ between this record and the given one
+    uint32_t getChangedFields(const CreatureStats& other) const;
+
+    //! \brief Writes the given fields mask followed by the values of the fields it contains
+    void exportToPacket(ODPacket& os, uint32_t fields) const;
+
+    //! \brief Reads a record exported with exportToPacket. Only the fields that were exported
+    //! are changed. Returns false if the packet could not be read
+    bool importFromPacket(ODPacket& is);
+
+    //! \brief Builds the text displayed in the creature stats window
+    std::string toString() const;
+
+    bool mIsWorker;
+    unsigned int mLevel;
+    double mExp;
+    double mHp;
+    double mMaxHP;
+    int32_t mGoldCarried;
+    double mWakefulness;
+    double mHunger;
+    double mMoveSpeedGround;
+    double mMoveSpeedWater;
+    double mMoveSpeedLava;
+    WeaponStats mWeaponL;
+    WeaponStats mWeaponR;
+    double mPhysicalDefense;
+    double mMagicalDefense;
+    double mElementDefense;
+    double mDigRate;
+    double mClaimRate;
+    int mSeatId;
+    int mTeamId;
+    Ogre::Vector3 mPosition;
+    std::vector<CreatureActionType> mActions;
+    std::vector<Ogre::Vector3> mDestinations;
+    CreatureMoodLevel mMoodValue;
+    int32_t mMoodPoints;
+
+    //! \brief Fields read by importFromPacket since this record was created
+    uint32_t mImportedFields;
+};
+
+#endif // CREATURESTATS_H
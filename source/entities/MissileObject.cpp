@@ -24,6 +24,7 @@
 #include "entities/Tile.h"
 #include "game/Seat.h"
 #include "gamemap/GameMap.h"
+#include "gamemap/TileLineWalker.h"
 #include "network/ODPacket.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
@@ -96,21 +97,20 @@ void MissileObject::doUpkeep()
     Ogre::Vector3 position = getPosition();
     double moveDist = getMoveSpeed();
     Ogre::Vector3 destination;
-    std::list<Tile*> tiles;
-    mIsMissileAlive = computeDestination(position, moveDist, mDirection, destination, tiles);
+    TileLineWalker walker;
+    mIsMissileAlive = computeDestination(position, moveDist, mDirection, destination, walker);
 
     std::vector<Ogre::Vector3> path;
+    std::vector<Tile*> tileVector(1, nullptr);
     Tile* lastTile = nullptr;
-    while(!tiles.empty() && mIsMissileAlive)
+    int x;
+    int y;
+    while(mIsMissileAlive && walker.next(x, y))
     {
-        Tile* tmpTile = tiles.front();
-        tiles.pop_front();
-
+        // The destination is within the map so the walk stops at the destination tile
+        Tile* tmpTile = getGameMap()->getTile(x, y);
         if(tmpTile == nullptr)
-        {
-            OD_LOG_ERR("Unexpected null tile when reading missile path name=" + getName() + ", lastTile=" + (lastTile == nullptr ? std::string("nullptr") : Tile::displayAsString(lastTile)));
-            continue;
-        }
+            break;
 
         if(tmpTile->getFullness() > 0.0)
         {
@@ -130,7 +130,7 @@ void MissileObject::doUpkeep()
                 path.push_back(position);
                 // We compute next position
                 mDirection = nextDirection;
-                mIsMissileAlive = computeDestination(position, moveDist, mDirection, destination, tiles);
+                mIsMissileAlive = computeDestination(position, moveDist, mDirection, destination, walker);
                 continue;
             }
         }
@@ -165,8 +165,7 @@ void MissileObject::doUpkeep()
             }
         }
 
-        std::vector<Tile*> tileVector;
-        tileVector.push_back(tmpTile);
+        tileVector[0] = tmpTile;
         std::vector<GameEntity*> enemyCreatures = getGameMap()->getVisibleCreatures(tileVector, getSeat(), true);
         for(std::vector<GameEntity*>::iterator it = enemyCreatures.begin(); it != enemyCreatures.end(); ++it)
         {
@@ -202,12 +201,15 @@ void MissileObject::doUpkeep()
 }
 
 bool MissileObject::computeDestination(const Ogre::Vector3& position, double moveDist, const Ogre::Vector3& direction,
-        Ogre::Vector3& destination, std::list<Tile*>& tiles)
+        Ogre::Vector3& destination, TileLineWalker& walker)
 {
     destination = position + (moveDist * direction);
-    tiles = getGameMap()->tilesBetween(Helper::round(position.x),
-        Helper::round(position.y), Helper::round(destination.x), Helper::round(destination.y));
-    if(tiles.empty())
+    int x1 = Helper::round(position.x);
+    int y1 = Helper::round(position.y);
+    int x2 = Helper::round(destination.x);
+    int y2 = Helper::round(destination.y);
+    walker.reset(x1, y1, x2, y2);
+    if(getGameMap()->getTile(x1, y1) == nullptr)
     {
         OD_LOG_ERR("missile=" + getName() + " has unexpected empty tiles destination");
         return false;
@@ -219,12 +221,17 @@ bool MissileObject::computeDestination(const Ogre::Vector3& position, double mov
        (direction.y > 0 && destination.y > static_cast<Ogre::Real>(getGameMap()->getMapSizeY() - 1)) ||
        (direction.y < 0 && destination.y < 0))
     {
-        Tile* lastTile = tiles.back();
+        uint32_t nbTiles = 0;
+        Tile* lastTile = getGameMap()->forEachTileBetween(x1, y1, x2, y2, [&nbTiles](Tile* /*tile*/)
+        {
+            ++nbTiles;
+            return true;
+        });
         destination.x = static_cast<Ogre::Real>(lastTile->getX());
         destination.y = static_cast<Ogre::Real>(lastTile->getY());
 
         // We are in the last position, we can die
-        if(tiles.size() <= 1)
+        if(nbTiles <= 1)
             return false;
     }
 
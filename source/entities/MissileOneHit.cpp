@@ -21,10 +21,26 @@
 #include "gamemap/GameMap.h"
 #include "network/ODPacket.h"
 #include "utils/LogManager.h"
+#include "utils/ObjectPool.h"
 #include "utils/Random.h"
 
 #include <iostream>
 
+namespace
+{
+ObjectPool sMissileOneHitPool("MissileOneHit", sizeof(MissileOneHit));
+} // namespace <none>
+
+void* MissileOneHit::operator new(std::size_t size)
+{
+    return sMissileOneHitPool.allocate(size);
+}
+
+void MissileOneHit::operator delete(void* ptr, std::size_t size)
+{
+    sMissileOneHitPool.release(ptr, size);
+}
+
 MissileOneHit::MissileOneHit(GameMap* gameMap, Seat* seat, const std::string& senderName, const std::string& meshName,
         const std::string& particleScript, const Ogre::Vector3& direction, double speed, double physicalDamage, double magicalDamage,
         double elementDamage, GameEntity* entityTarget, bool damageAllies, bool koEnemyCreature, bool notifyPlayerIfHit) :
@@ -20,6 +20,7 @@
 
 #include "entities/MissileObject.h"
 
+#include <cstddef>
 #include <string>
 #include <iosfwd>
 
@@ -37,6 +38,10 @@ public:
         double elementDamage, GameEntity* entityTarget, bool damageAllies, bool koEnemyCreature, bool notifyPlayerIfHit);
     MissileOneHit(GameMap* gameMap);
 
+    //! \brief Missiles are allocated from a pool (see ObjectPool)
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     virtual MissileObjectType getMissileType() const override
     { return MissileObjectType::oneHit; }
 
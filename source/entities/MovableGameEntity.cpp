@@ -110,6 +110,12 @@ void MovableGameEntity::setWalkPath(const std::string& walkAnim, const std::stri
     }
 }
 
+void MovableGameEntity::replaceWalkPath(const std::vector<Ogre::Vector3>& path)
+{
+    setWalkPath(mPrevAnimationState, mDestinationAnimationState, mDestinationAnimationLoop,
+        mDestinationPlayIdleWhenAnimationEnds, path);
+}
+
 void MovableGameEntity::clearDestinations(const std::string& animation, bool loopAnim, bool playIdleWhenAnimationEnds)
 {
     mWalkQueue.clear();
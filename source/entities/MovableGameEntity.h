@@ -117,6 +117,10 @@ protected:
     std::string mPrevAnimationState;
     bool mPrevAnimationStateLoop;
 
+    //! \brief Replaces the remaining walk queue with the given path while keeping the current
+    //! walk animation and the animation wanted at destination. This is a server side function
+    void replaceWalkPath(const std::vector<Ogre::Vector3>& path);
+
 private:
     void fireObjectAnimationState(const std::string& state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds);
     Ogre::AnimationState* mAnimationState;
@@ -69,6 +69,7 @@ Tile::Tile(GameMap* gameMap, int x, int y, TileType type, double fullness) :
     mTileCulling        (CullingType::HIDE),
     mNbWorkersClaiming(0)
 {
+    mNbWorkersDigging.fill(0);
     computeTileVisual();
 }
 
@@ -137,7 +138,7 @@ bool Tile::isWallClaimable(Seat* seat)
     // Check whether at least one neighbor is a claimed ground tile of the given seat
     // which is a condition to permit claiming the given wall tile.
     bool foundClaimedGroundTile = false;
-    for (Tile* tile : mNeighbors)
+    for (Tile* tile : getAllNeighbors())
     {
         if (tile->getFullness() > 0.0)
             continue;
@@ -167,7 +168,7 @@ bool Tile::isWallClaimable(Seat* seat)
         return true;
 
     foundClaimedGroundTile = false;
-    for (Tile* tile : mNeighbors)
+    for (Tile* tile : getAllNeighbors())
     {
         if (tile->getFullness() > 0.0)
             continue;
@@ -403,7 +404,11 @@ void Tile::setMarkedForDigging(bool ss, const Player *pp)
 
 bool Tile::getMarkedForDigging(const Player *p) const
 {
-    if(std::find(mPlayersMarkingTile.begin(), mPlayersMarkingTile.end(), p) != mPlayersMarkingTile.end())
+    if(mSparseData == nullptr)
+        return false;
+
+    const std::vector<const Player*>& players = mSparseData->mPlayersMarkingTile;
+    if(std::find(players.begin(), players.end(), p) != players.end())
         return true;
 
     return false;
@@ -411,38 +416,67 @@ bool Tile::getMarkedForDigging(const Player *p) const
 
 bool Tile::isMarkedForDiggingByAnySeat()
 {
-    return !mPlayersMarkingTile.empty();
+    return (mSparseData != nullptr) && !mSparseData->mPlayersMarkingTile.empty();
 }
 
 void Tile::addPlayerMarkingTile(const Player *p)
 {
-    mPlayersMarkingTile.push_back(p);
+    getSparseData().mPlayersMarkingTile.push_back(p);
+    if(p->getSeat() != nullptr)
+        getGameMap()->refreshTileMarkedForDiggingPlane(*this, p->getSeat()->getId(), true);
 }
 
 void Tile::removePlayerMarkingTile(const Player *p)
 {
-    auto it = std::find(mPlayersMarkingTile.begin(), mPlayersMarkingTile.end(), p);
-    if(it == mPlayersMarkingTile.end())
+    if(mSparseData == nullptr)
+        return;
+
+    std::vector<const Player*>& players = mSparseData->mPlayersMarkingTile;
+    auto it = std::find(players.begin(), players.end(), p);
+    if(it == players.end())
         return;
 
-    mPlayersMarkingTile.erase(it);
+    players.erase(it);
+    releaseSparseDataIfUnused();
+    if(p->getSeat() != nullptr)
+        getGameMap()->refreshTileMarkedForDiggingPlane(*this, p->getSeat()->getId(), false);
 }
 
-void Tile::addNeighbor(Tile *n)
+TileNeighbors Tile::getAllNeighbors() const
 {
-    mNeighbors.push_back(n);
-    mNbWorkersDigging.push_back(0);
+    return getGameMap()->getTileNeighbors(mX, mY);
 }
 
-Tile* Tile::getNeighbor(unsigned int index)
+uint64_t Tile::getMemoryUsage() const
 {
-    if(index >= mNeighbors.size())
+    uint64_t bytes = sizeof(Tile) + mEntitiesInTile.capacity() * sizeof(GameEntity*);
+    if(mSparseData != nullptr)
     {
-        OD_LOG_ERR("tile=" + displayAsString(this) + ", index=" + Helper::toString(index) + ", size=" + Helper::toString(mNeighbors.size()));
-        return nullptr;
+        bytes += sizeof(SparseData)
+            + mSparseData->mPlayersMarkingTile.capacity() * sizeof(const Player*)
+            + mSparseData->mStateListeners.capacity() * sizeof(TileStateListener*);
     }
+    return bytes;
+}
+
+Tile::SparseData& Tile::getSparseData()
+{
+    if(mSparseData == nullptr)
+        mSparseData.reset(new SparseData);
+
+    return *mSparseData;
+}
+
+void Tile::releaseSparseDataIfUnused()
+{
+    if(mSparseData == nullptr)
+        return;
+    if(!mSparseData->mPlayersMarkingTile.empty())
+        return;
+    if(!mSparseData->mStateListeners.empty())
+        return;
 
-    return mNeighbors[index];
+    mSparseData.reset();
 }
 
 std::string Tile::buildName(int x, int y)
@@ -551,116 +585,68 @@ bool Tile::isSameFloodFill(Seat* seat, FloodFillType type, Tile* tile) const
     return getFloodFillValue(seat, type) == tile->getFloodFillValue(seat, type);
 }
 
-void Tile::resetFloodFill()
+bool Tile::checkFloodFillIndex(const Seat* seat, uint32_t intType) const
 {
-    for(std::vector<uint32_t>& values : mFloodFillColor)
+    uint32_t nbTeams = getGameMap()->getNbFloodFillTeams();
+    if((seat->getTeamIndex() < nbTeams) &&
+       (intType < static_cast<uint32_t>(FloodFillType::nbValues)))
     {
-        for(uint32_t& floodFillValue : values)
-        {
-            floodFillValue = NO_FLOODFILL;
-        }
+        return true;
     }
-}
 
-bool Tile::updateFloodFillFromTile(Seat* seat, FloodFillType type, Tile* tile)
-{
-    if(seat->getTeamIndex() >= mFloodFillColor.size())
+    static bool logMsg = false;
+    if(!logMsg)
     {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", seatIndex=" + Helper::toString(seat->getTeamIndex()) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(mFloodFillColor.size()))
-                + ", fullness=" + Helper::toString(getFullness()));
-        }
-        return false;
+        logMsg = true;
+        OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
+            + ", tile=" + Tile::displayAsString(this)
+            + ", seatIndex=" + Helper::toString(seat->getTeamIndex()) + ", floodfillsize=" + Helper::toString(nbTeams)
+            + ", intType=" + Helper::toString(intType) + ", fullness=" + Helper::toString(getFullness()));
     }
+    return false;
+}
 
-    std::vector<uint32_t>& values = mFloodFillColor[seat->getTeamIndex()];
+bool Tile::updateFloodFillFromTile(Seat* seat, FloodFillType type, Tile* tile)
+{
     uint32_t intType = static_cast<uint32_t>(type);
-    if(intType >= values.size())
-    {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", intType=" + Helper::toString(intType) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(values.size())));
-        }
+    if(!checkFloodFillIndex(seat, intType))
         return false;
-    }
 
-    if((values[intType] != NO_FLOODFILL) ||
+    if((getFloodFillValue(seat, type) != NO_FLOODFILL) ||
        (tile->getFloodFillValue(seat, type) == NO_FLOODFILL))
     {
         return false;
     }
 
-    values[intType] = tile->getFloodFillValue(seat, type);
+    getGameMap()->setFloodFillValue(mX, mY, seat->getTeamIndex(), intType, tile->getFloodFillValue(seat, type));
     return true;
 }
 
 void Tile::replaceFloodFill(Seat* seat, FloodFillType type, uint32_t newValue)
 {
-    if(seat->getTeamIndex() >= mFloodFillColor.size())
-    {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", seatIndex=" + Helper::toString(seat->getTeamIndex()) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(mFloodFillColor.size())));
-        }
-        return;
-    }
-
-    std::vector<uint32_t>& values = mFloodFillColor[seat->getTeamIndex()];
     uint32_t intType = static_cast<uint32_t>(type);
-    if(intType >= values.size())
-    {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", intType=" + Helper::toString(intType) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(values.size())));
-        }
+    if(!checkFloodFillIndex(seat, intType))
         return;
-    }
 
-    values[intType] = newValue;
+    getGameMap()->setFloodFillValue(mX, mY, seat->getTeamIndex(), intType, newValue);
 }
 
 void Tile::copyFloodFillToOtherSeats(Seat* seatToCopy)
 {
-    if(seatToCopy->getTeamIndex() >= mFloodFillColor.size())
-    {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seatToCopy->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", seatIndex=" + Helper::toString(seatToCopy->getTeamIndex()) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(mFloodFillColor.size())));
-        }
+    if(!checkFloodFillIndex(seatToCopy, 0))
         return;
-    }
 
-    std::vector<uint32_t>& valuesToCopy = mFloodFillColor[seatToCopy->getTeamIndex()];
-    for(uint32_t indexFloodFill = 0; indexFloodFill < mFloodFillColor.size(); ++indexFloodFill)
+    GameMap* gameMap = getGameMap();
+    for(uint32_t teamIndex = 0; teamIndex < gameMap->getNbFloodFillTeams(); ++teamIndex)
     {
-        if(seatToCopy->getTeamIndex() == indexFloodFill)
+        if(seatToCopy->getTeamIndex() == teamIndex)
             continue;
 
-        std::vector<uint32_t>& values = mFloodFillColor[indexFloodFill];
         for(uint32_t intType = 0; intType < static_cast<uint32_t>(FloodFillType::nbValues); ++intType)
-            values[intType] = valuesToCopy[intType];
-
+        {
+            uint32_t value = gameMap->getFloodFillValue(mX, mY, seatToCopy->getTeamIndex(), intType);
+            gameMap->setFloodFillValue(mX, mY, teamIndex, intType, value);
+        }
     }
 }
 
@@ -670,13 +656,12 @@ void Tile::logFloodFill() const
         + " - type=" + Tile::tileVisualToString(getTileVisual())
         + " - fullness=" + Helper::toString(getFullness())
         + " - seatId=" + std::string(getSeat() == nullptr ? "-1" : Helper::toString(getSeat()->getId()));
-    for(const std::vector<uint32_t>& values : mFloodFillColor)
+    for(uint32_t teamIndex = 0; teamIndex < getGameMap()->getNbFloodFillTeams(); ++teamIndex)
     {
-        int cpt = 0;
-        for(const uint32_t& floodFill : values)
+        for(uint32_t intType = 0; intType < static_cast<uint32_t>(FloodFillType::nbValues); ++intType)
         {
-            str += ", [" + Helper::toString(cpt) + "]=" + Helper::toString(floodFill);
-            ++cpt;
+            uint32_t floodFill = getGameMap()->getFloodFillValue(mX, mY, teamIndex, intType);
+            str += ", [" + Helper::toString(intType) + "]=" + Helper::toString(floodFill);
         }
     }
     OD_LOG_INF(str);
@@ -719,58 +704,50 @@ bool Tile::isClaimed() const
     return true;
 }
 
-void Tile::clearVision()
-{
-    mSeatsWithVision.clear();
-}
-
 void Tile::notifyVision(Seat* seat)
 {
-    if(std::find(mSeatsWithVision.begin(), mSeatsWithVision.end(), seat) != mSeatsWithVision.end())
+    if(!getGameMap()->setTileVisionForSeat(*this, seat->getIndex()))
         return;
 
     seat->notifyVisionOnTile(this);
-    mSeatsWithVision.push_back(seat);
 
     // We also notify vision for allied seats
     for(Seat* alliedSeat : seat->getAlliedSeats())
         notifyVision(alliedSeat);
 }
 
-void Tile::setSeats(const std::vector<Seat*>& seats)
+bool Tile::hasVision(const Seat* seat) const
 {
-    mTileChangedForSeats.clear();
-    for(Seat* seat : seats)
-    {
-        // Every tile should be notified by default
-        std::pair<Seat*, bool> p(seat, true);
-        mTileChangedForSeats.push_back(p);
-    }
+    return getGameMap()->getSeatVisionPlane(seat->getIndex()).get(mX, mY);
 }
 
-bool Tile::hasChangedForSeat(Seat* seat) const
+std::vector<Seat*> Tile::getSeatsWithVision() const
 {
-    for(const std::pair<Seat*, bool>& seatChanged : mTileChangedForSeats)
+    std::vector<Seat*> seats;
+    for(Seat* seat : getGameMap()->getSeats())
     {
-        if(seatChanged.first != seat)
+        if(!hasVision(seat))
             continue;
 
-        return seatChanged.second;
+        seats.push_back(seat);
     }
-    OD_LOG_ERR("tile=" + Tile::displayAsString(this) + ", unknown seat id=" + Helper::toString(seat->getId()));
-    return false;
+    return seats;
 }
 
-void Tile::changeNotifiedForSeat(Seat* seat)
+bool Tile::hasChangedForSeat(Seat* seat) const
 {
-    for(std::pair<Seat*, bool>& seatChanged : mTileChangedForSeats)
+    if(seat->getIndex() >= getGameMap()->getNbSeatPlanes())
     {
-        if(seatChanged.first != seat)
-            continue;
-
-        seatChanged.second = false;
-        break;
+        OD_LOG_ERR("tile=" + Tile::displayAsString(this) + ", unknown seat id=" + Helper::toString(seat->getId()));
+        return false;
     }
+
+    return getGameMap()->getTileChangedPlane(seat->getIndex()).get(mX, mY);
+}
+
+void Tile::changeNotifiedForSeat(Seat* seat)
+{
+    getGameMap()->setTileChangedForSeat(*this, seat->getIndex(), false);
 }
 
 void Tile::computeTileVisual()
@@ -842,41 +819,11 @@ void Tile::computeTileVisual()
 
 uint32_t Tile::getFloodFillValue(Seat* seat, FloodFillType type) const
 {
-    if(seat->getTeamIndex() >= mFloodFillColor.size())
-    {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", seatIndex=" + Helper::toString(seat->getTeamIndex()) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(mFloodFillColor.size()))
-                + ", fullness=" + Helper::toString(getFullness()));
-        }
-        return NO_FLOODFILL;
-    }
-
-    const std::vector<uint32_t>& values = mFloodFillColor[seat->getTeamIndex()];
     uint32_t intType = static_cast<uint32_t>(type);
-    if(intType >= values.size())
-    {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", intType=" + Helper::toString(intType) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(values.size())));
-        }
+    if(!checkFloodFillIndex(seat, intType))
         return NO_FLOODFILL;
-    }
-
-    return values.at(intType);
-}
 
-void Tile::setTeamsNumber(uint32_t nbTeams)
-{
-    mFloodFillColor = std::vector<std::vector<uint32_t>>(nbTeams, std::vector<uint32_t>(static_cast<uint32_t>(FloodFillType::nbValues), NO_FLOODFILL));
+    return getGameMap()->getFloodFillValue(mX, mY, seat->getTeamIndex(), intType);
 }
 
 bool Tile::shouldColorTileMesh() const
@@ -897,11 +844,18 @@ void Tile::exportToStream(Tile* tile, std::ostream& os)
     tile->exportToStream(os);
 }
 
+void Tile::setType(TileType t)
+{
+    mType = t;
+    getGameMap()->refreshTilePlanes(*this);
+}
+
 void Tile::setFullness(double f)
 {
     double oldFullness = getFullness();
 
     mFullness = f;
+    getGameMap()->refreshTilePlanes(*this);
 
     // If the tile was marked for digging and has been dug out, unmark it and set its fullness to 0.
     if (mFullness == 0.0 && isMarkedForDiggingByAnySeat())
@@ -963,12 +917,12 @@ void Tile::setCoveringBuilding(Building *building)
     // don't want to refresh tiles for traps for enemy players)
     if(mCoveringBuilding != nullptr)
     {
-        for(std::pair<Seat*, bool>& seatChanged : mTileChangedForSeats)
+        for(Seat* seat : getGameMap()->getSeats())
         {
-            if(!mCoveringBuilding->shouldSetCoveringTileDirty(seatChanged.first, this))
+            if(!mCoveringBuilding->shouldSetCoveringTileDirty(seat, this))
                 continue;
 
-            seatChanged.second = true;
+            getGameMap()->setTileChangedForSeat(*this, seat->getIndex(), true);
         }
     }
     mCoveringBuilding = building;
@@ -988,18 +942,20 @@ void Tile::setCoveringBuilding(Building *building)
 
     if(mCoveringBuilding != nullptr)
     {
-        for(std::pair<Seat*, bool>& seatChanged : mTileChangedForSeats)
+        for(Seat* seat : getGameMap()->getSeats())
         {
-            if(!mCoveringBuilding->shouldSetCoveringTileDirty(seatChanged.first, this))
+            if(!mCoveringBuilding->shouldSetCoveringTileDirty(seat, this))
                 continue;
 
-            seatChanged.second = true;
+            getGameMap()->setTileChangedForSeat(*this, seat->getIndex(), true);
         }
 
         // Set the tile as claimed and of the team color of the building
         setSeat(mCoveringBuilding->getSeat());
         mClaimedPercentage = 1.0;
     }
+
+    getGameMap()->refreshTilePlanes(*this);
 }
 
 bool Tile::isGroundClaimable(Seat* seat) const
@@ -1077,6 +1033,8 @@ void Tile::updateFromPacket(ODPacket& is)
 
     }
 
+    getGameMap()->refreshTilePlanes(*this);
+
     // We need to check if the tile is unmarked after reading the needed information.
     if(getMarkedForDigging(getGameMap()->getLocalPlayer()) &&
         !isDiggable(getGameMap()->getLocalPlayer()->getSeat()))
@@ -1163,7 +1121,7 @@ void Tile::refreshMesh()
     if(getIsOnServerMap())
         return;
 
-    RenderManager::getSingleton().rrRefreshTile(*this, *getGameMap(), *getGameMap()->getLocalPlayer());
+    RenderManager::getSingleton().rrQueueTileRefresh(*this);
 }
 
 void Tile::setSelected(bool ss, const Player* pp)
@@ -1195,6 +1153,7 @@ bool Tile::addEntity(GameEntity *entity)
     }
 
     mEntitiesInTile.push_back(entity);
+    getGameMap()->refreshTileOccupiedPlane(*this);
     if(!getGameMap()->isServerGameMap())
     {
         // On client side, we cull any movable entity that walks over a
@@ -1217,6 +1176,7 @@ void Tile::removeEntity(GameEntity *entity)
     }
 
     mEntitiesInTile.erase(it);
+    getGameMap()->refreshTileOccupiedPlane(*this);
     fireTileStateChanged();
 }
 
@@ -1231,6 +1191,8 @@ void Tile::claimForSeat(Seat* seat, double nDanceRate)
         return;
     }
 
+    bool wasClaimed = isClaimed();
+
     // Claiming walls is less efficient than claiming ground
     if(getFullness() > 0)
         nDanceRate *= ConfigManager::getSingleton().getClaimingWallPenalty();
@@ -1261,7 +1223,12 @@ void Tile::claimForSeat(Seat* seat, double nDanceRate)
         (getSeat()->isAlliedSeat(seat)))
     {
         claimTile(seat);
+        return;
     }
+
+    // The tile may have been unclaimed by an enemy
+    if(wasClaimed != isClaimed())
+        getGameMap()->refreshTilePlanes(*this);
 }
 
 void Tile::claimTile(Seat* seat)
@@ -1284,9 +1251,10 @@ void Tile::claimTile(Seat* seat)
 
     computeTileVisual();
     setDirtyForAllSeats();
+    getGameMap()->refreshTilePlanes(*this);
 
     // Force all the neighbors to recheck their meshes as we have updated this tile.
-    for (Tile* tile : mNeighbors)
+    for (Tile* tile : getAllNeighbors())
     {
         // Update potential active spots.
         Building* building = tile->getCoveringBuilding();
@@ -1311,9 +1279,10 @@ void Tile::unclaimTile()
 
     computeTileVisual();
     setDirtyForAllSeats();
+    getGameMap()->refreshTilePlanes(*this);
 
     // Force all the neighbors to recheck their meshes as we have updated this tile.
-    for (Tile* tile : mNeighbors)
+    for (Tile* tile : getAllNeighbors())
     {
         // Update potential active spots.
         Building* building = tile->getCoveringBuilding();
@@ -1374,7 +1343,7 @@ double Tile::digOut(double digRate)
         computeTileVisual();
         setDirtyForAllSeats();
 
-        for (Tile* tile : mNeighbors)
+        for (Tile* tile : getAllNeighbors())
         {
             // Update potential active spots.
             Building* building = tile->getCoveringBuilding();
@@ -1722,7 +1691,7 @@ void Tile::computeVisibleTiles()
 
     // A claimed tile can see it self and its neighboors
     notifyVision(getSeat());
-    for(Tile* tile : mNeighbors)
+    for(Tile* tile : getAllNeighbors())
     {
         tile->notifyVision(getSeat());
     }
@@ -1733,15 +1702,18 @@ void Tile::setDirtyForAllSeats()
     if(!getIsOnServerMap())
         return;
 
-    for(std::pair<Seat*, bool>& seatChanged : mTileChangedForSeats)
-        seatChanged.second = true;
+    getGameMap()->setTileChangedForAllSeats(*this);
 }
 
 void Tile::notifyEntitiesSeatsWithVision()
 {
+    if(mEntitiesInTile.empty())
+        return;
+
+    std::vector<Seat*> seats = getSeatsWithVision();
     for(GameEntity* entity : mEntitiesInTile)
     {
-        entity->notifySeatsWithVision(mSeatsWithVision);
+        entity->notifySeatsWithVision(seats);
     }
 }
 
@@ -1872,28 +1844,16 @@ void Tile::canWorkerDig(const Creature& worker, std::vector<Tile*>& tiles)
         return;
     }
 
-    for(uint32_t i = 0; i < mNeighbors.size(); ++i)
+    TileNeighbors neighbors = getAllNeighbors();
+    for(uint32_t i = 0; i < neighbors.size(); ++i)
     {
-        Tile* neigh = mNeighbors[i];
+        Tile* neigh = neighbors[i];
         if(neigh->isFullTile())
             continue;
 
         if(!getGameMap()->pathExists(&worker, myTile, neigh))
             continue;
 
-        if(i >= mNbWorkersDigging.size())
-        {
-            static bool log = true;
-            if(log)
-            {
-                log = false;
-                OD_LOG_ERR("worker=" + worker.getName() + ", myTile=" + Tile::displayAsString(myTile)
-                    + ", neigh=" + Tile::displayAsString(neigh) + ", i=" + Helper::toString(i)
-                    + ", size=" + Helper::toString(mNbWorkersDigging.size()));
-            }
-            continue;
-        }
-
         if(mNbWorkersDigging[i] >= ConfigManager::getSingleton().getNbWorkersDigSameFaceTile())
             continue;
 
@@ -1903,24 +1863,11 @@ void Tile::canWorkerDig(const Creature& worker, std::vector<Tile*>& tiles)
 
 bool Tile::addWorkerDigging(const Creature& worker, Tile& tile)
 {
-    for(uint32_t i = 0; i < mNeighbors.size(); ++i)
+    TileNeighbors neighbors = getAllNeighbors();
+    for(uint32_t i = 0; i < neighbors.size(); ++i)
     {
-        Tile* neigh = mNeighbors[i];
-        if(neigh != &tile)
-            continue;
-
-        if(i >= mNbWorkersDigging.size())
-        {
-            static bool log = true;
-            if(log)
-            {
-                log = false;
-                OD_LOG_ERR("worker=" + worker.getName() + ", tile=" + Tile::displayAsString(&tile)
-                    + ", neigh=" + Tile::displayAsString(neigh) + ", i=" + Helper::toString(i)
-                    + ", size=" + Helper::toString(mNbWorkersDigging.size()));
-            }
+        if(neighbors[i] != &tile)
             continue;
-        }
 
         ++mNbWorkersDigging[i];
         return true;
@@ -1932,24 +1879,11 @@ bool Tile::addWorkerDigging(const Creature& worker, Tile& tile)
 bool Tile::removeWorkerDigging(const Creature& worker, Tile& tile)
 {
     // Sanity check
-    for(uint32_t i = 0; i < mNeighbors.size(); ++i)
+    TileNeighbors neighbors = getAllNeighbors();
+    for(uint32_t i = 0; i < neighbors.size(); ++i)
     {
-        Tile* neigh = mNeighbors[i];
-        if(neigh != &tile)
-            continue;
-
-        if(i >= mNbWorkersDigging.size())
-        {
-            static bool log = true;
-            if(log)
-            {
-                log = false;
-                OD_LOG_ERR("worker=" + worker.getName() + ", tile=" + Tile::displayAsString(&tile)
-                    + ", neigh=" + Tile::displayAsString(neigh) + ", i=" + Helper::toString(i)
-                    + ", size=" + Helper::toString(mNbWorkersDigging.size()));
-            }
+        if(neighbors[i] != &tile)
             continue;
-        }
 
         --mNbWorkersDigging[i];
         return true;
@@ -1981,23 +1915,31 @@ void Tile::setTileCullingFlags(uint32_t mask, bool value)
 
 bool Tile::addTileStateListener(TileStateListener& listener)
 {
-    mStateListeners.push_back(&listener);
+    getSparseData().mStateListeners.push_back(&listener);
     return true;
 }
 
 bool Tile::removeTileStateListener(TileStateListener& listener)
 {
-    auto it = std::find(mStateListeners.begin(), mStateListeners.end(), &listener);
-    if(it == mStateListeners.end())
+    if(mSparseData == nullptr)
         return false;
 
-    mStateListeners.erase(it);
+    std::vector<TileStateListener*>& listeners = mSparseData->mStateListeners;
+    auto it = std::find(listeners.begin(), listeners.end(), &listener);
+    if(it == listeners.end())
+        return false;
+
+    listeners.erase(it);
+    releaseSparseDataIfUnused();
     return true;
 }
 
 void Tile::fireTileStateChanged()
 {
-    for(TileStateListener* stateListener : mStateListeners)
+    if(mSparseData == nullptr)
+        return;
+
+    for(TileStateListener* stateListener : mSparseData->mStateListeners)
         stateListener->tileStateChanged(*this);
 }
 
@@ -19,6 +19,7 @@
 #define TILE_H
 
 #include "entities/GameEntity.h"
+#include "gamemap/TileNeighbors.h"
 
 #include <OgreVector3.h>
 
@@ -26,6 +27,7 @@
 #include <vector>
 #include <iosfwd>
 #include <cstdint>
+#include <memory>
 
 class Building;
 class Creature;
@@ -75,8 +77,9 @@ std::ostream& operator<<(std::ostream& os, const TileType& type);
 std::istream& operator>>(std::istream& is, TileType& type);
 
 
-//! Different representations a tile can have (ground or full)
-enum class TileVisual
+//! Different representations a tile can have (ground or full). It is stored for every tile and
+//! every human seat (see TileStateNotified) so it is kept on one byte
+enum class TileVisual : uint8_t
 {
     nullTileVisual = 0,
     dirtGround,
@@ -172,8 +175,7 @@ public:
      * In addition to setting the tile type this function also reloads the new mesh
      * for the tile.
      */
-    inline void setType(TileType t)
-    { mType = t; }
+    void setType(TileType t);
 
     //! \brief Returns the tile type (rock, claimed, etc.).
     inline TileType getType() const
@@ -214,7 +216,7 @@ public:
      */
     static int nextTileFullness(int f);
 
-    //! \brief This function puts a message in the renderQueue to change the mesh for this tile.
+    //! \brief Queues the refresh of the mesh of this tile. It will be done with the next rendered frame.
     void refreshMesh();
 
     //! \brief Marks the tile as being selected through a mouse click or drag.
@@ -264,10 +266,11 @@ public:
     const std::vector<GameEntity*>& getEntitiesInTile() const
     { return mEntitiesInTile; }
 
-    void addNeighbor(Tile *n);
-    Tile* getNeighbor(unsigned index);
-    const std::vector<Tile*>& getAllNeighbors() const
-    { return mNeighbors; }
+    //! \brief Returns the tiles sharing a side with this one (see TileContainer::getTileNeighbors)
+    TileNeighbors getAllNeighbors() const;
+
+    //! \brief Approximate number of bytes used by the tile, including what it allocates
+    uint64_t getMemoryUsage() const;
 
     void claimForSeat(Seat* seat, double nDanceRate);
     void claimTile(Seat* seat);
@@ -368,19 +371,19 @@ public:
 
     //! \brief Computes the visible tiles and tags them to know which are visible
     void computeVisibleTiles();
-    void clearVision();
     void notifyVision(Seat* seat);
 
-    void setSeats(const std::vector<Seat*>& seats);
+    //! \brief Returns true if the given seat has vision on this tile during the current turn
+    bool hasVision(const Seat* seat) const;
+
     bool hasChangedForSeat(Seat* seat) const;
     void changeNotifiedForSeat(Seat* seat);
 
     void notifyEntitiesSeatsWithVision();
 
-    const std::vector<Seat*>& getSeatsWithVision()
-    { return mSeatsWithVision; }
-
-    void resetFloodFill();
+    //! \brief Returns the seats having vision on this tile during the current turn. Vision is
+    //! stored per seat in the gamemap (see TileContainer::getSeatVisionPlane)
+    std::vector<Seat*> getSeatsWithVision() const;
 
     static std::string toString(FloodFillType type);
 
@@ -413,9 +416,6 @@ public:
     //! server and client
     bool isFullTile() const;
 
-    //! Sets the number of teams in this gamemap (after seat configuration). This number includes the rogue team.
-    void setTeamsNumber(uint32_t nbTeams);
-
     //! \brief returns true if the mesh from the tileset should be displayed and false otherwise
     inline bool shouldDisplayTileMesh() const
     { return mDisplayTileMesh; }
@@ -505,17 +505,19 @@ private:
     uint32_t mRefundPriceRoom;
     uint32_t mRefundPriceTrap;
 
-    std::vector<Tile*> mNeighbors;
-    std::vector<const Player*> mPlayersMarkingTile;
-    std::vector<std::pair<Seat*, bool>> mTileChangedForSeats;
-    std::vector<Seat*> mSeatsWithVision;
+    //! \brief Data most tiles never use. It is only allocated while one of the vectors is not empty
+    //! so that large maps do not pay for empty vectors in every tile
+    struct SparseData
+    {
+        std::vector<const Player*> mPlayersMarkingTile;
+        std::vector<TileStateListener*> mStateListeners;
+    };
+    std::unique_ptr<SparseData> mSparseData;
 
     //! \brief List of the entities actually on this tile. Most of the creatures actions will rely on this list
     std::vector<GameEntity*> mEntitiesInTile;
 
     Building* mCoveringBuilding;
-    //! Floodfill values per seat and per floodfill type
-    std::vector<std::vector<uint32_t>> mFloodFillColor;
 
     //! \brief The tile claiming. Used on server side only
     double mClaimedPercentage;
@@ -545,11 +547,19 @@ private:
 
     void setDirtyForAllSeats();
 
-    //! \brief Vector with the number of workers digging the tile. The index corresponds
-    //! to the index in mNeighbors
-    std::vector<uint32_t> mNbWorkersDigging;
+    //! \brief Returns true if floodfill values exist for the given seat team and floodfill type. Logs
+    //! an error (once) if not
+    bool checkFloodFillIndex(const Seat* seat, uint32_t intType) const;
+
+    //! \brief Number of workers digging the tile from each side. The index corresponds
+    //! to the index in getAllNeighbors()
+    std::array<uint16_t, TileNeighbors::MAX_NEIGHBORS> mNbWorkersDigging;
     uint32_t mNbWorkersClaiming;
-    std::vector<TileStateListener*> mStateListeners;
+
+    //! \brief Returns mSparseData, allocating it if needed
+    SparseData& getSparseData();
+    //! \brief Releases mSparseData if it is not used anymore
+    void releaseSparseDataIfUnused();
 
     void fireTileStateChanged();
 };
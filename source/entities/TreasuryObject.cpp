@@ -25,10 +25,26 @@
 #include "rooms/Room.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/ObjectPool.h"
 
 #include <istream>
 #include <ostream>
 
+namespace
+{
+ObjectPool sTreasuryObjectPool("TreasuryObject", sizeof(TreasuryObject));
+} // namespace <none>
+
+void* TreasuryObject::operator new(std::size_t size)
+{
+    return sTreasuryObjectPool.allocate(size);
+}
+
+void TreasuryObject::operator delete(void* ptr, std::size_t size)
+{
+    sTreasuryObjectPool.release(ptr, size);
+}
+
 TreasuryObject::TreasuryObject(GameMap* gameMap, int goldValue) :
     RenderedMovableEntity(gameMap, "Treasury_", getMeshNameForGold(goldValue), 0.0f, false),
     mGoldValue(goldValue),
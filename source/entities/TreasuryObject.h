@@ -20,6 +20,7 @@
 
 #include "entities/RenderedMovableEntity.h"
 
+#include <cstddef>
 #include <string>
 #include <iosfwd>
 
@@ -34,6 +35,10 @@ public:
     TreasuryObject(GameMap* gameMap, int goldValue);
     TreasuryObject(GameMap* gameMap);
 
+    //! \brief Treasury objects are allocated from a pool (see ObjectPool)
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     virtual void doUpkeep() override;
 
     virtual GameEntityType getObjectType() const override;
@@ -19,6 +19,7 @@
 
 #include "ai/KeeperAIType.h"
 #include "entities/Building.h"
+#include "entities/Creature.h"
 #include "entities/CreatureDefinition.h"
 #include "entities/GameEntityType.h"
 #include "entities/Tile.h"
@@ -43,6 +44,7 @@
 #include "utils/LogManager.h"
 #include "utils/Random.h"
 
+#include <algorithm>
 #include <istream>
 #include <ostream>
 
@@ -57,12 +59,12 @@ const int32_t Seat::PLAYER_ID_HUMAN_MIN = static_cast<int32_t>(KeeperAIType::nbA
 
 
 TileStateNotified::TileStateNotified():
-    mTileVisual(TileVisual::nullTileVisual),
+    mBuilding(nullptr),
     mSeatIdOwner(-1),
+    mTileVisual(TileVisual::nullTileVisual),
     mMarkedForDigging(false),
     mVisionTurnLast(false),
-    mVisionTurnCurrent(false),
-    mBuilding(nullptr)
+    mVisionTurnCurrent(false)
 {
 }
 
@@ -71,8 +73,12 @@ Seat::Seat(GameMap* gameMap) :
     mGameMap(gameMap),
     mPlayer(nullptr),
     mGoldMined(0),
+    mPendingGoalEvents(Goal::EventAll),
+    mGoalsStringDirty(true),
+    mGoalsStringWinner(false),
     mDefaultWorkerClass(nullptr),
     mTeamIndex(0),
+    mIndex(0),
     mIsDebuggingVision(false),
     mSkillPoints(0),
     mCurrentSkill(nullptr),
@@ -80,13 +86,19 @@ Seat::Seat(GameMap* gameMap) :
     mConfigPlayerId(-1),
     mConfigTeamId(-1),
     mConfigFactionIndex(-1),
-    mKoCreatures(false)
+    mKoCreatures(false),
+    mWorkerJobBoard(gameMap, this),
+    mLedgerNbWorkers(0),
+    mLedgerNbFighters(0),
+    mLedgerNbRooms(static_cast<uint32_t>(RoomType::nbRooms), 0)
 {
 }
 
 void Seat::addGoal(Goal* g)
 {
     mUncompleteGoals.push_back(g);
+    mPendingGoalEvents = Goal::EventAll;
+    mGoalsStringDirty = true;
 }
 
 unsigned int Seat::numUncompleteGoals()
@@ -107,11 +119,19 @@ Goal* Seat::getUncompleteGoal(unsigned int index)
 void Seat::clearUncompleteGoals()
 {
     mUncompleteGoals.clear();
+    mGoalsStringDirty = true;
 }
 
 void Seat::clearCompletedGoals()
 {
     mCompletedGoals.clear();
+    mGoalsStringDirty = true;
+}
+
+void Seat::addGoldMined(int quantity)
+{
+    mGoldMined += quantity;
+    notifyGoalEvent(Goal::EventGoldMined);
 }
 
 unsigned int Seat::numCompletedGoals()
@@ -146,6 +166,13 @@ unsigned int Seat::checkAllCompletedGoals()
     std::vector<Goal*>::iterator currentGoal = mCompletedGoals.begin();
     while (currentGoal != mCompletedGoals.end())
     {
+        // Goals only need to be checked again if something they depend on happened
+        if (((*currentGoal)->getDependencies() & mPendingGoalEvents) == 0)
+        {
+            ++currentGoal;
+            continue;
+        }
+
         // Start by checking if this previously met goal has now been unmet.
         if ((*currentGoal)->isUnmet(*this, *mGameMap))
         {
@@ -509,6 +536,17 @@ void Seat::setMapSize(int x, int y)
     }
 }
 
+uint64_t Seat::getTilesStatesMemoryUsage() const
+{
+    uint64_t bytes = mTilesStates.capacity() * sizeof(std::vector<TileStateNotified>);
+    for(const std::vector<TileStateNotified>& vec : mTilesStates)
+        bytes += vec.capacity() * sizeof(TileStateNotified);
+
+    // Map nodes also hold 3 pointers and a color
+    bytes += mTilesStateLoaded.size() * (sizeof(std::pair<const std::pair<int, int>, TileStateNotified>) + 4 * sizeof(void*));
+    return bytes;
+}
+
 unsigned int Seat::checkAllGoals()
 {
     // Loop over the goals vector and move any goals that have been met to the completed goals vector.
@@ -517,6 +555,13 @@ unsigned int Seat::checkAllGoals()
     while (currentGoal != mUncompleteGoals.end())
     {
         Goal* goal = *currentGoal;
+        // Goals only need to be checked again if something they depend on happened
+        if ((goal->getDependencies() & mPendingGoalEvents) == 0)
+        {
+            ++currentGoal;
+            continue;
+        }
+
         // Start by checking if the goal has been met by this seat.
         if (goal->isMet(*this, *mGameMap))
         {
@@ -592,37 +637,45 @@ unsigned int Seat::checkAllGoals()
         mUncompleteGoals.push_back(goal);
     }
 
+    // If goals have been evaluated, their description may have changed. New subgoals have not been
+    // evaluated yet so we make sure they will be at next check
+    if(mPendingGoalEvents != 0)
+        mGoalsStringDirty = true;
+
+    mPendingGoalEvents = goalsToAdd.empty() ? 0 : Goal::EventAll;
+
     return numUncompleteGoals();
 }
 
 void Seat::notifyChangedVisibleTiles()
 {
-    if(mPlayer == nullptr)
+    ServerNotification* serverNotification = buildChangedVisibleTilesNotification();
+    applyBuildingVisionChanges();
+    if(serverNotification == nullptr)
         return;
+
+    ODServer::getSingleton().queueServerNotification(serverNotification);
+}
+
+ServerNotification* Seat::buildChangedVisibleTilesNotification()
+{
+    if(mPlayer == nullptr)
+        return nullptr;
     if(!mPlayer->getIsHuman())
-        return;
+        return nullptr;
 
+    // The tiles to send are the ones we have vision on that changed since the last time they were sent
     std::vector<Tile*> tilesToNotify;
-    int xMax = static_cast<int>(mTilesStates.size());
-    for(int xxx = 0; xxx < xMax; ++xxx)
+    const TileBitPlane& visionPlane = mGameMap->getSeatVisionPlane(mIndex);
+    visionPlane.forEachSetIntersection(mGameMap->getTileChangedPlane(mIndex), [&](int xxx, int yyy)
     {
-        int yMax = static_cast<int>(mTilesStates[xxx].size());
-        for(int yyy = 0; yyy < yMax; ++yyy)
-        {
-            if(!mTilesStates[xxx][yyy].mVisionTurnCurrent)
-                continue;
-
-            Tile* tile = mGameMap->getTile(xxx, yyy);
-            if(!tile->hasChangedForSeat(this))
-                continue;
-
-            tilesToNotify.push_back(tile);
-            tile->changeNotifiedForSeat(this);
-        }
-    }
+        Tile* tile = mGameMap->getTile(xxx, yyy);
+        tilesToNotify.push_back(tile);
+        tile->changeNotifiedForSeat(this);
+    });
 
     if(tilesToNotify.empty())
-        return;
+        return nullptr;
 
     uint32_t nbTiles = tilesToNotify.size();
     ServerNotification *serverNotification = new ServerNotification(
@@ -631,10 +684,18 @@ void Seat::notifyChangedVisibleTiles()
     for(Tile* tile : tilesToNotify)
     {
         mGameMap->tileToPacket(serverNotification->mPacket, tile);
-        updateTileStateForSeat(tile, false);
+        updateTileState(tile, false, true);
         tile->exportToPacketForUpdate(serverNotification->mPacket, this);
     }
-    ODServer::getSingleton().queueServerNotification(serverNotification);
+    return serverNotification;
+}
+
+void Seat::applyBuildingVisionChanges()
+{
+    for(const std::pair<Building*, Tile*>& change : mBuildingVisionChanges)
+        change.first->notifySeatVision(change.second, this);
+
+    mBuildingVisionChanges.clear();
 }
 
 void Seat::stopVisualDebugEntities()
@@ -746,14 +807,23 @@ void Seat::refreshSeatVisualDebug()
 
 void Seat::sendVisibleTiles()
 {
-    if(!mGameMap->isServerGameMap())
+    ServerNotification* serverNotification = buildVisibleTilesNotification();
+    if(serverNotification == nullptr)
         return;
 
+    ODServer::getSingleton().queueServerNotification(serverNotification);
+}
+
+ServerNotification* Seat::buildVisibleTilesNotification()
+{
+    if(!mGameMap->isServerGameMap())
+        return nullptr;
+
     if(getPlayer() == nullptr)
-        return;
+        return nullptr;
 
     if(!getPlayer()->getIsHuman())
-        return;
+        return nullptr;
 
     uint32_t nbTiles;
     ServerNotification *serverNotification = new ServerNotification(
@@ -799,31 +869,72 @@ void Seat::sendVisibleTiles()
     {
         mGameMap->tileToPacket(serverNotification->mPacket, tile);
     }
-    ODServer::getSingleton().queueServerNotification(serverNotification);
+    return serverNotification;
 }
 
 void Seat::computeSeatBeginTurn()
 {
     if(mPlayer != nullptr)
+        mNbRooms = mLedgerNbRooms;
+}
+
+void Seat::addCreatureToLedger(const Creature& creature)
+{
+    if(creature.getDefinition()->isWorker())
+        ++mLedgerNbWorkers;
+    else
+        ++mLedgerNbFighters;
+}
+
+void Seat::removeCreatureFromLedger(const Creature& creature)
+{
+    uint32_t& nb = creature.getDefinition()->isWorker() ? mLedgerNbWorkers : mLedgerNbFighters;
+    if(nb == 0)
     {
-        std::fill(mNbRooms.begin(), mNbRooms.end(), 0);
-        for(Room* room : mGameMap->getRooms())
-        {
-            if(room->getSeat() != this)
-                continue;
+        OD_LOG_ERR("seatId=" + Helper::toString(getId()) + ", creature=" + creature.getName());
+        return;
+    }
+    --nb;
+}
 
-            if(room->getHP(nullptr) <= 0.0)
-                continue;
+void Seat::addRoomToLedger(Room* room)
+{
+    uint32_t index = static_cast<uint32_t>(room->getType());
+    if(index >= mLedgerNbRooms.size())
+    {
+        OD_LOG_ERR("wrong index=" + Helper::toString(index) + ", size=" + Helper::toString(mLedgerNbRooms.size()));
+        return;
+    }
 
-            uint32_t index = static_cast<uint32_t>(room->getType());
-            if(index >= mNbRooms.size())
-            {
-                OD_LOG_ERR("wrong index=" + Helper::toString(index) + ", size=" + Helper::toString(mNbRooms.size()));
-                return;
-            }
-            ++mNbRooms[index];
-        }
+    mLedgerRooms.push_back(room);
+    ++mLedgerNbRooms[index];
+    mGameMap->notifyGoalEvent(Goal::EventRooms);
+}
+
+void Seat::removeRoomFromLedger(Room* room)
+{
+    auto it = std::find(mLedgerRooms.begin(), mLedgerRooms.end(), room);
+    if(it == mLedgerRooms.end())
+    {
+        OD_LOG_ERR("seatId=" + Helper::toString(getId()) + ", room=" + room->getName());
+        return;
+    }
+
+    mLedgerRooms.erase(it);
+    --mLedgerNbRooms[static_cast<uint32_t>(room->getType())];
+    mGameMap->notifyGoalEvent(Goal::EventRooms);
+}
+
+uint32_t Seat::getLedgerNbRooms(RoomType type) const
+{
+    uint32_t index = static_cast<uint32_t>(type);
+    if(index >= mLedgerNbRooms.size())
+    {
+        OD_LOG_ERR("wrong index=" + Helper::toString(index) + ", size=" + Helper::toString(mLedgerNbRooms.size()));
+        return 0;
     }
+
+    return mLedgerNbRooms[index];
 }
 
 
@@ -1536,6 +1647,11 @@ void Seat::setSkillTree(const std::vector<SkillType>& skills)
 }
 
 void Seat::updateTileStateForSeat(Tile* tile, bool hideSeatId)
+{
+    updateTileState(tile, hideSeatId, false);
+}
+
+void Seat::updateTileState(Tile* tile, bool hideSeatId, bool deferBuildingVision)
 {
     if(tile->getX() >= static_cast<int>(mTilesStates.size()))
     {
@@ -1588,14 +1704,24 @@ void Seat::updateTileStateForSeat(Tile* tile, bool hideSeatId)
     // If we are hiding seat id, we do not notify the building about vision
     // so that it doesn't send the building seat id
     if((tileState.mBuilding != nullptr) && !hideSeatId)
-        tileState.mBuilding->notifySeatVision(tile, this);
+    {
+        if(deferBuildingVision)
+            mBuildingVisionChanges.push_back(std::make_pair(tileState.mBuilding, tile));
+        else
+            tileState.mBuilding->notifySeatVision(tile, this);
+    }
 
     if((tile->getCoveringBuilding() != nullptr) &&
         (tile->getCoveringBuilding()->isTileVisibleForSeat(tile, this)))
     {
         tileState.mBuilding = tile->getCoveringBuilding();
         if(!hideSeatId)
-            tileState.mBuilding->notifySeatVision(tile, this);
+        {
+            if(deferBuildingVision)
+                mBuildingVisionChanges.push_back(std::make_pair(tileState.mBuilding, tile));
+            else
+                tileState.mBuilding->notifySeatVision(tile, this);
+        }
     }
     else
     {
@@ -19,30 +19,35 @@
 #define SEAT_H
 
 #include "game/SeatData.h"
+#include "game/WorkerJobBoard.h"
 
 #include <OgreVector3.h>
 #include <OgreColourValue.h>
 #include <string>
+#include <utility>
 #include <vector>
 #include <iosfwd>
 #include <cstdint>
 
 class Building;
 class ConfigManager;
+class Creature;
 class Goal;
 class ODPacket;
 class GameMap;
 class CreatureDefinition;
 class Player;
+class Room;
 class Skill;
 class Seat;
+class ServerNotification;
 class Tile;
 
 enum class KeeperAIType;
 enum class RoomType;
 enum class SkillType;
 enum class SpellType;
-enum class TileVisual;
+enum class TileVisual : uint8_t;
 enum class TrapType;
 
 //! Class used to save the last tile state notified to each seat
@@ -51,12 +56,14 @@ class TileStateNotified
 public:
     TileStateNotified();
 
-    TileVisual mTileVisual;
+    // Members are ordered from the biggest to the smallest to avoid padding. One is stored
+    // for every tile and every human seat
+    Building* mBuilding;
     int mSeatIdOwner;
+    TileVisual mTileVisual;
     bool mMarkedForDigging;
     bool mVisionTurnLast;
     bool mVisionTurnCurrent;
-    Building* mBuilding;
 };
 
 class Seat : public SeatData
@@ -120,6 +127,11 @@ public:
     inline void resetGoalsChanged()
     { mHasGoalsChanged = false; }
 
+    //! \brief Notifies that the given events (Goal::Event* bitmask) happened. Goals depending on
+    //! them will be evaluated at the next check. Used on server side only
+    inline void notifyGoalEvent(uint32_t events)
+    { mPendingGoalEvents |= events; }
+
     inline bool isRogueSeat() const
     { return mId == 0; }
 
@@ -129,6 +141,12 @@ public:
     inline void setTeamIndex(uint32_t index)
     { mTeamIndex = index; }
 
+    inline uint32_t getIndex() const
+    { return mIndex; }
+
+    inline void setIndex(uint32_t index)
+    { mIndex = index; }
+
     inline int32_t getConfigPlayerId() const
     { return mConfigPlayerId; }
 
@@ -159,13 +177,15 @@ public:
     inline bool getKoCreatures() const
     { return mKoCreatures; }
 
+    inline WorkerJobBoard& getWorkerJobBoard()
+    { return mWorkerJobBoard; }
+
     bool takeMana(double mana);
 
     inline Ogre::Vector3 getStartingPosition() const
     { return Ogre::Vector3(static_cast<Ogre::Real>(mStartingX), static_cast<Ogre::Real>(mStartingY), 0); }
 
-    inline void addGoldMined(int quantity)
-    { mGoldMined += quantity; }
+    void addGoldMined(int quantity);
 
     inline bool getIsDebuggingVision()
     { return mIsDebuggingVision; }
@@ -184,6 +204,9 @@ public:
 
     void setMapSize(int x, int y);
 
+    //! \brief Approximate number of bytes used to remember the tile states notified to this seat
+    uint64_t getTilesStatesMemoryUsage() const;
+
     //! \brief Returns the next fighter creature class to spawn.
     const CreatureDefinition* getNextFighterClassToSpawn(const GameMap& gameMap, const ConfigManager& configManager );
 
@@ -211,6 +234,16 @@ public:
     //! the players if yes
     void notifyChangedVisibleTiles();
 
+    //! \brief Builds the notification sent by notifyChangedVisibleTiles without queuing it. Returns
+    //! nullptr if there is nothing to send. It can be called for several seats at the same time: it only
+    //! writes the seat own tile states and changed tiles plane. The buildings that got or lost vision from
+    //! this seat are not notified. They are kept until applyBuildingVisionChanges is called
+    ServerNotification* buildChangedVisibleTilesNotification();
+
+    //! \brief Notifies the buildings of the vision changes found by buildChangedVisibleTilesNotification.
+    //! Buildings are shared by every seat so it must not be called while other seats are processed
+    void applyBuildingVisionChanges();
+
     //! \brief Server side to toggle the tiles this seat has vision on
     void toggleSeatVisualDebug();
     void refreshSeatVisualDebug();
@@ -218,6 +251,11 @@ public:
     //! Sends a message to the player on this seat to refresh the list of tiles he has vision on
     void sendVisibleTiles();
 
+    //! \brief Builds the notification sent by sendVisibleTiles without queuing it. Returns nullptr if
+    //! the seat is not played by a human. Like buildChangedVisibleTilesNotification, it can be called for
+    //! several seats at the same time
+    ServerNotification* buildVisibleTilesNotification();
+
     //! \brief Client side to display the tile this seat has vision on
     void refreshVisualDebugEntities(const std::vector<Tile*>& tiles);
     void stopVisualDebugEntities();
@@ -227,6 +265,27 @@ public:
 
     void computeSeatBeginTurn();
 
+    //! \brief Server side ledger of the seat aggregates needed at each turn upkeep. It is kept up
+    //! to date when creatures and rooms are added to/removed from the gamemap, change seat or when
+    //! creatures die so that the upkeep does not need to go through every creature and room of the
+    //! map for each seat. Creatures are counted while they are alive
+    void addCreatureToLedger(const Creature& creature);
+    void removeCreatureFromLedger(const Creature& creature);
+    void addRoomToLedger(Room* room);
+    void removeRoomFromLedger(Room* room);
+
+    inline uint32_t getLedgerNbWorkers() const
+    { return mLedgerNbWorkers; }
+
+    inline uint32_t getLedgerNbFighters() const
+    { return mLedgerNbFighters; }
+
+    //! \brief Rooms owned by this seat
+    inline const std::vector<Room*>& getLedgerRooms() const
+    { return mLedgerRooms; }
+
+    uint32_t getLedgerNbRooms(RoomType type) const;
+
     //! \brief Gets whether a skill is being done
     bool isSkilling() const
     { return mCurrentSkill != nullptr; }
@@ -345,6 +404,15 @@ private:
     //! \brief Currently failed goals which cannot possibly be met in the future.
     std::vector<Goal*> mFailedGoals;
 
+    //! \brief Events (Goal::Event* bitmask) that happened since the goals were last checked
+    uint32_t mPendingGoalEvents;
+
+    //! \brief Goals description as sent to the player. It is only built again when the goals
+    //! may have changed
+    std::string mGoalsString;
+    bool mGoalsStringDirty;
+    bool mGoalsStringWinner;
+
     //! \brief Contains all the seats allied with the current one, not including it. Used on server side only.
     std::vector<Seat*> mAlliedSeats;
 
@@ -361,6 +429,13 @@ private:
     //! state (last tile state notified, vision last turn for this seat, vision for current turn, ...
     std::vector<std::vector<TileStateNotified>> mTilesStates;
 
+    //! \brief Buildings to notify with Building::notifySeatVision, found by buildChangedVisibleTilesNotification
+    std::vector<std::pair<Building*, Tile*>> mBuildingVisionChanges;
+
+    //! \brief Like updateTileStateForSeat. If deferBuildingVision is true, the buildings are added to
+    //! mBuildingVisionChanges instead of being notified
+    void updateTileState(Tile* tile, bool hideSeatId, bool deferBuildingVision);
+
     std::map<std::pair<int, int>, TileStateNotified> mTilesStateLoaded;
 
     std::vector<Tile*> mVisualDebugEntityTiles;
@@ -369,6 +444,10 @@ private:
     //! and never changed after
     uint32_t mTeamIndex;
 
+    //! \brief Index of the seat in the gamemap seats (from 0 to N). It is set when the seat is added to the gamemap
+    //! and used to index the per seat tile data (see TileContainer::getTileChangedPlane)
+    uint32_t mIndex;
+
     bool mIsDebuggingVision;
 
     //! \brief Counter for skill points
@@ -395,6 +474,15 @@ private:
     //! \brief Should the creatures fight to death or ko enemy creatures
     bool mKoCreatures;
 
+    //! \brief Jobs available to the workers of this seat. Used on server side only
+    WorkerJobBoard mWorkerJobBoard;
+
+    //! \brief Ledger aggregates. Used on server side only
+    uint32_t mLedgerNbWorkers;
+    uint32_t mLedgerNbFighters;
+    std::vector<Room*> mLedgerRooms;
+    std::vector<uint32_t> mLedgerNbRooms;
+
     //! \brief Server side function. Sets mCurrentSkill to the first entry in mSkillPending. If the pending
     //! list in empty, mCurrentSkill will be set to null
     //! researchedType is the currently researched type if any (nullSkillType if none)
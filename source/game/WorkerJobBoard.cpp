@@ -0,0 +1,591 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "game/WorkerJobBoard.h"
+
+#include "creatureaction/CreatureAction.h"
+#include "entities/Building.h"
+#include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
+#include "entities/GameEntity.h"
+#include "entities/RenderedMovableEntity.h"
+#include "entities/Tile.h"
+#include "game/Player.h"
+#include "game/Seat.h"
+#include "gamemap/GameMap.h"
+#include "gamemap/Pathfinding.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <algorithm>
+
+WorkerJobBoard::WorkerJobBoard(GameMap* gameMap, Seat* seat) :
+    mGameMap(gameMap),
+    mSeat(seat),
+    mFields(static_cast<uint32_t>(WorkerJobType::nbJobTypes))
+{
+}
+
+bool WorkerJobBoard::findJob(Creature& worker, WorkerJobType type, Tile*& jobTile, Tile*& workTile)
+{
+    if(type == WorkerJobType::carry)
+    {
+        OD_LOG_ERR("worker=" + worker.getName() + ", carry jobs are given by findEntityToCarry");
+        return false;
+    }
+
+    int32_t jobIndex = giveJob(worker, type);
+    if(jobIndex < 0)
+        return false;
+
+    const std::pair<Tile*, Tile*>& job = mFields[static_cast<uint32_t>(type)].mJobs[jobIndex];
+    jobTile = job.first;
+    workTile = job.second;
+    return true;
+}
+
+GameEntity* WorkerJobBoard::findEntityToCarry(Creature& worker)
+{
+    int32_t jobIndex = giveJob(worker, WorkerJobType::carry);
+    if(jobIndex < 0)
+        return nullptr;
+
+    return mFields[static_cast<uint32_t>(WorkerJobType::carry)].mEntities[jobIndex];
+}
+
+uint64_t WorkerJobBoard::getMemoryUsage() const
+{
+    uint64_t bytes = mFields.capacity() * sizeof(JobField);
+    for(const JobField& field : mFields)
+    {
+        bytes += field.mJobs.capacity() * sizeof(std::pair<Tile*, Tile*>)
+            + field.mEntities.capacity() * sizeof(GameEntity*)
+            + field.mClosestJob.capacity() * sizeof(int32_t)
+            + field.mDistances.capacity() * sizeof(int32_t)
+            + field.mReserved.capacity() / 8
+            + field.mReservations.size() * (sizeof(const Creature*) + sizeof(uint32_t) + sizeof(void*));
+    }
+    return bytes;
+}
+
+int32_t WorkerJobBoard::giveJob(Creature& worker, WorkerJobType type)
+{
+    uint32_t typeIndex = static_cast<uint32_t>(type);
+    if(typeIndex >= mFields.size())
+    {
+        OD_LOG_ERR("worker=" + worker.getName() + ", type=" + Helper::toString(typeIndex));
+        return -1;
+    }
+
+    if(mSeat->getPlayer() == nullptr)
+        return -1;
+
+    if(worker.getPositionTile() == nullptr)
+        return -1;
+
+    JobField& field = mFields[typeIndex];
+    refreshField(type, field);
+
+    int64_t turnNumber = mGameMap->getTurnNumber();
+    if(field.mMatchTurnNumber != turnNumber)
+    {
+        field.mMatchTurnNumber = turnNumber;
+        matchWorkers(type, field);
+    }
+
+    // The job given by the matching pass
+    auto it = field.mReservations.find(&worker);
+    if(it != field.mReservations.end())
+    {
+        uint32_t jobIndex = it->second;
+        field.mReservations.erase(it);
+        if(isJobValid(worker, type, field, jobIndex))
+            return static_cast<int32_t>(jobIndex);
+    }
+
+    // The worker was not searching during the matching pass or its job cannot be done anymore.
+    // It gets the best job not reserved yet. Invalid jobs stay reserved so that they are not tried
+    // again this turn
+    while(true)
+    {
+        int32_t jobIndex = findFreeJob(worker, type, field);
+        if(jobIndex < 0)
+            return -1;
+
+        field.mReserved[jobIndex] = true;
+        if(isJobValid(worker, type, field, static_cast<uint32_t>(jobIndex)))
+            return jobIndex;
+    }
+}
+
+void WorkerJobBoard::refreshField(WorkerJobType type, JobField& field)
+{
+    int mapSizeX = mGameMap->getMapSizeX();
+    int mapSizeY = mGameMap->getMapSizeY();
+    uint32_t nbTiles = static_cast<uint32_t>(mapSizeX * mapSizeY);
+    int64_t turnNumber = mGameMap->getTurnNumber();
+    if(field.mTurnNumber == turnNumber)
+        return;
+
+    // Entities move all the time so carry jobs are listed again every turn. They are not
+    // spread on the map as there are few of them
+    if(type == WorkerJobType::carry)
+    {
+        field.mTurnNumber = turnNumber;
+        field.mJobs.clear();
+        field.mEntities.clear();
+        fillJobs(type, field);
+        return;
+    }
+
+    uint32_t tilePlanesVersion = mGameMap->getTilePlanesVersion();
+    uint32_t markedVersion = mGameMap->getMarkedForDiggingPlane(mSeat->getId()).getVersion();
+    if((field.mClosestJob.size() == nbTiles) &&
+       (field.mTilePlanesVersion == tilePlanesVersion) &&
+       (field.mMarkedVersion == markedVersion))
+    {
+        field.mTurnNumber = turnNumber;
+        return;
+    }
+
+    field.mTurnNumber = turnNumber;
+    field.mTilePlanesVersion = tilePlanesVersion;
+    field.mMarkedVersion = markedVersion;
+    field.mJobs.clear();
+    field.mClosestJob.assign(nbTiles, -1);
+    field.mDistances.assign(nbTiles, -1);
+
+    fillJobs(type, field);
+
+    // Multi source breadth first search from every work tile. Each walkable tile gets the job
+    // that can be reached with the fewest steps
+    std::vector<Tile*> queue;
+    queue.reserve(nbTiles);
+    for(uint32_t i = 0; i < field.mJobs.size(); ++i)
+    {
+        Tile* workTile = field.mJobs[i].second;
+        uint32_t index = static_cast<uint32_t>(workTile->getY() * mapSizeX + workTile->getX());
+        if(field.mClosestJob[index] >= 0)
+            continue;
+
+        field.mClosestJob[index] = static_cast<int32_t>(i);
+        field.mDistances[index] = 0;
+        queue.push_back(workTile);
+    }
+
+    for(uint32_t head = 0; head < queue.size(); ++head)
+    {
+        Tile* tile = queue[head];
+        uint32_t tileIndex = static_cast<uint32_t>(tile->getY() * mapSizeX + tile->getX());
+        int32_t jobIndex = field.mClosestJob[tileIndex];
+        int32_t distance = field.mDistances[tileIndex] + 1;
+        uint32_t floodFill = tile->getFloodFillValue(mSeat, FloodFillType::ground);
+        for(Tile* neigh : tile->getAllNeighbors())
+        {
+            uint32_t index = static_cast<uint32_t>(neigh->getY() * mapSizeX + neigh->getX());
+            if(field.mClosestJob[index] >= 0)
+                continue;
+            if(!isWalkable(neigh))
+                continue;
+            if(neigh->getFloodFillValue(mSeat, FloodFillType::ground) != floodFill)
+                continue;
+
+            field.mClosestJob[index] = jobIndex;
+            field.mDistances[index] = distance;
+            queue.push_back(neigh);
+        }
+    }
+}
+
+void WorkerJobBoard::fillJobs(WorkerJobType type, JobField& field)
+{
+    Player* player = mSeat->getPlayer();
+    switch(type)
+    {
+        case WorkerJobType::dig:
+        {
+            mGameMap->getMarkedForDiggingPlane(mSeat->getId()).forEachSet([&](int x, int y)
+            {
+                Tile* tile = mGameMap->getTile(x, y);
+                for(Tile* neigh : tile->getAllNeighbors())
+                {
+                    if(!isWalkable(neigh))
+                        continue;
+
+                    field.mJobs.push_back(std::make_pair(tile, neigh));
+                }
+            });
+            break;
+        }
+        case WorkerJobType::claimGround:
+        case WorkerJobType::claimWall:
+        {
+            // Jobs are next to ground tiles claimed by our team. A ground tile can be next to
+            // several claimed tiles but it is only listed once
+            int mapSizeX = mGameMap->getMapSizeX();
+            std::vector<bool> listed;
+            if(type == WorkerJobType::claimGround)
+                listed.assign(static_cast<uint32_t>(mapSizeX * mGameMap->getMapSizeY()), false);
+
+            std::vector<Seat*> seats = mSeat->getAlliedSeats();
+            seats.push_back(mSeat);
+            for(Seat* seat : seats)
+            {
+                mGameMap->getClaimedTilePlane(seat->getId()).forEachSet([&](int x, int y)
+                {
+                    Tile* tile = mGameMap->getTile(x, y);
+                    if(tile->isFullTile())
+                        return;
+
+                    if(type == WorkerJobType::claimWall)
+                    {
+                        if(!isWalkable(tile))
+                            return;
+
+                        for(Tile* neigh : tile->getAllNeighbors())
+                        {
+                            if(neigh->getMarkedForDigging(player))
+                                continue;
+                            if(!neigh->isWallClaimable(mSeat))
+                                continue;
+
+                            field.mJobs.push_back(std::make_pair(neigh, tile));
+                        }
+                        return;
+                    }
+
+                    if(tile->getClaimedPercentage() < 1.0)
+                        return;
+
+                    for(Tile* neigh : tile->getAllNeighbors())
+                    {
+                        if(!isWalkable(neigh))
+                            continue;
+                        if(!neigh->isGroundClaimable(mSeat))
+                            continue;
+
+                        uint32_t index = static_cast<uint32_t>(neigh->getY() * mapSizeX + neigh->getX());
+                        if(listed[index])
+                            continue;
+
+                        listed[index] = true;
+                        field.mJobs.push_back(std::make_pair(neigh, neigh));
+                    }
+                });
+            }
+            break;
+        }
+        case WorkerJobType::carry:
+        {
+            // Carryable entities are creatures (corpses and KO creatures) or rendered entities (gold,
+            // crafted traps, ...). We go through the map entity lists instead of scanning the tiles.
+            // Whether a worker can carry an entity, and how urgent it is, is checked for each worker
+            // when the jobs are given (see isCarryJobAvailable)
+            for(Creature* creature : mGameMap->getCreatures())
+                addCarryJob(creature, field);
+
+            for(RenderedMovableEntity* entity : mGameMap->getRenderedMovableEntities())
+                addCarryJob(entity, field);
+
+            break;
+        }
+        default:
+            OD_LOG_ERR("Unexpected job type=" + Helper::toString(static_cast<uint32_t>(type)));
+            break;
+    }
+}
+
+void WorkerJobBoard::matchWorkers(WorkerJobType type, JobField& field)
+{
+    field.mReserved.assign(field.mJobs.size(), false);
+    field.mReservations.clear();
+    if(field.mJobs.empty())
+        return;
+
+    struct Candidate
+    {
+        Creature* mWorker;
+        int32_t mJob;
+        int32_t mPriority;
+        int32_t mDistance;
+    };
+
+    int mapSizeX = mGameMap->getMapSizeX();
+    std::vector<Candidate> candidates;
+    for(Creature* creature : mGameMap->getCreaturesBySeat(mSeat))
+    {
+        if(!creature->getIsOnMap())
+            continue;
+        if(!creature->getDefinition()->isWorker())
+            continue;
+        if(!isSearchingJob(*creature, type))
+            continue;
+
+        Tile* tile = creature->getPositionTile();
+        if(tile == nullptr)
+            continue;
+
+        // Tile jobs use the closest job on the field. Carry jobs, and workers for which the
+        // closest job is out of reach, use the best job around
+        Candidate candidate;
+        candidate.mWorker = creature;
+        candidate.mJob = -1;
+        candidate.mDistance = 0;
+        if(type != WorkerJobType::carry)
+        {
+            uint32_t index = static_cast<uint32_t>(tile->getY() * mapSizeX + tile->getX());
+            int32_t jobIndex = field.mClosestJob[index];
+            if((jobIndex >= 0) && isJobInReach(*creature, field, static_cast<uint32_t>(jobIndex)))
+            {
+                candidate.mJob = jobIndex;
+                candidate.mDistance = field.mDistances[index];
+            }
+        }
+
+        if(candidate.mJob < 0)
+        {
+            candidate.mJob = findFreeJob(*creature, type, field);
+            if(candidate.mJob < 0)
+                continue;
+
+            candidate.mDistance = Pathfinding::squaredDistanceTile(*tile, *field.mJobs[candidate.mJob].second);
+        }
+
+        candidate.mPriority = getJobPriority(*creature, type, field, static_cast<uint32_t>(candidate.mJob));
+        candidates.push_back(candidate);
+    }
+
+    // The closest workers are served first. When their job has already been given, they get the
+    // best job still free
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b)
+    {
+        if(a.mPriority != b.mPriority)
+            return a.mPriority > b.mPriority;
+
+        return a.mDistance < b.mDistance;
+    });
+
+    for(const Candidate& candidate : candidates)
+    {
+        int32_t jobIndex = candidate.mJob;
+        if(field.mReserved[jobIndex])
+            jobIndex = findFreeJob(*candidate.mWorker, type, field);
+
+        if(jobIndex < 0)
+            continue;
+
+        field.mReserved[jobIndex] = true;
+        field.mReservations[candidate.mWorker] = static_cast<uint32_t>(jobIndex);
+    }
+}
+
+int32_t WorkerJobBoard::findFreeJob(Creature& worker, WorkerJobType type, const JobField& field) const
+{
+    Tile* myTile = worker.getPositionTile();
+    if(myTile == nullptr)
+        return -1;
+
+    int32_t bestJob = -1;
+    int32_t bestPriority = 0;
+    int bestDist = 0;
+    for(uint32_t i = 0; i < field.mJobs.size(); ++i)
+    {
+        if(field.mReserved[i])
+            continue;
+
+        int32_t priority = getJobPriority(worker, type, field, i);
+        int dist = Pathfinding::squaredDistanceTile(*myTile, *field.mJobs[i].second);
+        if(bestJob >= 0)
+        {
+            if(priority < bestPriority)
+                continue;
+            if((priority == bestPriority) && (dist >= bestDist))
+                continue;
+        }
+
+        if(!isJobInReach(worker, field, i))
+            continue;
+
+        if((type == WorkerJobType::carry) && !isCarryJobAvailable(worker, field, i))
+            continue;
+
+        bestJob = static_cast<int32_t>(i);
+        bestPriority = priority;
+        bestDist = dist;
+    }
+
+    return bestJob;
+}
+
+bool WorkerJobBoard::isJobInReach(const Creature& worker, const JobField& field, uint32_t jobIndex) const
+{
+    Tile* myTile = worker.getPositionTile();
+    Tile* workTile = field.mJobs[jobIndex].second;
+
+    // Like when searching on their own, workers only take jobs within their sight radius
+    int sightRadius = worker.getDefinition()->getSightRadius();
+    if(Pathfinding::squaredDistanceTile(*myTile, *workTile) > sightRadius * sightRadius)
+        return false;
+
+    return mGameMap->pathExists(&worker, myTile, workTile);
+}
+
+int32_t WorkerJobBoard::getJobPriority(Creature& worker, WorkerJobType type, const JobField& field, uint32_t jobIndex) const
+{
+    if(type != WorkerJobType::carry)
+        return 0;
+
+    return static_cast<int32_t>(field.mEntities[jobIndex]->getEntityCarryType(&worker));
+}
+
+bool WorkerJobBoard::isCarryJobAvailable(Creature& worker, const JobField& field, uint32_t jobIndex) const
+{
+    GameEntity* entity = field.mEntities[jobIndex];
+    if(entity->getCarryLock(worker))
+        return false;
+    if(entity->getEntityCarryType(&worker) == EntityCarryType::notCarryable)
+        return false;
+
+    // The entity is only a job if one of our buildings reachable by this worker wants it
+    Tile* tile = field.mJobs[jobIndex].first;
+    for(Building* building : mGameMap->getReachableBuildingsPerSeat(mSeat, tile, &worker))
+    {
+        if(building->hasCarryEntitySpot(entity))
+            return true;
+    }
+    return false;
+}
+
+void WorkerJobBoard::addCarryJob(GameEntity* entity, JobField& field)
+{
+    // Entities in the keeper hand are not on the map
+    if(!entity->getIsOnMap())
+        return;
+
+    Tile* tile = entity->getPositionTile();
+    if((tile == nullptr) || tile->isFullTile())
+        return;
+
+    field.mJobs.push_back(std::make_pair(tile, tile));
+    field.mEntities.push_back(entity);
+}
+
+bool WorkerJobBoard::isJobValid(Creature& worker, WorkerJobType type, const JobField& field, uint32_t jobIndex)
+{
+    Tile& jobTile = *field.mJobs[jobIndex].first;
+    Tile& workTile = *field.mJobs[jobIndex].second;
+    Player* player = mSeat->getPlayer();
+    switch(type)
+    {
+        case WorkerJobType::dig:
+        {
+            if(!jobTile.getMarkedForDigging(player))
+                return false;
+
+            // canWorkerDig checks paths and how many workers are already digging each face
+            std::vector<Tile*> tiles;
+            jobTile.canWorkerDig(worker, tiles);
+            for(Tile* tile : tiles)
+            {
+                if(tile == &workTile)
+                    return true;
+            }
+            return false;
+        }
+        case WorkerJobType::claimWall:
+        {
+            if(jobTile.getMarkedForDigging(player))
+                return false;
+            if(!jobTile.isWallClaimable(mSeat))
+                return false;
+            if(!jobTile.canWorkerClaim(worker))
+                return false;
+
+            return mGameMap->pathExists(&worker, worker.getPositionTile(), &workTile);
+        }
+        case WorkerJobType::claimGround:
+        {
+            if(!jobTile.isGroundClaimable(mSeat))
+                return false;
+            if(!jobTile.canWorkerClaim(worker))
+                return false;
+            if(!mGameMap->pathExists(&worker, worker.getPositionTile(), &workTile))
+                return false;
+
+            for(Tile* neigh : jobTile.getAllNeighbors())
+            {
+                if(neigh->isFullTile())
+                    continue;
+                if(!neigh->isClaimedForSeat(mSeat))
+                    continue;
+                if(neigh->getClaimedPercentage() < 1.0)
+                    continue;
+
+                return true;
+            }
+            return false;
+        }
+        case WorkerJobType::carry:
+        {
+            // The entity may have been picked up, moved or taken by another creature since the
+            // jobs were listed
+            GameEntity* entity = field.mEntities[jobIndex];
+            if(!entity->getIsOnMap())
+                return false;
+            if(entity->getCarryLock(worker))
+                return false;
+            if(entity->getPositionTile() != &jobTile)
+                return false;
+            if(entity->getEntityCarryType(&worker) == EntityCarryType::notCarryable)
+                return false;
+
+            return mGameMap->pathExists(&worker, worker.getPositionTile(), &jobTile);
+        }
+        default:
+            return false;
+    }
+}
+
+bool WorkerJobBoard::isWalkable(Tile* tile) const
+{
+    if(tile->isFullTile())
+        return false;
+
+    return tile->getFloodFillValue(mSeat, FloodFillType::ground) != Tile::NO_FLOODFILL;
+}
+
+bool WorkerJobBoard::isSearchingJob(const Creature& worker, WorkerJobType type)
+{
+    const std::vector<std::unique_ptr<CreatureAction>>& actions = worker.getActions();
+    if(actions.empty())
+        return false;
+
+    CreatureActionType actionType = actions.back()->getType();
+    switch(type)
+    {
+        case WorkerJobType::dig:
+            return actionType == CreatureActionType::searchTileToDig;
+        case WorkerJobType::claimGround:
+            return actionType == CreatureActionType::searchGroundTileToClaim;
+        case WorkerJobType::claimWall:
+            return actionType == CreatureActionType::searchWallTileToClaim;
+        case WorkerJobType::carry:
+            return actionType == CreatureActionType::searchEntityToCarry;
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,149 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WORKERJOBBOARD_H
+#define WORKERJOBBOARD_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Creature;
+class GameEntity;
+class GameMap;
+class Seat;
+class Tile;
+
+enum class WorkerJobType
+{
+    dig,
+    claimGround,
+    claimWall,
+    carry,
+    nbJobTypes
+};
+
+//! \brief Server side list of the jobs available to the workers of a seat (tiles to dig, ground
+//! and walls to claim, entities to carry). Instead of having each worker scanning every tile within
+//! its sight radius and checking paths to each of them, the board lists the jobs once for every job
+//! type. For tile jobs, a single multi source breadth first search from the tiles where the jobs can
+//! be done gives the closest job for every tile reachable by the workers.
+//! Once per turn, on the first request for a job type, a matching pass gives a job to every worker
+//! currently searching for this job type. Workers are served closest first and each job is reserved
+//! for one worker so that workers do not converge on the same job. Workers starting to search later
+//! in the turn, or whose job is not valid anymore, get the closest job not reserved yet.
+//! The jobs are rebuilt at most once per turn, when what they depend on has changed. They can
+//! then be outdated during the turn so the returned job is always checked before being given.
+class WorkerJobBoard
+{
+public:
+    WorkerJobBoard(GameMap* gameMap, Seat* seat);
+
+    //! \brief Gives the given worker a tile job (dig or claim) within its sight radius. If a valid job
+    //! is found, returns true and sets jobTile to the tile to dig/claim and workTile to the tile where
+    //! the worker should go to work on it.
+    bool findJob(Creature& worker, WorkerJobType type, Tile*& jobTile, Tile*& workTile);
+
+    //! \brief Gives the given worker an entity to carry within its sight radius. Entities with the highest
+    //! carry priority are given first. Returns nullptr if there is none
+    GameEntity* findEntityToCarry(Creature& worker);
+
+    //! \brief Approximate number of bytes used by the jobs
+    uint64_t getMemoryUsage() const;
+
+private:
+    //! \brief Jobs of one type. For tile jobs, for each tile of the map, index in mJobs of the closest
+    //! job reachable from this tile (or -1 if none)
+    struct JobField
+    {
+        JobField() :
+            mTurnNumber(-1),
+            mTilePlanesVersion(0),
+            mMarkedVersion(0),
+            mMatchTurnNumber(-1)
+        {}
+
+        int64_t mTurnNumber;
+        uint32_t mTilePlanesVersion;
+        uint32_t mMarkedVersion;
+        //! \brief Pairs of (job tile, work tile)
+        std::vector<std::pair<Tile*, Tile*>> mJobs;
+        //! \brief For carry jobs, the entity to carry (parallel to mJobs)
+        std::vector<GameEntity*> mEntities;
+        std::vector<int32_t> mClosestJob;
+        //! \brief Number of steps to the closest job (parallel to mClosestJob)
+        std::vector<int32_t> mDistances;
+
+        //! \brief Turn of the last matching pass
+        int64_t mMatchTurnNumber;
+        //! \brief Jobs already given (or found invalid) this turn (parallel to mJobs)
+        std::vector<bool> mReserved;
+        //! \brief Job given to each worker by the matching pass
+        std::unordered_map<const Creature*, uint32_t> mReservations;
+    };
+
+    GameMap* mGameMap;
+    Seat* mSeat;
+
+    std::vector<JobField> mFields;
+
+    //! \brief Returns the index of the job given to the worker or -1 if none. The job is valid
+    int32_t giveJob(Creature& worker, WorkerJobType type);
+
+    //! \brief Rebuilds the jobs for the given job type if the map changed since the last time
+    //! they were computed. Jobs are rebuilt at most once per turn
+    void refreshField(WorkerJobType type, JobField& field);
+
+    //! \brief Fills the field jobs with every (job tile, work tile) pair for the given job type.
+    //! Carry jobs list every entity lying on the map. Which ones a worker can take is checked
+    //! for each worker by isCarryJobAvailable
+    void fillJobs(WorkerJobType type, JobField& field);
+
+    //! \brief Adds the given entity to the carry jobs if it lies on a ground tile
+    void addCarryJob(GameEntity* entity, JobField& field);
+
+    //! \brief Reserves a job for every worker currently searching for the given job type
+    void matchWorkers(WorkerJobType type, JobField& field);
+
+    //! \brief Returns the index of the best job not reserved yet for the given worker or -1 if none.
+    //! Jobs with the highest priority, then the closest, are preferred
+    int32_t findFreeJob(Creature& worker, WorkerJobType type, const JobField& field) const;
+
+    //! \brief Jobs with a higher priority are given first. Only carry jobs have a priority: the carry
+    //! type of the entity for the given worker
+    int32_t getJobPriority(Creature& worker, WorkerJobType type, const JobField& field, uint32_t jobIndex) const;
+
+    //! \brief Returns true if the given worker can carry the entity of the given carry job to one of
+    //! our buildings that wants it
+    bool isCarryJobAvailable(Creature& worker, const JobField& field, uint32_t jobIndex) const;
+
+    //! \brief Returns true if the given job can be taken by the worker (within its sight radius and
+    //! in the same ground region)
+    bool isJobInReach(const Creature& worker, const JobField& field, uint32_t jobIndex) const;
+
+    //! \brief Returns true if the given job can currently be done by the given worker
+    bool isJobValid(Creature& worker, WorkerJobType type, const JobField& field, uint32_t jobIndex);
+
+    //! \brief Returns true if the worker can walk on the given tile
+    bool isWalkable(Tile* tile) const;
+
+    //! \brief Returns true if the given worker is currently searching for the given job type
+    static bool isSearchingJob(const Creature& worker, WorkerJobType type);
+};
+
+#endif // WORKERJOBBOARD_H
@@ -0,0 +1,247 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/DigCostField.h"
+
+#include "entities/Creature.h"
+#include "entities/Tile.h"
+#include "game/Player.h"
+#include "game/Seat.h"
+#include "gamemap/GameMap.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+const uint32_t DigCostField::NO_WAY = std::numeric_limits<uint32_t>::max();
+
+namespace
+{
+//! \brief Tiles already marked for digging will be dug anyway
+const uint32_t WEIGHT_MARKED = 1;
+//! \brief Base weight of the diggable tiles depending on their type. Claimed walls are reinforced
+const uint32_t WEIGHT_GOLD_PREFERRED = 1;
+const uint32_t WEIGHT_DIRT = 4;
+const uint32_t WEIGHT_GOLD = 4;
+const uint32_t WEIGHT_GEM = 8;
+const uint32_t WEIGHT_CLAIMED_WALL = 12;
+//! \brief Full tiles get up to this weight added depending on their fullness
+const uint32_t WEIGHT_FULLNESS_MAX = 4;
+
+const int NEIGHBOR_OFFSETS[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+} // namespace <none>
+
+DigCostField::DigCostField(GameMap& gameMap, Seat& seat, Tile& source, bool preferGold) :
+    mGameMap(gameMap),
+    mSeat(seat),
+    mSource(source),
+    mPreferGold(preferGold),
+    mMapSizeX(gameMap.getMapSizeX()),
+    mIsComputed(false),
+    mTilePlanesVersion(0),
+    mMarkedVersion(0),
+    mNbFullBuilds(0),
+    mNbIncrementalUpdates(0)
+{
+}
+
+uint32_t DigCostField::computeWeight(const Creature& creature, Tile& tile) const
+{
+    if(creature.canGoThroughTile(&tile))
+        return 0;
+
+    if(tile.getMarkedForDigging(mSeat.getPlayer()))
+        return WEIGHT_MARKED;
+
+    if(!tile.isDiggable(&mSeat))
+        return NO_WAY;
+
+    uint32_t weight;
+    if(tile.isClaimed())
+        weight = WEIGHT_CLAIMED_WALL;
+    else if(tile.getType() == TileType::gold)
+        weight = mPreferGold ? WEIGHT_GOLD_PREFERRED : WEIGHT_GOLD;
+    else if(tile.getType() == TileType::gem)
+        weight = WEIGHT_GEM;
+    else
+        weight = WEIGHT_DIRT;
+
+    // Gold is what the AI is looking for. We do not want partially dug dirt to look better
+    if(mPreferGold && (tile.getType() == TileType::gold))
+        return weight;
+
+    double fullness = std::min(std::max(tile.getFullness(), 0.0), 100.0);
+    return weight + static_cast<uint32_t>(fullness * WEIGHT_FULLNESS_MAX / 100.0);
+}
+
+void DigCostField::refresh(const Creature& creature)
+{
+    uint32_t tilePlanesVersion = mGameMap.getTilePlanesVersion();
+    uint32_t markedVersion = mGameMap.getMarkedForDiggingPlane(mSeat.getId()).getVersion();
+    if(mIsComputed &&
+       (mTilePlanesVersion == tilePlanesVersion) &&
+       (mMarkedVersion == markedVersion))
+    {
+        return;
+    }
+
+    int mapSizeY = mGameMap.getMapSizeY();
+    uint32_t nbTiles = static_cast<uint32_t>(mMapSizeX * mapSizeY);
+    bool isFullBuild = !mIsComputed || (mWeights.size() != nbTiles);
+    std::vector<int32_t> changedIndexes;
+    mWeights.resize(nbTiles, NO_WAY);
+    for(int yy = 0; yy < mapSizeY; ++yy)
+    {
+        for(int xx = 0; xx < mMapSizeX; ++xx)
+        {
+            int32_t index = yy * mMapSizeX + xx;
+            uint32_t weight = computeWeight(creature, *mGameMap.getTile(xx, yy));
+            if(weight == mWeights[index])
+                continue;
+
+            // If a tile is harder to cross, the tiles reached through it may have a higher
+            // cost now. We have to compute everything again
+            if(weight > mWeights[index])
+                isFullBuild = true;
+
+            mWeights[index] = weight;
+            changedIndexes.push_back(index);
+        }
+    }
+
+    mIsComputed = true;
+    mTilePlanesVersion = tilePlanesVersion;
+    mMarkedVersion = markedVersion;
+
+    if(isFullBuild)
+    {
+        ++mNbFullBuilds;
+        mCost.assign(nbTiles, NO_WAY);
+        mPrevious.assign(nbTiles, -1);
+        int32_t sourceIndex = mSource.getY() * mMapSizeX + mSource.getX();
+        mCost[sourceIndex] = 0;
+        std::vector<int32_t> startIndexes(1, sourceIndex);
+        propagate(startIndexes);
+        return;
+    }
+
+    // Tiles only got easier to cross. Their cost can only decrease and so can the cost
+    // of the tiles reached through them
+    ++mNbIncrementalUpdates;
+    std::vector<int32_t> startIndexes;
+    for(int32_t index : changedIndexes)
+    {
+        if(mWeights[index] == NO_WAY)
+            continue;
+
+        int x = index % mMapSizeX;
+        int y = index / mMapSizeX;
+        for(const int* offset : NEIGHBOR_OFFSETS)
+        {
+            int nx = x + offset[0];
+            int ny = y + offset[1];
+            if((nx < 0) || (ny < 0) || (nx >= mMapSizeX) || (ny >= mapSizeY))
+                continue;
+
+            int32_t neighIndex = ny * mMapSizeX + nx;
+            if(mCost[neighIndex] == NO_WAY)
+                continue;
+
+            uint32_t cost = mCost[neighIndex] + mWeights[index];
+            if(cost >= mCost[index])
+                continue;
+
+            mCost[index] = cost;
+            mPrevious[index] = neighIndex;
+        }
+
+        if(mCost[index] != NO_WAY)
+            startIndexes.push_back(index);
+    }
+    propagate(startIndexes);
+}
+
+void DigCostField::propagate(std::vector<int32_t>& startIndexes)
+{
+    int mapSizeY = mGameMap.getMapSizeY();
+    typedef std::pair<uint32_t, int32_t> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    for(int32_t index : startIndexes)
+        queue.push(QueueEntry(mCost[index], index));
+
+    while(!queue.empty())
+    {
+        QueueEntry entry = queue.top();
+        queue.pop();
+        // Entries are not removed when a cheaper cost is found. We skip the outdated ones
+        if(entry.first > mCost[entry.second])
+            continue;
+
+        // Like workers, we only move horizontally or vertically: they cannot dig diagonally
+        int x = entry.second % mMapSizeX;
+        int y = entry.second / mMapSizeX;
+        for(const int* offset : NEIGHBOR_OFFSETS)
+        {
+            int nx = x + offset[0];
+            int ny = y + offset[1];
+            if((nx < 0) || (ny < 0) || (nx >= mMapSizeX) || (ny >= mapSizeY))
+                continue;
+
+            int32_t neighIndex = ny * mMapSizeX + nx;
+            if(mWeights[neighIndex] == NO_WAY)
+                continue;
+
+            uint32_t cost = entry.first + mWeights[neighIndex];
+            if(cost >= mCost[neighIndex])
+                continue;
+
+            mCost[neighIndex] = cost;
+            mPrevious[neighIndex] = entry.second;
+            queue.push(QueueEntry(cost, neighIndex));
+        }
+    }
+}
+
+uint32_t DigCostField::getCost(const Tile& tile) const
+{
+    int32_t index = tile.getY() * mMapSizeX + tile.getX();
+    if((index < 0) || (index >= static_cast<int32_t>(mCost.size())))
+        return NO_WAY;
+
+    return mCost[index];
+}
+
+bool DigCostField::getTilesToDig(const Tile& target, std::vector<Tile*>& tilesToDig) const
+{
+    tilesToDig.clear();
+    if(getCost(target) == NO_WAY)
+        return false;
+
+    int32_t index = target.getY() * mMapSizeX + target.getX();
+    while(index >= 0)
+    {
+        if(mWeights[index] > 0)
+            tilesToDig.push_back(mGameMap.getTile(index % mMapSizeX, index / mMapSizeX));
+
+        index = mPrevious[index];
+    }
+
+    std::reverse(tilesToDig.begin(), tilesToDig.end());
+    return true;
+}
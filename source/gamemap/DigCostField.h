@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DIGCOSTFIELD_H
+#define DIGCOSTFIELD_H
+
+#include <cstdint>
+#include <vector>
+
+class Creature;
+class GameMap;
+class Seat;
+class Tile;
+
+//! \brief Cost, for the workers of a seat, to reach every tile of the map from a source tile
+//! by digging. Tiles the workers can walk on cost nothing. Diggable tiles cost more the harder
+//! they are to dig (type and fullness). Tiles that are neither walkable nor diggable cannot be
+//! crossed. The field is computed with a single Dijkstra from the source and can then answer
+//! "what should be dug to go there" for any tile by following it back to the source.
+//! It is meant to be kept while the map changes: refresh() only rebuilds the whole field when a
+//! tile became harder to cross. When tiles only got easier to cross (which is the case when they
+//! are dug or marked for digging), the costs are updated from those tiles.
+class DigCostField
+{
+public:
+    //! \brief Weight of tiles that cannot be crossed and cost of the tiles that cannot be reached
+    static const uint32_t NO_WAY;
+
+    //! \brief If preferGold is true, gold tiles cost the least to dig so that paths go through
+    //! them when possible (used by the AI when expanding)
+    DigCostField(GameMap& gameMap, Seat& seat, Tile& source, bool preferGold);
+
+    //! \brief Brings the field up to date with the map. creature is used to know the tiles the
+    //! workers can walk on. Nothing is done if the map did not change since the last refresh
+    void refresh(const Creature& creature);
+
+    //! \brief Returns the digging cost to reach the given tile from the source or NO_WAY
+    uint32_t getCost(const Tile& tile) const;
+
+    //! \brief Fills tilesToDig with the tiles that have to be dug (or that are already marked for digging)
+    //! to reach target from the source, starting from the source side. Returns false if target cannot be reached
+    bool getTilesToDig(const Tile& target, std::vector<Tile*>& tilesToDig) const;
+
+    inline uint32_t getNbFullBuilds() const
+    { return mNbFullBuilds; }
+
+    inline uint32_t getNbIncrementalUpdates() const
+    { return mNbIncrementalUpdates; }
+
+    inline uint64_t getMemoryUsage() const
+    {
+        return sizeof(DigCostField) + (mWeights.capacity() + mCost.capacity()) * sizeof(uint32_t)
+            + mPrevious.capacity() * sizeof(int32_t);
+    }
+
+private:
+    GameMap& mGameMap;
+    Seat& mSeat;
+    Tile& mSource;
+    bool mPreferGold;
+    int mMapSizeX;
+
+    //! \brief Versions of the map data the field was computed from
+    bool mIsComputed;
+    uint32_t mTilePlanesVersion;
+    uint32_t mMarkedVersion;
+
+    //! \brief For each tile, cost to cross it
+    std::vector<uint32_t> mWeights;
+
+    //! \brief For each tile, cost to reach it from the source and index of the previous tile
+    //! on the way (-1 for the source and the tiles that cannot be reached)
+    std::vector<uint32_t> mCost;
+    std::vector<int32_t> mPrevious;
+
+    uint32_t mNbFullBuilds;
+    uint32_t mNbIncrementalUpdates;
+
+    //! \brief Returns the cost to cross the given tile
+    uint32_t computeWeight(const Creature& creature, Tile& tile) const;
+
+    //! \brief Runs Dijkstra from the given tiles, whose cost have already been set
+    void propagate(std::vector<int32_t>& startIndexes);
+};
+
+#endif // DIGCOSTFIELD_H
@@ -0,0 +1,172 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/FlowField.h"
+
+#include "entities/Creature.h"
+#include "entities/Tile.h"
+#include "gamemap/GameMap.h"
+
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+FlowField::FlowField(GameMap& gameMap, const Creature& creature, Tile& target) :
+    mGameMap(gameMap),
+    mTarget(&target),
+    mMapSizeX(gameMap.getMapSizeX()),
+    mNbTilesReached(0)
+{
+    compute(creature);
+}
+
+void FlowField::compute(const Creature& creature)
+{
+    uint32_t nbTiles = static_cast<uint32_t>(mMapSizeX * mGameMap.getMapSizeY());
+    mNext.assign(nbTiles, -1);
+    mCost.assign(nbTiles, std::numeric_limits<double>::max());
+
+    // Like with A*, the destination has to be passable to be reached
+    if(!creature.canGoThroughTile(mTarget))
+        return;
+
+    typedef std::pair<double, int32_t> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    int32_t targetIndex = mTarget->getY() * mMapSizeX + mTarget->getX();
+    mNext[targetIndex] = targetIndex;
+    mCost[targetIndex] = 0.0;
+    queue.push(QueueEntry(0.0, targetIndex));
+    while(!queue.empty())
+    {
+        QueueEntry entry = queue.top();
+        queue.pop();
+        // Entries are not removed when a cheaper cost is found. We skip the outdated ones
+        if(entry.first > mCost[entry.second])
+            continue;
+
+        ++mNbTilesReached;
+        int x = entry.second % mMapSizeX;
+        int y = entry.second / mMapSizeX;
+        for(int dy = -1; dy <= 1; ++dy)
+        {
+            for(int dx = -1; dx <= 1; ++dx)
+            {
+                if((dx == 0) && (dy == 0))
+                    continue;
+
+                Tile* neigh = mGameMap.getTile(x + dx, y + dy);
+                if(neigh == nullptr)
+                    continue;
+                if(!creature.canGoThroughTile(neigh))
+                    continue;
+
+                // Like in A*, diagonal moves are only allowed if both adjacent tiles are passable
+                if((dx != 0) && (dy != 0))
+                {
+                    if(!creature.canGoThroughTile(mGameMap.getTile(x + dx, y)))
+                        continue;
+                    if(!creature.canGoThroughTile(mGameMap.getTile(x, y + dy)))
+                        continue;
+                }
+
+                // A* weights a move with the speed on the tile the creature leaves, which is the
+                // neighbor here since we are going backward
+                double weight = static_cast<double>(std::abs(dx) + std::abs(dy));
+                if(neigh->getFullness() == 0)
+                    weight /= creature.getMoveSpeed(neigh);
+                else
+                    weight /= creature.getMoveSpeedGround();
+
+                int32_t neighIndex = neigh->getY() * mMapSizeX + neigh->getX();
+                double cost = entry.first + weight;
+                if(cost >= mCost[neighIndex])
+                    continue;
+
+                mCost[neighIndex] = cost;
+                mNext[neighIndex] = entry.second;
+                queue.push(QueueEntry(cost, neighIndex));
+            }
+        }
+    }
+}
+
+bool FlowField::isReached(int x, int y) const
+{
+    if((x < 0) || (y < 0) || (x >= mMapSizeX) || (y >= mGameMap.getMapSizeY()))
+        return false;
+
+    return mNext[y * mMapSizeX + x] >= 0;
+}
+
+bool FlowField::buildPath(Tile* start, std::list<Tile*>& path) const
+{
+    path.clear();
+    if(start == nullptr)
+        return false;
+
+    int32_t index = start->getY() * mMapSizeX + start->getX();
+    if((index < 0) || (index >= static_cast<int32_t>(mNext.size())))
+        return false;
+
+    path.push_back(start);
+    if(mNext[index] < 0)
+    {
+        // The start tile may not be passable (for example if a door was closed while we were on it).
+        // In this case, we leave it through the cheapest adjacent tile
+        int32_t bestIndex = -1;
+        for(int dy = -1; dy <= 1; ++dy)
+        {
+            for(int dx = -1; dx <= 1; ++dx)
+            {
+                if((dx == 0) && (dy == 0))
+                    continue;
+                if(!isReached(start->getX() + dx, start->getY() + dy))
+                    continue;
+                if((dx != 0) && (dy != 0) &&
+                   (!isReached(start->getX() + dx, start->getY()) || !isReached(start->getX(), start->getY() + dy)))
+                {
+                    continue;
+                }
+
+                int32_t neighIndex = (start->getY() + dy) * mMapSizeX + start->getX() + dx;
+                if((bestIndex >= 0) && (mCost[neighIndex] >= mCost[bestIndex]))
+                    continue;
+
+                bestIndex = neighIndex;
+            }
+        }
+
+        if(bestIndex < 0)
+        {
+            path.clear();
+            return false;
+        }
+
+        index = bestIndex;
+        path.push_back(mGameMap.getTile(index % mMapSizeX, index / mMapSizeX));
+    }
+
+    while(mNext[index] != index)
+    {
+        index = mNext[index];
+        path.push_back(mGameMap.getTile(index % mMapSizeX, index / mMapSizeX));
+    }
+
+    return true;
+}
@@ -0,0 +1,75 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include <cstdint>
+#include <list>
+#include <vector>
+
+class Creature;
+class GameMap;
+class Tile;
+
+//! \brief Direction field toward a target tile. It is computed with a single reverse Dijkstra
+//! from the target using the same costs as GameMap::path() so that every creature moving like
+//! the one the field was built for can get its path to the target by following the field instead
+//! of running its own A*. That is useful when many creatures are sent to the same tile (call to war,
+//! portal waves, retreats to the temple...).
+//! The field does not follow the map changes. It is up to the owner to drop it when the passability changes.
+class FlowField
+{
+public:
+    //! \brief Computes the field toward target for creatures moving like the given one (same
+    //! passable tiles and same speeds)
+    FlowField(GameMap& gameMap, const Creature& creature, Tile& target);
+
+    inline Tile* getTarget() const
+    { return mTarget; }
+
+    //! \brief Returns the number of tiles from which the target can be reached
+    inline uint32_t getNbTilesReached() const
+    { return mNbTilesReached; }
+
+    //! \brief Fills path with the tiles from start to the target (both included). Like with GameMap::path(),
+    //! the start tile does not need to be passable. Returns false if the target cannot be reached from start
+    bool buildPath(Tile* start, std::list<Tile*>& path) const;
+
+    //! \brief Returns true if the target can be reached from the given position
+    bool isReached(int x, int y) const;
+
+    inline uint64_t getMemoryUsage() const
+    { return sizeof(FlowField) + mNext.capacity() * sizeof(int32_t) + mCost.capacity() * sizeof(double); }
+
+private:
+    GameMap& mGameMap;
+    Tile* mTarget;
+    int mMapSizeX;
+    uint32_t mNbTilesReached;
+
+    //! \brief For each tile, index of the next tile toward the target or -1 if the target
+    //! cannot be reached. The target points to itself
+    std::vector<int32_t> mNext;
+
+    //! \brief For each tile, cost to go to the target
+    std::vector<double> mCost;
+
+    void compute(const Creature& creature);
+};
+
+#endif // FLOWFIELD_H
@@ -38,6 +38,8 @@
 #include "game/Skill.h"
 #include "game/SkillType.h"
 #include "game/Seat.h"
+#include "gamemap/DigCostField.h"
+#include "gamemap/FlowField.h"
 #include "gamemap/MapHandler.h"
 #include "gamemap/Pathfinding.h"
 #include "gamemap/TileSet.h"
@@ -60,6 +62,7 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/ResourceManager.h"
+#include "utils/ThreadPool.h"
 
 #include <OgreTimer.h>
 
@@ -70,6 +73,8 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <tuple>
 
 const std::string DEFAULT_NICK = "You";
 
@@ -161,6 +166,13 @@ GameMap::GameMap(bool isServerGameMap) :
         mFloodFillEnabled(false),
         mIsFOWActivated(true),
         mNumCallsTo_path(0),
+        mPathCacheTurn(-1),
+        mPathCachePassabilityVersion(0),
+        mNbPathCacheHits(0),
+        mNbPathCacheMisses(0),
+        mFlowFieldsPassabilityVersion(0),
+        mNbFlowFieldsBuilt(0),
+        mNbFlowFieldPaths(0),
         mAiManager(*this),
         mTileSet(nullptr)
 {
@@ -242,7 +254,7 @@ bool GameMap::createNewMap(int sizeX, int sizeY)
     return true;
 }
 
-void GameMap::setAllFullnessAndNeighbors()
+void GameMap::setAllFullness()
 {
     for (int ii = 0; ii < mMapSizeX; ++ii)
     {
@@ -250,7 +262,6 @@ void GameMap::setAllFullnessAndNeighbors()
         {
             Tile* tile = getTile(ii, jj);
             tile->setFullness(tile->getFullness());
-            setTileNeighbors(tile);
         }
     }
 }
@@ -272,6 +283,8 @@ void GameMap::clearAll()
 
     clearTiles();
     processDeletionQueues();
+    invalidatePathCache();
+    mDigCostFields.clear();
 
     clearGoalsForAllSeats();
     clearSeats();
@@ -308,9 +321,9 @@ void GameMap::clearAll()
     if(!mEntitiesToDelete.empty())
     {
         OD_LOG_ERR("mEntitiesToDelete not empty size=" + Helper::toString(static_cast<uint32_t>(mEntitiesToDelete.size())));
-        for(GameEntity* entity : mEntitiesToDelete)
+        for(std::pair<GameEntity*, ObjectPoolHandle>& p : mEntitiesToDelete)
         {
-            OD_LOG_ERR("entity not removed=" + entity->getName());
+            OD_LOG_ERR("entity not removed=" + p.first->getName());
         }
         mEntitiesToDelete.clear();
     }
@@ -490,6 +503,7 @@ void GameMap::addCreature(Creature *cc)
         + ", seatId=" + (cc->getSeat() != nullptr ? Helper::toString(cc->getSeat()->getId()) : std::string("null")));
 
     mCreatures.push_back(cc);
+    notifyGoalEvent(Goal::EventCreatures);
 }
 
 void GameMap::removeCreature(Creature *c)
@@ -504,11 +518,12 @@ void GameMap::removeCreature(Creature *c)
     }
 
     mCreatures.erase(it);
+    notifyGoalEvent(Goal::EventCreatures);
 }
 
 void GameMap::queueEntityForDeletion(GameEntity *ge)
 {
-    mEntitiesToDelete.push_back(ge);
+    mEntitiesToDelete.push_back(std::make_pair(ge, ObjectPool::findHandle(ge)));
 }
 
 const CreatureDefinition* GameMap::getClassDescription(const string &className)
@@ -1088,7 +1103,13 @@ void GameMap::doTurn(double timeSinceLastTurn)
     }
 
     OD_LOG_INF("During this turn there were " + Helper::toString(mNumCallsTo_path - numCallsTo_path_atStart)
-        + " calls to GameMap::path(), miscUpkeepTime=" + Helper::toString(miscUpkeepTime));
+        + " calls to GameMap::path() (" + Helper::toString(mNbPathCacheHits) + " found in cache, "
+        + Helper::toString(mNbPathCacheMisses) + " computed), " + Helper::toString(mNbFlowFieldPaths)
+        + " paths from " + Helper::toString(mNbFlowFieldsBuilt) + " new flow fields, miscUpkeepTime=" + Helper::toString(miscUpkeepTime));
+    mNbPathCacheHits = 0;
+    mNbPathCacheMisses = 0;
+    mNbFlowFieldsBuilt = 0;
+    mNbFlowFieldPaths = 0;
 }
 
 void GameMap::doPlayerAITurn(double timeSinceLastTurn)
@@ -1098,7 +1119,6 @@ void GameMap::doPlayerAITurn(double timeSinceLastTurn)
 
 unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
 {
-    Tile *tempTile;
     Ogre::Timer stopwatch;
     unsigned long int timeTaken;
 
@@ -1116,20 +1136,7 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
                 continue;
 
             // We notify the player if he owns a fighter only
-            bool isCreatureSeat = false;
-            for(Creature* creature : mCreatures)
-            {
-                if(creature->getSeat() != player->getSeat())
-                    continue;
-
-                if(creature->getDefinition()->isWorker())
-                    continue;
-
-                isCreatureSeat = true;
-                break;
-            }
-
-            if(!isCreatureSeat)
+            if(player->getSeat()->getLedgerNbFighters() == 0)
                 continue;
 
             ServerNotification *serverNotification = new ServerNotification(
@@ -1160,49 +1167,43 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
             addWinningSeat(seat);
 
         seat->mNumCreaturesFightersMax = getMaxNumberCreatures(seat);
-
-        // Set the creatures count to 0. It will be reset by the next count in doTurn()
-        seat->mNumCreaturesFighters = 0;
-        seat->mNumCreaturesWorkers = 0;
     }
 
+#ifdef OD_DEBUG
+    checkSeatLedgers();
+#endif
+
     // Count how many creatures the player controls
-    for(Creature* creature : mCreatures)
+    for (Seat* seat : mSeats)
     {
-        // Check to see if the creature has died.
-        if (!creature->isAlive())
-            continue;
-
-        Seat *tempSeat = creature->getSeat();
-        if(tempSeat == nullptr)
-            continue;
-
-        // We only count fighters
-        if (creature->getDefinition()->isWorker())
-            ++(tempSeat->mNumCreaturesWorkers);
-        else
-            ++(tempSeat->mNumCreaturesFighters);
+        seat->mNumCreaturesFighters = seat->getLedgerNbFighters();
+        seat->mNumCreaturesWorkers = seat->getLedgerNbWorkers();
     }
 
     // At each upkeep, we re-compute tiles with vision
     for (Seat* seat : mSeats)
         seat->clearTilesWithVision();
 
-    for (int jj = 0; jj < getMapSizeY(); ++jj)
-    {
-        for (int ii = 0; ii < getMapSizeX(); ++ii)
-        {
-            getTile(ii,jj)->clearVision();
-        }
-    }
+    clearSeatVisionPlanes();
 
     // Compute vision. We need to compute every seats including AI because
-    // a human can be allied with an AI and they would share vision
-    for (int jj = 0; jj < getMapSizeY(); ++jj)
+    // a human can be allied with an AI and they would share vision.
+    // If the FOW is activated, only claimed tiles give vision
+    if(getIsFOWActivated())
     {
-        for (int ii = 0; ii < getMapSizeX(); ++ii)
+        getClaimedAnySeatPlane().forEachSet([this](int ii, int jj)
         {
             getTile(ii,jj)->computeVisibleTiles();
+        });
+    }
+    else
+    {
+        for (int jj = 0; jj < getMapSizeY(); ++jj)
+        {
+            for (int ii = 0; ii < getMapSizeX(); ++ii)
+            {
+                getTile(ii,jj)->computeVisibleTiles();
+            }
         }
     }
 
@@ -1225,8 +1226,7 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
     }
 
     // We send to each seat the list of tiles he has vision on
-    for (Seat* seat : mSeats)
-        seat->sendVisibleTiles();
+    queueSeatNotifications(&Seat::buildVisibleTilesNotification);
 
     // Carry out the upkeep round of all the active objects in the game.
     // Here, we work on a copy of the active objects list because they might
@@ -1262,39 +1262,96 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
         // Update the count on how much gold is available in all of the treasuries claimed by the given seat.
         seat->mGold = 0;
         seat->mGoldMax = 0;
-        for (Room* room : getRooms())
+        for (Room* room : seat->getLedgerRooms())
         {
-            if(room->getSeat() != seat)
-                continue;
-
             seat->mGold += room->getTotalGoldStored();
             seat->mGoldMax += room->getTotalGoldStorage();
         }
     }
 
     // Determine the number of tiles claimed by each seat.
-    // Begin by setting the number of claimed tiles for each seat to 0.
     for (Seat* seat : mSeats)
-        seat->setNumClaimedTiles(0);
+    {
+        uint32_t nbClaimedTiles = countClaimedTiles(seat->getId());
+        if(nbClaimedTiles == seat->getNumClaimedTiles())
+            continue;
 
-    // Now loop over all of the tiles, if the tile is claimed increment the given seats count.
-    for (int jj = 0; jj < getMapSizeY(); ++jj)
+        seat->setNumClaimedTiles(nbClaimedTiles);
+        seat->notifyGoalEvent(Goal::EventClaimedTiles);
+    }
+
+    timeTaken = stopwatch.getMicroseconds();
+    return timeTaken;
+}
+
+void GameMap::notifyGoalEvent(uint32_t events)
+{
+    for (Seat* seat : mSeats)
+        seat->notifyGoalEvent(events);
+}
+
+void GameMap::checkSeatLedgers()
+{
+    for (Seat* seat : mSeats)
     {
-        for (int ii = 0; ii < getMapSizeX(); ++ii)
+        uint32_t nbWorkers = 0;
+        uint32_t nbFighters = 0;
+        for(Creature* creature : mCreatures)
+        {
+            if(creature->getSeat() != seat)
+                continue;
+            if(!creature->isAlive())
+                continue;
+
+            if(creature->getDefinition()->isWorker())
+                ++nbWorkers;
+            else
+                ++nbFighters;
+        }
+
+        if((nbWorkers != seat->getLedgerNbWorkers()) || (nbFighters != seat->getLedgerNbFighters()))
+        {
+            OD_LOG_ERR("seatId=" + Helper::toString(seat->getId())
+                + ", workers=" + Helper::toString(nbWorkers) + ", ledger=" + Helper::toString(seat->getLedgerNbWorkers())
+                + ", fighters=" + Helper::toString(nbFighters) + ", ledger=" + Helper::toString(seat->getLedgerNbFighters()));
+        }
+
+        std::vector<uint32_t> nbRooms(static_cast<uint32_t>(RoomType::nbRooms), 0);
+        for(Room* room : mRooms)
         {
-            tempTile = getTile(ii,jj);
+            if(room->getSeat() != seat)
+                continue;
+
+            ++nbRooms[static_cast<uint32_t>(room->getType())];
+        }
+
+        for(uint32_t i = 0; i < nbRooms.size(); ++i)
+        {
+            RoomType type = static_cast<RoomType>(i);
+            if(nbRooms[i] == seat->getLedgerNbRooms(type))
+                continue;
+
+            OD_LOG_ERR("seatId=" + Helper::toString(seat->getId()) + ", roomType=" + RoomManager::getRoomNameFromRoomType(type)
+                + ", nbRooms=" + Helper::toString(nbRooms[i]) + ", ledger=" + Helper::toString(seat->getLedgerNbRooms(type)));
+        }
 
-            // Check to see if the current tile is claimed by anyone.
-            if (tempTile->isClaimed())
+        uint32_t nbClaimedTiles = 0;
+        for (int jj = 0; jj < getMapSizeY(); ++jj)
+        {
+            for (int ii = 0; ii < getMapSizeX(); ++ii)
             {
-                // Increment the count of the seat who owns the tile.
-                tempTile->getSeat()->incrementNumClaimedTiles();
+                Tile* tile = getTile(ii, jj);
+                if(tile->isClaimed() && (tile->getSeat() == seat))
+                    ++nbClaimedTiles;
             }
         }
-    }
 
-    timeTaken = stopwatch.getMicroseconds();
-    return timeTaken;
+        if(nbClaimedTiles != countClaimedTiles(seat->getId()))
+        {
+            OD_LOG_ERR("seatId=" + Helper::toString(seat->getId()) + ", claimedTiles=" + Helper::toString(nbClaimedTiles)
+                + ", ledger=" + Helper::toString(countClaimedTiles(seat->getId())));
+        }
+    }
 }
 
 void GameMap::updateAnimations(Ogre::Real timeSinceLastFrame)
@@ -1414,15 +1471,9 @@ bool GameMap::pathExists(const Creature* creature, Tile* tileStart, Tile* tileEn
     {
         // Workers can go on a tile if and only if the path is open for any creature. If it is closed, that
         // means that a door is closed
-        for(Seat* seat : mSeats)
-        {
-            if(tileStart->isSameFloodFill(seat, floodFill, tileEnd))
-                continue;
-
-            return false;
-        }
-
-        return true;
+        uint32_t intType = static_cast<uint32_t>(floodFill);
+        return getWorkerFloodFillValue(tileStart->getX(), tileStart->getY(), intType) ==
+            getWorkerFloodFillValue(tileEnd->getX(), tileEnd->getY(), intType);
     }
     else
     {
@@ -1432,9 +1483,199 @@ bool GameMap::pathExists(const Creature* creature, Tile* tileStart, Tile* tileEn
     }
 }
 
+bool GameMap::PathCacheKey::operator<(const PathCacheKey& other) const
+{
+    return std::tie(mStart, mDestination, mCreatureSeatId, mSeatId, mMoveSpeedGround, mMoveSpeedWater,
+            mMoveSpeedLava, mIsWorker, mIsFighting, mThroughDiggableTiles, mTilePlanesVersion) <
+        std::tie(other.mStart, other.mDestination, other.mCreatureSeatId, other.mSeatId, other.mMoveSpeedGround,
+            other.mMoveSpeedWater, other.mMoveSpeedLava, other.mIsWorker, other.mIsFighting, other.mThroughDiggableTiles,
+            other.mTilePlanesVersion);
+}
+
+GameMap::PathCacheKey GameMap::getPathCacheKey(Tile* start, Tile* destination, const Creature& creature,
+    Seat* seat, bool throughDiggableTiles) const
+{
+    PathCacheKey key;
+    key.mStart = start;
+    key.mDestination = destination;
+    key.mCreatureSeatId = (creature.getSeat() == nullptr) ? -1 : creature.getSeat()->getId();
+    // The seat is only used to know the diggable tiles
+    key.mSeatId = ((seat == nullptr) || !throughDiggableTiles) ? -1 : seat->getId();
+    key.mMoveSpeedGround = creature.getMoveSpeedGround();
+    key.mMoveSpeedWater = creature.getMoveSpeedWater();
+    key.mMoveSpeedLava = creature.getMoveSpeedLava();
+    // Closed doors block workers. They cannot share paths with the other creatures of the seat
+    key.mIsWorker = creature.getDefinition()->isWorker();
+    key.mIsFighting = creature.isActionInList(CreatureActionType::fight) ||
+        creature.isActionInList(CreatureActionType::flee);
+    key.mThroughDiggableTiles = throughDiggableTiles;
+    // Tile::isDiggable depends on who claimed the walls. Paths computed before a claim change are not reused
+    key.mTilePlanesVersion = throughDiggableTiles ? getTilePlanesVersion() : 0;
+    return key;
+}
+
+void GameMap::invalidatePathCache()
+{
+    mPathCache.clear();
+    mFlowFields.clear();
+}
+
+std::vector<std::pair<std::string, uint64_t>> GameMap::getMemoryUsage() const
+{
+    std::vector<std::pair<std::string, uint64_t>> usage;
+    usage.push_back(std::make_pair("tiles", getTilesMemoryUsage()));
+    usage.push_back(std::make_pair("tile planes", getTilePlanesMemoryUsage()));
+    usage.push_back(std::make_pair("flood fill", getFloodFillMemoryUsage()));
+
+    uint64_t seatBytes = 0;
+    for(const Seat* seat : mSeats)
+        seatBytes += seat->getTilesStatesMemoryUsage();
+    usage.push_back(std::make_pair("seat tile states", seatBytes));
+
+    // Only the entities of this map are counted. The object pools they may come from are shared by
+    // every game map of the process and are reported on their own
+    uint64_t entityBytes = mCreatures.size() * sizeof(Creature)
+        + mRenderedMovableEntities.size() * sizeof(RenderedMovableEntity)
+        + mRooms.size() * sizeof(Room)
+        + mTraps.size() * sizeof(Trap)
+        + mMapLights.size() * sizeof(MapLight)
+        + mSpells.size() * sizeof(Spell);
+    usage.push_back(std::make_pair("entities", entityBytes));
+
+    // std::map and std::list nodes hold a few pointers besides their value
+    const uint64_t nodeBytes = 4 * sizeof(void*);
+    uint64_t pathBytes = 0;
+    for(const std::pair<const PathCacheKey, std::list<Tile*>>& path : mPathCache)
+        pathBytes += sizeof(path) + nodeBytes + path.second.size() * (sizeof(Tile*) + 2 * sizeof(void*));
+    for(const std::pair<const PathCacheKey, std::unique_ptr<FlowField>>& field : mFlowFields)
+        pathBytes += sizeof(field) + nodeBytes + field.second->getMemoryUsage();
+    for(const auto& field : mDigCostFields)
+        pathBytes += sizeof(field) + nodeBytes + field.second->getMemoryUsage();
+    for(Seat* seat : mSeats)
+        pathBytes += seat->getWorkerJobBoard().getMemoryUsage();
+    usage.push_back(std::make_pair("pathfinding", pathBytes));
+    return usage;
+}
+
+DigCostField* GameMap::getDigCostField(const Creature& worker, Seat* seat, Tile* source, bool preferGold)
+{
+    if((seat == nullptr) || (source == nullptr))
+        return nullptr;
+
+    std::tuple<int, const Tile*, bool> key(seat->getId(), source, preferGold);
+    auto it = mDigCostFields.find(key);
+    if(it == mDigCostFields.end())
+    {
+        // If there are too many fields, they are probably not used anymore
+        if(mDigCostFields.size() >= MAX_DIG_COST_FIELDS)
+            mDigCostFields.clear();
+
+        std::unique_ptr<DigCostField> field(new DigCostField(*this, *seat, *source, preferGold));
+        it = mDigCostFields.emplace(key, std::move(field)).first;
+    }
+
+    it->second->refresh(worker);
+    return it->second.get();
+}
+
+uint32_t GameMap::getDigCost(const Creature& worker, Seat* seat, Tile* source, Tile* target, bool preferGold)
+{
+    if(target == nullptr)
+        return DigCostField::NO_WAY;
+
+    DigCostField* field = getDigCostField(worker, seat, source, preferGold);
+    if(field == nullptr)
+        return DigCostField::NO_WAY;
+
+    return field->getCost(*target);
+}
+
+bool GameMap::findTilesToDig(const Creature& worker, Seat* seat, Tile* source, Tile* target, bool preferGold,
+    std::vector<Tile*>& tilesToDig)
+{
+    tilesToDig.clear();
+    if(target == nullptr)
+        return false;
+
+    DigCostField* field = getDigCostField(worker, seat, source, preferGold);
+    if(field == nullptr)
+        return false;
+
+    return field->getTilesToDig(*target, tilesToDig);
+}
+
+std::list<Tile*> GameMap::pathToSharedTarget(const Creature* creature, Tile* destination)
+{
+    if((creature == nullptr) || (destination == nullptr))
+        return std::list<Tile*>();
+
+    Tile* start = creature->getPositionTile();
+    if(start == nullptr)
+        return std::list<Tile*>();
+
+    if(mFlowFieldsPassabilityVersion != getPassabilityVersion())
+    {
+        mFlowFields.clear();
+        mFlowFieldsPassabilityVersion = getPassabilityVersion();
+    }
+
+    // Fields are shared by every creature moving the same way. We do not need the start tile
+    PathCacheKey key = getPathCacheKey(nullptr, destination, *creature, nullptr, false);
+    auto it = mFlowFields.find(key);
+    if(it == mFlowFields.end())
+    {
+        // Fields are big. If there are too many, they are probably not shared anymore
+        if(mFlowFields.size() >= MAX_FLOW_FIELDS)
+            mFlowFields.clear();
+
+        ++mNbFlowFieldsBuilt;
+        std::unique_ptr<FlowField> field(new FlowField(*this, *creature, *destination));
+        it = mFlowFields.emplace(key, std::move(field)).first;
+    }
+
+    std::list<Tile*> result;
+    if(it->second->buildPath(start, result))
+    {
+        ++mNbFlowFieldPaths;
+        return result;
+    }
+
+    // We could not leave our tile. Let's see what A* thinks
+    return path(creature, destination);
+}
+
 std::list<Tile*> GameMap::path(int x1, int y1, int x2, int y2, const Creature* creature, Seat* seat, bool throughDiggableTiles)
 {
     ++mNumCallsTo_path;
+    Tile* start = getTile(x1, y1);
+    Tile* destination = getTile(x2, y2);
+    if((start == nullptr) || (destination == nullptr) || (creature == nullptr))
+        return std::list<Tile*>();
+
+    if((mPathCacheTurn != mTurnNumber) ||
+       (mPathCachePassabilityVersion != getPassabilityVersion()))
+    {
+        mPathCache.clear();
+        mPathCacheTurn = mTurnNumber;
+        mPathCachePassabilityVersion = getPassabilityVersion();
+    }
+
+    PathCacheKey key = getPathCacheKey(start, destination, *creature, seat, throughDiggableTiles);
+    auto it = mPathCache.find(key);
+    if(it != mPathCache.end())
+    {
+        ++mNbPathCacheHits;
+        return it->second;
+    }
+
+    ++mNbPathCacheMisses;
+    std::list<Tile*> result = computePath(x1, y1, x2, y2, creature, seat, throughDiggableTiles);
+    mPathCache.emplace(key, result);
+    return result;
+}
+
+std::list<Tile*> GameMap::computePath(int x1, int y1, int x2, int y2, const Creature* creature, Seat* seat, bool throughDiggableTiles)
+{
     std::list<Tile*> returnList;
 
     // If the start tile was not found return an empty path
@@ -1812,6 +2053,8 @@ void GameMap::addRoom(Room *r)
     }
 
     mRooms.push_back(r);
+    if(isServerGameMap())
+        r->getSeat()->addRoomToLedger(r);
 }
 
 void GameMap::removeRoom(Room *r)
@@ -1827,6 +2070,8 @@ void GameMap::removeRoom(Room *r)
     }
 
     mRooms.erase(it);
+    if(isServerGameMap())
+        r->getSeat()->removeRoomFromLedger(r);
 }
 
 std::vector<Room*> GameMap::getRoomsByType(RoomType type) const
@@ -2078,6 +2323,7 @@ bool GameMap::addSeat(Seat *s)
             return false;
         }
     }
+    s->setIndex(static_cast<uint32_t>(mSeats.size()));
     mSeats.push_back(s);
     // We set the Seat color value
     const Ogre::ColourValue& colorValue = ConfigManager::getSingleton().getColorFromId(s->getColorId());
@@ -2203,17 +2449,15 @@ bool GameMap::doFloodFill(Seat* seat, Tile* tile)
 
 void GameMap::replaceFloodFill(Seat* seat, FloodFillType floodFillType, uint32_t colorOld, uint32_t colorNew)
 {
-    for (int jj = 0; jj < getMapSizeY(); ++jj)
+    // Floodfill can only be set on ground tiles
+    getFullTilePlane().forEachUnset([&](int ii, int jj)
     {
-        for (int ii = 0; ii < getMapSizeX(); ++ii)
-        {
-            Tile* tile = getTile(ii,jj);
-            if(tile->getFloodFillValue(seat, floodFillType) != colorOld)
-                continue;
+        Tile* tile = getTile(ii,jj);
+        if(tile->getFloodFillValue(seat, floodFillType) != colorOld)
+            return;
 
-            tile->replaceFloodFill(seat, floodFillType, colorNew);
-        }
-    }
+        tile->replaceFloodFill(seat, floodFillType, colorNew);
+    });
 }
 
 void GameMap::refreshFloodFill(Seat* seat, Tile* tile)
@@ -2278,13 +2522,7 @@ void GameMap::enableFloodFill()
 {
     // Carry out a flood fill of the whole level to make sure everything is good.
     // Start by setting the flood fill color for every tile on the map to -1.
-    for (int jj = 0; jj < getMapSizeY(); ++jj)
-    {
-        for (int ii = 0; ii < getMapSizeX(); ++ii)
-        {
-            getTile(ii,jj)->resetFloodFill();
-        }
-    }
+    resetFloodFillValues();
 
     // The algorithm used to find a path is efficient when the path exists but not if it doesn't.
     // To improve path finding, we tag the contiguous tiles to know if a path exists between 2 tiles or not.
@@ -2468,8 +2706,17 @@ std::list<Tile*> GameMap::path(const Creature* creature, Tile* destination, bool
 
 void GameMap::processDeletionQueues()
 {
-    for(GameEntity* entity : mEntitiesToDelete)
-        delete entity;
+    for(std::pair<GameEntity*, ObjectPoolHandle>& p : mEntitiesToDelete)
+    {
+        // If the entity is pooled, we check it has not already been deleted
+        if(!p.second.isNull() && !ObjectPool::isHandleAlive(p.second))
+        {
+            OD_LOG_ERR("Entity queued for deletion more than once");
+            continue;
+        }
+
+        delete p.first;
+    }
 
     mEntitiesToDelete.clear();
 }
@@ -2508,10 +2755,15 @@ std::vector<Tile*> GameMap::getBuildableTilesForPlayerInArea(int x1, int y1, int
 std::string GameMap::getGoalsStringForPlayer(Player* player)
 {
     bool playerIsAWinner = seatIsAWinner(player->getSeat());
-    std::stringstream tempSS("");
     Seat* seat = player->getSeat();
     seat->resetGoalsChanged();
 
+    // The string is only built again if the goals may have changed since last time
+    if(!seat->mGoalsStringDirty && (seat->mGoalsStringWinner == playerIsAWinner))
+        return seat->mGoalsString;
+
+    std::stringstream tempSS("");
+
     const std::string formatTitleOn = "[font='MedievalSharp-12'][colour='CCBBBBFF']";
     const std::string formatTitleOff = "[font='MedievalSharp-10'][colour='FFFFFFFF']";
 
@@ -2553,7 +2805,10 @@ std::string GameMap::getGoalsStringForPlayer(Player* player)
         }
     }
 
-    return tempSS.str();
+    seat->mGoalsString = tempSS.str();
+    seat->mGoalsStringDirty = false;
+    seat->mGoalsStringWinner = playerIsAWinner;
+    return seat->mGoalsString;
 }
 
 int GameMap::addGoldToSeat(int gold, int seatId)
@@ -2803,22 +3058,51 @@ Creature* GameMap::getWorkerForPathFinding(Seat* seat)
 
 void GameMap::updateVisibleEntities()
 {
-    // Notify what happened to entities on visible tiles
-    for (int jj = 0; jj < getMapSizeY(); ++jj)
+    // Notify what happened to entities on visible tiles. Only tiles with entities
+    // need to be processed
+    getOccupiedTilePlane().forEachSet([this](int ii, int jj)
     {
-        for (int ii = 0; ii < getMapSizeX(); ++ii)
-        {
-            Tile* tile = getTile(ii,jj);
-            tile->notifyEntitiesSeatsWithVision();
-        }
+        getTile(ii,jj)->notifyEntitiesSeatsWithVision();
+    });
+}
+
+void GameMap::queueSeatNotifications(ServerNotification* (Seat::*build)())
+{
+    std::vector<Seat*> seats;
+    for(Seat* seat : mSeats)
+    {
+        if((seat->getPlayer() == nullptr) || !seat->getPlayer()->getIsHuman())
+            continue;
+
+        seats.push_back(seat);
+    }
+
+    if(mSeatNotificationThreads == nullptr)
+    {
+        uint32_t nbCores = std::thread::hardware_concurrency();
+        mSeatNotificationThreads.reset(new ThreadPool((nbCores > 1) ? (nbCores - 1) : 0));
+    }
+
+    std::vector<ServerNotification*> notifications(seats.size(), nullptr);
+    mSeatNotificationThreads->run(static_cast<uint32_t>(seats.size()), [&seats, &notifications, build](uint32_t i)
+    {
+        notifications[i] = (seats[i]->*build)();
+    });
+
+    for(uint32_t i = 0; i < seats.size(); ++i)
+    {
+        seats[i]->applyBuildingVisionChanges();
+        if(notifications[i] == nullptr)
+            continue;
+
+        ODServer::getSingleton().queueServerNotification(notifications[i]);
     }
 }
 
 void GameMap::fireRefreshEntities()
 {
     // Notify changes on visible tiles
-    for(Seat* seat : mSeats)
-        seat->notifyChangedVisibleTiles();
+    queueSeatNotifications(&Seat::buildChangedVisibleTilesNotification);
 
     for(Creature* creature : mCreatures)
     {
@@ -3058,6 +3342,10 @@ void GameMap::clientUpKeep(int64_t turnNumber)
 
 void GameMap::doorLock(Tile* tileDoor, Seat* seat, bool locked)
 {
+    // The door state is used by the pathfinding but it may not have been refreshed in
+    // the tile planes yet
+    invalidatePathCache();
+
     if(!locked)
     {
         // When a door is unlocked, we check all its neighboors to find a floodfill value for each possible
@@ -3233,18 +3521,7 @@ void GameMap::notifySeatsConfigured()
         seat->setTeamIndex(teamIndex);
     }
 
-    uint32_t nbTeams = mTeamIds.size();
-    for(int xxx = 0; xxx < getMapSizeX(); ++xxx)
-    {
-        for(int yyy = 0; yyy < getMapSizeY(); ++yyy)
-        {
-            Tile* tile = getTile(xxx, yyy);
-            if(tile == nullptr)
-                continue;
-
-            tile->setTeamsNumber(nbTeams);
-        }
-    }
+    resizeFloodFillValues(static_cast<uint32_t>(mTeamIds.size()));
     // Now that team ids are set and tiles are configured, we can compute floodfill
     enableFloodFill();
 }
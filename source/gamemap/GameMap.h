@@ -21,6 +21,7 @@
 #include "gamemap/TileContainer.h"
 
 #include "ai/AIManager.h"
+#include "utils/ObjectPool.h"
 
 #ifdef __MINGW32__
 #ifndef mode_t
@@ -29,19 +30,24 @@
 #endif //mingw32
 
 #include <cstdint>
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 
 #include <OgreVector3.h>
 
 class Building;
 class Tile;
 class Creature;
+class DigCostField;
+class FlowField;
 class GameEntity;
 class Player;
 class Trap;
 class Seat;
+class ServerNotification;
 class Goal;
 class MapLight;
 class MovableGameEntity;
@@ -51,6 +57,7 @@ class CreatureMood;
 class RenderedMovableEntity;
 class Room;
 class Spell;
+class ThreadPool;
 class TileSet;
 class TileSetValue;
 
@@ -122,9 +129,9 @@ public:
     //! \returns whether the map could be created.
     bool createNewMap(int sizeX, int sizeY);
 
-    //! \brief Set every tiles fullness and neighbors list
+    //! \brief Set every tiles fullness
     //! Used when loading a map to setup the initial tile state.
-    void setAllFullnessAndNeighbors();
+    void setAllFullness();
 
     //! \brief Creates meshes for all the tiles, creatures, rooms, traps and lights stored in this GameMap.
     void createAllEntities();
@@ -335,6 +342,9 @@ public:
     inline void setLevelFightMusicFile(const std::string& levelFightMusicFile)
     { mMapInfoFightMusicFile = levelFightMusicFile; }
 
+    //! \brief Notifies every seat that the given events (Goal::Event* bitmask) happened
+    void notifyGoalEvent(uint32_t events);
+
     std::string getGoalsStringForPlayer(Player* player);
 
     //! \brief Loops over all the creatures and calls their individual doTurn methods,
@@ -374,6 +384,34 @@ public:
     //! \note Returns a path for the given creature to the given destination.
     std::list<Tile*> path(const Creature* creature, Tile* destination, bool throughDiggableTiles = false);
 
+    //! \brief Returns the same path as path(creature, destination) but it is built from a flow field
+    //! toward destination shared by every creature moving the same way. When many creatures are sent to
+    //! the same tile (call to war, retreat to the temple, ...), it should be used so that only one search
+    //! is done for all of them. Fields are kept until the passability changes
+    std::list<Tile*> pathToSharedTarget(const Creature* creature, Tile* destination);
+
+    //! \brief Returns the digging cost for the workers of seat to go from source to target (see DigCostField) or
+    //! DigCostField::NO_WAY if target cannot be reached, even by digging. worker is used to know the walkable tiles.
+    //! If preferGold is true, gold tiles are the cheapest to dig. The cost fields are cached by seat and source and
+    //! follow the map changes so that asking for several targets from the same source is cheap
+    uint32_t getDigCost(const Creature& worker, Seat* seat, Tile* source, Tile* target, bool preferGold);
+
+    //! \brief Fills tilesToDig with the tiles to dig (or already marked for digging), starting from the source side,
+    //! for the workers of seat to go from source to target with the lowest digging cost. Returns false if target
+    //! cannot be reached. Parameters are the same as for getDigCost
+    bool findTilesToDig(const Creature& worker, Seat* seat, Tile* source, Tile* target, bool preferGold,
+        std::vector<Tile*>& tilesToDig);
+
+    //! \brief Clears the paths cached by path() and the flow fields. The cache is already cleared at each turn and when
+    //! a tile change may change the paths (see TileContainer::getPassabilityVersion) so this
+    //! should only be needed when creatures are allowed through different tiles without any tile change
+    void invalidatePathCache();
+
+    //! \brief Returns the approximate number of bytes used by each subsystem of the map (tiles, floodfill,
+    //! seat tile states, entities, pathfinding data). Only the data owned by this map is counted: the object
+    //! pools are shared by every game map of the process and are not included
+    std::vector<std::pair<std::string, uint64_t>> getMemoryUsage() const;
+
     //! \brief Loops over the visibleTiles and returns any creature/room/trap in those tiles allied with the given seat
     //! (or if enemyForce is true, is not allied)
     std::vector<GameEntity*> getVisibleForce(const std::vector<Tile*>& visibleTiles, Seat* seat, bool enemyForce);
@@ -612,12 +650,73 @@ private:
 
     std::vector<GameEntity*> mActiveObjects;
 
-    //! \brief Useless entities that need to be deleted. They will be deleted when processDeletionQueues is called
-    std::vector<GameEntity*> mEntitiesToDelete;
+    //! \brief Useless entities that need to be deleted. They will be deleted when processDeletionQueues is called.
+    //! For pooled entities, the handle allows to detect entities queued more than once
+    std::vector<std::pair<GameEntity*, ObjectPoolHandle>> mEntitiesToDelete;
 
     //! \brief Debug member used to know how many call to pathfinding has been made within the same turn.
     unsigned int mNumCallsTo_path;
 
+    //! \brief Key of the path cache. Paths only depend on the tiles, on the creature speed on each
+    //! tile type and on whether it is allowed through doors (that depends on its seat, on whether
+    //! it is fighting or fleeing and on whether it is a worker since workers use their own flood fill)
+    struct PathCacheKey
+    {
+        Tile* mStart;
+        Tile* mDestination;
+        int mCreatureSeatId;
+        int mSeatId;
+        double mMoveSpeedGround;
+        double mMoveSpeedWater;
+        double mMoveSpeedLava;
+        bool mIsWorker;
+        bool mIsFighting;
+        bool mThroughDiggableTiles;
+        //! \brief For paths through diggable tiles, the tile planes version when the path was computed. Claiming
+        //! a wall changes whether it can be dug but not the passability version the cache is cleared on
+        uint32_t mTilePlanesVersion;
+
+        bool operator<(const PathCacheKey& other) const;
+    };
+
+    //! \brief Paths computed during the current turn. Many creatures ask for the same paths in the
+    //! same turn (going to the same room, answering a call to war, ...)
+    std::map<PathCacheKey, std::list<Tile*>> mPathCache;
+    int64_t mPathCacheTurn;
+    uint32_t mPathCachePassabilityVersion;
+    uint32_t mNbPathCacheHits;
+    uint32_t mNbPathCacheMisses;
+
+    //! \brief Flow fields used by pathToSharedTarget(). The key is the same as for the path cache without the start tile
+    std::map<PathCacheKey, std::unique_ptr<FlowField>> mFlowFields;
+    uint32_t mFlowFieldsPassabilityVersion;
+    uint32_t mNbFlowFieldsBuilt;
+    uint32_t mNbFlowFieldPaths;
+
+    static const uint32_t MAX_FLOW_FIELDS = 16;
+
+    //! \brief Fields used by getDigCost() and findTilesToDig(). The key is the seat id, the source tile
+    //! and whether gold is preferred
+    std::map<std::tuple<int, const Tile*, bool>, std::unique_ptr<DigCostField>> mDigCostFields;
+
+    static const uint32_t MAX_DIG_COST_FIELDS = 16;
+
+    //! \brief Returns the dig cost field for the given parameters, up to date with the map. Returns nullptr
+    //! if the parameters are not valid
+    DigCostField* getDigCostField(const Creature& worker, Seat* seat, Tile* source, bool preferGold);
+
+    //! \brief Threads used by queueSeatNotifications. They are kept from one turn to the next
+    std::unique_ptr<ThreadPool> mSeatNotificationThreads;
+
+    //! \brief Calls build on every seat played by a human and queues the returned notifications. Seats are
+    //! processed concurrently: build only writes the seat own state and keeps the changes to shared buildings
+    //! for later. These changes are applied and the notifications are queued in the seat order once every
+    //! seat is done so that the result and the messages sent to clients are deterministic
+    void queueSeatNotifications(ServerNotification* (Seat::*build)());
+
+    PathCacheKey getPathCacheKey(Tile* start, Tile* destination, const Creature& creature,
+        Seat* seat, bool throughDiggableTiles) const;
+
     std::vector<RenderedMovableEntity*> mRenderedMovableEntities;
 
     std::vector<Spell*> mSpells;
@@ -631,10 +730,18 @@ private:
     const TileSet* mTileSet;
     std::string mTileSetName;
 
+
+    //! \brief Computes the path between (x1, y1) and (x2, y2) with A*. See path()
+    std::list<Tile*> computePath(int x1, int y1, int x2, int y2, const Creature* creature, Seat* seat, bool throughDiggableTiles);
+
     //! \brief Updates different entities states.
     //! Updates active objects (creatures, rooms, ...), goals, count each team Workers, gold, mana and claimed tiles.
     unsigned long int doMiscUpkeep(double timeSinceLastTurn);
 
+    //! \brief Checks the seats ledgers against a full scan of the creatures, rooms and tiles.
+    //! Differences are logged as errors. Used in debug builds
+    void checkSeatLedgers();
+
     //! \brief Resets the unique numbers
     void resetUniqueNumbers();
 };
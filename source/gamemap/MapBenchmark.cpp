@@ -0,0 +1,367 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/MapBenchmark.h"
+
+#include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
+#include "entities/Tile.h"
+#include "game/Player.h"
+#include "game/Seat.h"
+#include "gamemap/GameMap.h"
+#include "utils/ConfigManager.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <SFML/System/Clock.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+//! \brief Seed used to pick the tiles. It does not depend on the level so that the same level
+//! always gives the same picks
+const uint32_t BENCHMARK_SEED = 1337;
+
+const uint32_t NB_PATHS = 200;
+const uint32_t NB_BEST_PATHS = 100;
+const uint32_t NB_BEST_PATH_DESTS = 8;
+const uint32_t NB_FLOODFILLS = 5;
+const uint32_t NB_REGIONS = 200;
+const uint32_t NB_LINES = 1000;
+const uint32_t NB_DIGS = 50;
+const int REGION_RADIUS = 10;
+const int VISIBLE_RADIUSES[] = { 5, 10, 15 };
+
+//! \brief Level being benchmarked with the seats configured like in a game and a worker
+//! used as the creature walking the paths
+struct BenchmarkContext
+{
+    BenchmarkContext(GameMap& gameMap, Seat& seat, Creature& worker, const std::string& level) :
+        mGameMap(gameMap),
+        mSeat(seat),
+        mWorker(worker),
+        mLevel(level),
+        mRandom(BENCHMARK_SEED)
+    {}
+
+    GameMap& mGameMap;
+    Seat& mSeat;
+    Creature& mWorker;
+    std::string mLevel;
+    std::mt19937 mRandom;
+    //! \brief Tiles the worker can walk on
+    std::vector<Tile*> mGroundTiles;
+
+    //! \brief mt19937 outputs are the same on every platform while the standard distributions are not
+    inline uint32_t randomIndex(std::size_t size)
+    { return static_cast<uint32_t>(mRandom() % size); }
+
+    inline Tile* randomGroundTile()
+    { return mGroundTiles[randomIndex(mGroundTiles.size())]; }
+
+    //! \brief Picks a ground tile reachable from start. Returns nullptr if none is found after a few tries
+    Tile* randomReachableTile(Tile* start)
+    {
+        for(uint32_t i = 0; i < 20; ++i)
+        {
+            Tile* tile = randomGroundTile();
+            if((tile != start) && mGameMap.pathExists(&mWorker, start, tile))
+                return tile;
+        }
+        return nullptr;
+    }
+
+    void refreshGroundTiles()
+    {
+        mGroundTiles.clear();
+        for(int yy = 0; yy < mGameMap.getMapSizeY(); ++yy)
+        {
+            for(int xx = 0; xx < mGameMap.getMapSizeX(); ++xx)
+            {
+                Tile* tile = mGameMap.getTile(xx, yy);
+                if(tile->isFullTile())
+                    continue;
+                if(tile->getFloodFillValue(&mSeat, FloodFillType::ground) == Tile::NO_FLOODFILL)
+                    continue;
+
+                mGroundTiles.push_back(tile);
+            }
+        }
+    }
+
+    void addResult(std::vector<BenchmarkResult>& results, const std::string& benchmark, uint32_t runs,
+        const sf::Time& time, uint64_t checksum)
+    {
+        BenchmarkResult result;
+        result.mLevel = mLevel;
+        result.mBenchmark = benchmark;
+        result.mRuns = runs;
+        result.mTotalUs = time.asMicroseconds();
+        result.mChecksum = checksum;
+        results.push_back(result);
+    }
+};
+
+void benchmarkPath(BenchmarkContext& ctx, std::vector<BenchmarkResult>& results)
+{
+    std::vector<std::pair<Tile*, Tile*>> pairs;
+    for(uint32_t i = 0; i < NB_PATHS; ++i)
+    {
+        Tile* start = ctx.randomGroundTile();
+        Tile* dest = ctx.randomReachableTile(start);
+        if(dest != nullptr)
+            pairs.push_back(std::make_pair(start, dest));
+    }
+
+    uint64_t checksum = 0;
+    ctx.mGameMap.invalidatePathCache();
+    sf::Clock clock;
+    for(const std::pair<Tile*, Tile*>& pair : pairs)
+        checksum += ctx.mGameMap.path(pair.first, pair.second, &ctx.mWorker, &ctx.mSeat).size();
+
+    ctx.addResult(results, "path", pairs.size(), clock.getElapsedTime(), checksum);
+}
+
+void benchmarkFindBestPath(BenchmarkContext& ctx, std::vector<BenchmarkResult>& results)
+{
+    std::vector<std::pair<Tile*, std::vector<Tile*>>> searches;
+    for(uint32_t i = 0; i < NB_BEST_PATHS; ++i)
+    {
+        Tile* start = ctx.randomGroundTile();
+        std::vector<Tile*> dests;
+        for(uint32_t k = 0; k < NB_BEST_PATH_DESTS; ++k)
+        {
+            Tile* dest = ctx.randomReachableTile(start);
+            if(dest != nullptr)
+                dests.push_back(dest);
+        }
+        if(!dests.empty())
+            searches.push_back(std::make_pair(start, dests));
+    }
+
+    uint64_t checksum = 0;
+    ctx.mGameMap.invalidatePathCache();
+    sf::Clock clock;
+    for(const std::pair<Tile*, std::vector<Tile*>>& search : searches)
+    {
+        Tile* chosenTile = nullptr;
+        checksum += ctx.mGameMap.findBestPath(&ctx.mWorker, search.first, search.second, chosenTile).size();
+        if(chosenTile != nullptr)
+            checksum += static_cast<uint64_t>(chosenTile->getX() + chosenTile->getY() * ctx.mGameMap.getMapSizeX());
+    }
+
+    ctx.addResult(results, "findBestPath", searches.size(), clock.getElapsedTime(), checksum);
+}
+
+void benchmarkEnableFloodFill(BenchmarkContext& ctx, std::vector<BenchmarkResult>& results)
+{
+    sf::Clock clock;
+    for(uint32_t i = 0; i < NB_FLOODFILLS; ++i)
+        ctx.mGameMap.enableFloodFill();
+
+    sf::Time time = clock.getElapsedTime();
+    ctx.refreshGroundTiles();
+    ctx.addResult(results, "enableFloodFill", NB_FLOODFILLS, time, ctx.mGroundTiles.size());
+}
+
+void benchmarkVisibleTiles(BenchmarkContext& ctx, std::vector<BenchmarkResult>& results)
+{
+    for(int radius : VISIBLE_RADIUSES)
+    {
+        std::vector<Tile*> centers;
+        for(uint32_t i = 0; i < NB_REGIONS; ++i)
+            centers.push_back(ctx.randomGroundTile());
+
+        uint64_t checksum = 0;
+        sf::Clock clock;
+        for(Tile* tile : centers)
+            checksum += ctx.mGameMap.visibleTiles(tile->getX(), tile->getY(), radius).size();
+
+        ctx.addResult(results, "visibleTiles r" + Helper::toString(radius), centers.size(),
+            clock.getElapsedTime(), checksum);
+    }
+}
+
+void benchmarkCircularRegion(BenchmarkContext& ctx, std::vector<BenchmarkResult>& results)
+{
+    std::vector<Tile*> centers;
+    for(uint32_t i = 0; i < NB_REGIONS; ++i)
+        centers.push_back(ctx.randomGroundTile());
+
+    uint64_t checksum = 0;
+    sf::Clock clock;
+    for(Tile* tile : centers)
+        checksum += ctx.mGameMap.circularRegion(tile->getX(), tile->getY(), REGION_RADIUS).size();
+
+    ctx.addResult(results, "circularRegion r" + Helper::toString(REGION_RADIUS), centers.size(),
+        clock.getElapsedTime(), checksum);
+}
+
+void benchmarkTilesBetween(BenchmarkContext& ctx, std::vector<BenchmarkResult>& results)
+{
+    // Lines go between any tiles, not only ground ones
+    int mapSizeX = ctx.mGameMap.getMapSizeX();
+    int mapSizeY = ctx.mGameMap.getMapSizeY();
+    std::vector<int> coords;
+    for(uint32_t i = 0; i < NB_LINES; ++i)
+    {
+        coords.push_back(static_cast<int>(ctx.randomIndex(mapSizeX)));
+        coords.push_back(static_cast<int>(ctx.randomIndex(mapSizeY)));
+        coords.push_back(static_cast<int>(ctx.randomIndex(mapSizeX)));
+        coords.push_back(static_cast<int>(ctx.randomIndex(mapSizeY)));
+    }
+
+    uint64_t checksum = 0;
+    sf::Clock clock;
+    for(uint32_t i = 0; i + 3 < coords.size(); i += 4)
+    {
+        ctx.mGameMap.forEachTileBetween(coords[i], coords[i + 1], coords[i + 2], coords[i + 3], [&](Tile* tile)
+        {
+            // Like the vision checks, we look at the tiles
+            if(!tile->isFullTile())
+                ++checksum;
+            return true;
+        });
+    }
+
+    ctx.addResult(results, "forEachTileBetween", NB_LINES, clock.getElapsedTime(), checksum);
+}
+
+//! \brief Digs tiles next to the ground tiles. Each dig refreshes the floodfill for every seat.
+//! As the map is changed, this benchmark should be the last one
+void benchmarkDigFloodFill(BenchmarkContext& ctx, std::vector<BenchmarkResult>& results)
+{
+    std::vector<Tile*> tilesToDig;
+    for(uint32_t i = 0; (i < NB_DIGS * 20) && (tilesToDig.size() < NB_DIGS); ++i)
+    {
+        Tile* tile = ctx.randomGroundTile();
+        for(Tile* neigh : tile->getAllNeighbors())
+        {
+            if(!neigh->isFullTile())
+                continue;
+            if(!neigh->isDiggable(&ctx.mSeat))
+                continue;
+            if(std::find(tilesToDig.begin(), tilesToDig.end(), neigh) != tilesToDig.end())
+                continue;
+
+            tilesToDig.push_back(neigh);
+            break;
+        }
+    }
+
+    sf::Clock clock;
+    for(Tile* tile : tilesToDig)
+        tile->setFullness(0.0);
+
+    sf::Time time = clock.getElapsedTime();
+    ctx.refreshGroundTiles();
+    ctx.addResult(results, "refreshFloodFill digs", tilesToDig.size(), time, ctx.mGroundTiles.size());
+}
+} // namespace <none>
+
+namespace MapBenchmark
+{
+bool runLevel(const std::string& levelPath, std::vector<BenchmarkResult>& results)
+{
+    std::string level = boost::filesystem::path(levelPath).filename().string();
+    GameMap gameMap(true);
+    if(!gameMap.loadLevel(levelPath))
+    {
+        OD_LOG_ERR("Cannot load level=" + levelPath);
+        return false;
+    }
+
+    // The seats are configured like when a game is launched, every keeper being an inactive player
+    ConfigManager& config = ConfigManager::getSingleton();
+    const std::vector<std::string>& factions = config.getFactions();
+    Seat* benchmarkSeat = nullptr;
+    for(Seat* seat : gameMap.getSeats())
+    {
+        if(seat->isRogueSeat())
+            continue;
+
+        int32_t factionIndex = seat->getConfigFactionIndex();
+        if((factionIndex < 0) || (factionIndex >= static_cast<int32_t>(factions.size())))
+            factionIndex = 0;
+        seat->setFaction(factions[factionIndex]);
+
+        int32_t teamId = seat->getConfigTeamId();
+        if((teamId < 0) && !seat->getAvailableTeamIds().empty())
+            teamId = seat->getAvailableTeamIds().front();
+        seat->setTeamId(teamId);
+
+        Player* player = new Player(&gameMap, 0);
+        player->setNick("Benchmark " + Helper::toString(seat->getId()));
+        gameMap.addPlayer(player);
+        seat->setPlayer(player);
+        seat->setMapSize(gameMap.getMapSizeX(), gameMap.getMapSizeY());
+        if(benchmarkSeat == nullptr)
+            benchmarkSeat = seat;
+    }
+
+    if(benchmarkSeat == nullptr)
+    {
+        OD_LOG_ERR("No keeper seat in level=" + levelPath);
+        return false;
+    }
+
+    for(Seat* seat : gameMap.getSeats())
+        seat->initSeat();
+
+    // Like the server, the entities loaded with the level are set up once the seats are configured.
+    // Bridges need the floodfill computed by notifySeatsConfigured to be set up
+    gameMap.notifySeatsConfigured();
+    gameMap.createAllEntities();
+
+    const CreatureDefinition* workerDef = gameMap.getClassDescription(
+        config.getFactionWorkerClass(benchmarkSeat->getFaction()));
+    if(workerDef == nullptr)
+    {
+        OD_LOG_ERR("No worker class for faction=" + benchmarkSeat->getFaction());
+        return false;
+    }
+
+    // The worker is not added to the map. It is only used to know where paths can go
+    Creature* worker = new Creature(&gameMap, workerDef, benchmarkSeat);
+    BenchmarkContext ctx(gameMap, *benchmarkSeat, *worker, level);
+    ctx.refreshGroundTiles();
+    if(ctx.mGroundTiles.empty())
+    {
+        OD_LOG_ERR("No ground tile in level=" + levelPath);
+        delete worker;
+        return false;
+    }
+
+    OD_LOG_INF("Benchmarking level=" + level + ", size=" + Helper::toString(gameMap.getMapSizeX())
+        + "x" + Helper::toString(gameMap.getMapSizeY()) + ", ground tiles=" + Helper::toString(ctx.mGroundTiles.size()));
+
+    benchmarkPath(ctx, results);
+    benchmarkFindBestPath(ctx, results);
+    benchmarkEnableFloodFill(ctx, results);
+    benchmarkVisibleTiles(ctx, results);
+    benchmarkCircularRegion(ctx, results);
+    benchmarkTilesBetween(ctx, results);
+    benchmarkDigFloodFill(ctx, results);
+
+    delete worker;
+    return true;
+}
+} // namespace MapBenchmark
@@ -0,0 +1,38 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPBENCHMARK_H
+#define MAPBENCHMARK_H
+
+#include "utils/BenchmarkReport.h"
+
+#include <string>
+#include <vector>
+
+//! \brief Times the map algorithms used by the creatures and the AI (paths, floodfill, vision, lines)
+//! on levels loaded without rendering. The tiles used by each benchmark are picked with a fixed seed so
+//! that running twice on the same level does the same work. The game definitions are expected to be
+//! loaded and, as the game map sends its notifications through it, an ODServer has to exist (it does
+//! not need to be started).
+namespace MapBenchmark
+{
+    //! \brief Runs every benchmark on the given level and adds the results to results. Returns false
+    //! if the level cannot be loaded
+    bool runLevel(const std::string& levelPath, std::vector<BenchmarkResult>& results);
+}
+
+#endif // MAPBENCHMARK_H
@@ -239,7 +239,7 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
         gameMap.addTile(tile);
     }
 
-    gameMap.setAllFullnessAndNeighbors();
+    gameMap.setAllFullness();
 
     // Read in the rooms
     levelFile >> nextParam;
@@ -184,10 +184,7 @@ MiniMapDrawnFullPixel getPixelValueFromTile(Seat& playerSeat, Tile& tile)
     return value;
 }
 
-void colourFromPixelValue(MiniMapDrawnFullPixel pixelValue, Seat* seatIfClaimed,
-        Ogre::HardwarePixelBufferSharedPtr pixelBuffer, Ogre::PixelBox pixelBox,
-        uint32_t minimapWidth, uint32_t minimapHeight, uint32_t minimapXMin,
-        uint32_t minimapXMax, uint32_t minimapYMin, uint32_t minimapYMax)
+uint32_t colourFromPixelValue(MiniMapDrawnFullPixel pixelValue, Seat* seatIfClaimed)
 {
     Ogre::uint8 RR = 0x00;
     Ogre::uint8 GG = 0x00;
@@ -307,23 +304,7 @@ void colourFromPixelValue(MiniMapDrawnFullPixel pixelValue, Seat* seatIfClaimed,
         }
     }
 
-    pixelBuffer->lock(pixelBox, Ogre::HardwareBuffer::HBL_NORMAL);
-    for(uint32_t x = minimapXMin; x < minimapXMax; ++x)
-    {
-        for(uint32_t y = minimapYMin; y < minimapYMax; ++y)
-        {
-            Ogre::uint8* pDest = static_cast<Ogre::uint8*>(pixelBuffer->getCurrentLock().data) - 1;
-            pDest += (minimapWidth * (minimapHeight - y - 1) * 4);
-            pDest += (x * 4);
-
-            pDest++; //A, unused, shouldn't be here
-            // this is the order of colors I empirically found out to be working :)
-            *pDest++ = BB;  //B
-            *pDest++ = GG;  //G
-            *pDest++ = RR;  //R
-        }
-    }
-    pixelBuffer->unlock();
+    return (static_cast<uint32_t>(RR) << 16) | (static_cast<uint32_t>(GG) << 8) | static_cast<uint32_t>(BB);
 }
 }
 
@@ -335,7 +316,6 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
     mTopLeftCornerY(0),
     mWidth(static_cast<unsigned int>(mMiniMapWindow->getPixelSize().d_width)),
     mHeight(static_cast<unsigned int>(mMiniMapWindow->getPixelSize().d_height)),
-    mPixelBox(mWidth, mHeight, 1, Ogre::PF_R8G8B8),
     mMiniMapOgreTexture(Ogre::TextureManager::getSingletonPtr()->createManual(
             "miniMapOgreTexture",
             Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
@@ -344,6 +324,8 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
             Ogre::TU_DYNAMIC_WRITE_ONLY)),
     mPixelBuffer(mMiniMapOgreTexture->getBuffer())
 {
+    mRaster.resize(mWidth, mHeight);
+
     uint32_t tileXMax = mGameMap.getMapSizeX();
     uint32_t tileYMax = mGameMap.getMapSizeY();
     uint32_t tileX = 0;
@@ -420,6 +402,7 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
     mMiniMapWindow->setProperty("Image", CEGUI::PropertyHelper<CEGUI::Image*>::toString(&imageset));
 
     mMiniMapOgreTexture->load();
+    uploadDirtyRect();
 
     mTopLeftCornerX = mMiniMapWindow->getUnclippedOuterRect().get().getPosition().d_x;
     mTopLeftCornerY = mMiniMapWindow->getUnclippedOuterRect().get().getPosition().d_y;
@@ -498,69 +481,13 @@ void MiniMapDrawnFull::updateTileState(uint32_t minimapXMin, uint32_t minimapXMa
         }
     }
 
-    // We paint corresponding pixels
-    colourFromPixelValue(curValue, seatIfClaimed, mPixelBuffer, mPixelBox,
-        mWidth, mHeight, minimapXMin, minimapXMax, minimapYMin, minimapYMax);
-}
-
-bool MiniMapDrawnFull::crossSegment(const Ogre::Vector3& p1, const Ogre::Vector3& p2,
-        uint32_t xMin, uint32_t xMax, uint32_t yMin, uint32_t yMax)
-{
-    if((p1.x < static_cast<Ogre::Real>(xMin)) &&
-       (p2.x < static_cast<Ogre::Real>(xMin)))
-    {
-        return false;
-    }
-    if((p1.x > static_cast<Ogre::Real>(xMax)) &&
-       (p2.x > static_cast<Ogre::Real>(xMax)))
-    {
-        return false;
-    }
-
-    if((p1.y < static_cast<Ogre::Real>(yMin)) &&
-       (p2.y < static_cast<Ogre::Real>(yMin)))
-    {
-        return false;
-    }
-    if((p1.y > static_cast<Ogre::Real>(yMax)) &&
-       (p2.y > static_cast<Ogre::Real>(yMax)))
-    {
-        return false;
-    }
-
-    Ogre::Real diffYPoints = p2.y - p1.y;
-    Ogre::Real diffXPoints = p2.x - p1.x;
-    Ogre::Real diffYMin = p2.y - static_cast<Ogre::Real>(yMin);
-    Ogre::Real diffXMin = p2.x - static_cast<Ogre::Real>(xMin);
-    Ogre::Real diffYMax = p2.y - static_cast<Ogre::Real>(yMax);
-    Ogre::Real diffXMax = p2.x - static_cast<Ogre::Real>(xMax);
-
-    // Magic number to change the size of the line
-    static const Ogre::Real DIFF_MIN = 5;
-    if(
-       (
-        (diffYMin * diffXPoints - diffYPoints * diffXMin - DIFF_MIN< 0) &&
-        (diffYMax * diffXPoints - diffYPoints * diffXMax + DIFF_MIN >= 0)
-       ) ||
-       (
-        (diffYMax * diffXPoints - diffYPoints * diffXMax - DIFF_MIN< 0) &&
-        (diffYMin * diffXPoints - diffYPoints * diffXMin + DIFF_MIN >= 0)
-       )
-      )
-    {
-        return true;
-    }
-
-    return false;
+    // We paint corresponding pixels. They will be uploaded with the next frame
+    mRaster.fillTileColour(minimapXMin, minimapXMax, minimapYMin, minimapYMax,
+        colourFromPixelValue(curValue, seatIfClaimed));
 }
 
 void MiniMapDrawnFull::update(Ogre::Real timeSinceLastFrame, const std::vector<Ogre::Vector3>& cornerTiles)
 {
-    const Ogre::Vector3& topRight = cornerTiles[0];
-    const Ogre::Vector3& topLeft = cornerTiles[1];
-    const Ogre::Vector3& bottomLeft = cornerTiles[2];
-    const Ogre::Vector3& bottomRight = cornerTiles[3];
-
     bool isSame = (mLastCornerTiles.size() == cornerTiles.size());
     static const Ogre::Real squareDiffMin = 0.5;
     for(uint32_t iii = 0; isSame && iii < mLastCornerTiles.size(); ++iii)
@@ -569,74 +496,51 @@ void MiniMapDrawnFull::update(Ogre::Real timeSinceLastFrame, const std::vector<O
         isSame &= (val <= squareDiffMin);
     }
 
-    if(isSame)
-        return;
-
-    // We save corner tiles
-    mLastCornerTiles = cornerTiles;
-
-    // We refresh the old rectangle
-    for(MiniMapDrawnFullTileStateListener* listener : mVisibleRectangle)
-    {
-        listener->fireTileStateChanged();
-    }
-    mVisibleRectangle.clear();
-
-    // And we paint the new visible rectangle
-    mPixelBuffer->lock(mPixelBox, Ogre::HardwareBuffer::HBL_NORMAL);
-
-    // we look for the tiles at the border of vision to paint them black
-    for(MiniMapDrawnFullTileStateListener* listener : mTileStateListeners)
+    if(!isSame)
     {
-        bool isInBorder = false;
-
-        // We check if the listener tiles are on the top line
-        if(!isInBorder &&
-            crossSegment(topRight, topLeft, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
-        }
-
-        if(!isInBorder &&
-            crossSegment(topLeft, bottomLeft, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
+        // We save corner tiles
+        mLastCornerTiles = cornerTiles;
+
+        // The frustum outline is drawn in minimap pixels over the tile colours
+        Ogre::Real gainX = static_cast<Ogre::Real>(mWidth) / static_cast<Ogre::Real>(mGameMap.getMapSizeX());
+        Ogre::Real gainY = static_cast<Ogre::Real>(mHeight) / static_cast<Ogre::Real>(mGameMap.getMapSizeY());
+        std::vector<std::pair<int, int>> corners;
+        corners.reserve(cornerTiles.size());
+        for(const Ogre::Vector3& corner : cornerTiles)
         {
-            isInBorder = true;
-        }
-
-        if(!isInBorder &&
-            crossSegment(bottomLeft, bottomRight, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
+            corners.push_back(std::make_pair(static_cast<int>(round(corner.x * gainX)),
+                static_cast<int>(round(corner.y * gainY))));
         }
+        mRaster.setFrustum(corners);
+    }
 
-        if(!isInBorder &&
-            crossSegment(bottomRight, topRight, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
-        }
+    uploadDirtyRect();
+}
 
-        if(!isInBorder)
-            continue;
+void MiniMapDrawnFull::uploadDirtyRect()
+{
+    uint32_t xMin;
+    uint32_t xMax;
+    uint32_t yMin;
+    uint32_t yMax;
+    if(!mRaster.takeDirtyRect(xMin, xMax, yMin, yMax))
+        return;
 
-        mVisibleRectangle.push_back(listener);
-        for(uint32_t xxx = listener->mMinimapXMin; xxx < listener->mMinimapXMax; ++xxx)
+    // Texture rows go from top to bottom while the minimap y goes from bottom to top
+    Ogre::Box box(xMin, mHeight - yMax, xMax, mHeight - yMin);
+    const Ogre::PixelBox& pixelBox = mPixelBuffer->lock(box, Ogre::HardwareBuffer::HBL_NORMAL);
+    Ogre::uint8* data = static_cast<Ogre::uint8*>(pixelBox.data);
+    for(uint32_t yyy = yMin; yyy < yMax; ++yyy)
+    {
+        Ogre::uint8* pDest = data + ((yMax - yyy - 1) * pixelBox.rowPitch * 4);
+        for(uint32_t xxx = xMin; xxx < xMax; ++xxx)
         {
-            for(uint32_t yyy = listener->mMinimapYMin; yyy < listener->mMinimapYMax; ++yyy)
-            {
-                Ogre::uint8* pDest = static_cast<Ogre::uint8*>(mPixelBuffer->getCurrentLock().data) - 1;
-                pDest += (mWidth * (mHeight - yyy - 1) * 4);
-                pDest += (xxx * 4);
-
-                pDest++; //A, unused, shouldn't be here
-                // this is the order of colors I empirically found out to be working :)
-                *pDest++ = 0x00;  //B
-                *pDest++ = 0x00;  //G
-                *pDest++ = 0x00;  //R
-            }
+            uint32_t colour = mRaster.getPixel(xxx, yyy);
+            // this is the order of colors I empirically found out to be working :)
+            *pDest++ = static_cast<Ogre::uint8>(colour & 0xFF);  //B
+            *pDest++ = static_cast<Ogre::uint8>((colour >> 8) & 0xFF);  //G
+            *pDest++ = static_cast<Ogre::uint8>((colour >> 16) & 0xFF);  //R
+            pDest++; //A, unused
         }
     }
     mPixelBuffer->unlock();
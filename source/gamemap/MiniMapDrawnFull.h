@@ -19,6 +19,7 @@
 #define MINIMAPDRAWNFULL_H_
 
 #include "gamemap/MiniMap.h"
+#include "gamemap/MiniMapRaster.h"
 
 #include <OgreHardwarePixelBuffer.h>
 #include <OgrePixelFormat.h>
@@ -60,10 +61,8 @@ public:
     Ogre::Vector2 camera_2dPositionFromClick(int xx, int yy) override;
 
 private:
-    //! \brief Returns true is the segment between p1 and p2 (using x and y only)
-    //! crosses the values within xMin, xMax, yMin and yMax
-    bool crossSegment(const Ogre::Vector3& p1, const Ogre::Vector3& p2,
-        uint32_t xMin, uint32_t xMax, uint32_t yMin, uint32_t yMax);
+    //! \brief Copies the pixels of mRaster that changed since the last upload to the texture
+    void uploadDirtyRect();
 
     CEGUI::Window* mMiniMapWindow;
 
@@ -72,8 +71,6 @@ private:
 
     std::vector<MiniMapDrawnFullTileStateListener*> mTileStateListeners;
 
-    std::vector<MiniMapDrawnFullTileStateListener*> mVisibleRectangle;
-
     std::vector<Ogre::Vector3> mLastCornerTiles;
 
     int mTopLeftCornerX;
@@ -83,7 +80,9 @@ private:
 
     Ogre::Vector2 mCamera_2dPosition;
 
-    Ogre::PixelBox mPixelBox;
+    //! \brief Tile colours and camera frustum outline. Tile state changes and camera moves
+    //! only update the raster. Its dirty rectangle is uploaded to the texture once per frame
+    MiniMapRaster mRaster;
     Ogre::TexturePtr mMiniMapOgreTexture;
     Ogre::HardwarePixelBufferSharedPtr mPixelBuffer;
 };
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/MiniMapRaster.h"
+
+#include "gamemap/TileLineWalker.h"
+
+#include <algorithm>
+
+const uint32_t MiniMapRaster::FRUSTUM_COLOUR = 0x000000;
+
+MiniMapRaster::MiniMapRaster() :
+    mWidth(0),
+    mHeight(0),
+    mDirtyXMin(0),
+    mDirtyXMax(0),
+    mDirtyYMin(0),
+    mDirtyYMax(0)
+{
+}
+
+void MiniMapRaster::resize(uint32_t width, uint32_t height)
+{
+    mWidth = width;
+    mHeight = height;
+    mTilePixels.assign(mWidth * mHeight, 0);
+    mFrustumPixels.assign(mWidth * mHeight, false);
+    mFrustumIndexes.clear();
+    clearDirtyRect();
+    markDirty(0, mWidth, 0, mHeight);
+}
+
+void MiniMapRaster::fillTileColour(uint32_t xMin, uint32_t xMax, uint32_t yMin, uint32_t yMax, uint32_t colour)
+{
+    xMax = std::min(xMax, mWidth);
+    yMax = std::min(yMax, mHeight);
+    bool changed = false;
+    for(uint32_t yy = yMin; yy < yMax; ++yy)
+    {
+        for(uint32_t xx = xMin; xx < xMax; ++xx)
+        {
+            uint32_t& pixel = mTilePixels[yy * mWidth + xx];
+            if(pixel == colour)
+                continue;
+
+            pixel = colour;
+            changed = true;
+        }
+    }
+
+    if(changed)
+        markDirty(xMin, xMax, yMin, yMax);
+}
+
+void MiniMapRaster::setFrustum(const std::vector<std::pair<int, int>>& corners)
+{
+    // We erase the previous outline
+    for(uint32_t index : mFrustumIndexes)
+    {
+        mFrustumPixels[index] = false;
+        uint32_t x = index % mWidth;
+        uint32_t y = index / mWidth;
+        markDirty(x, x + 1, y, y + 1);
+    }
+    mFrustumIndexes.clear();
+
+    if(corners.size() < 2)
+        return;
+
+    // Corners far outside the raster would only make us walk over pixels that are not displayed
+    int limitX = static_cast<int>(mWidth);
+    int limitY = static_cast<int>(mHeight);
+    TileLineWalker walker;
+    for(uint32_t i = 0; i < corners.size(); ++i)
+    {
+        const std::pair<int, int>& p1 = corners[i];
+        const std::pair<int, int>& p2 = corners[(i + 1) % corners.size()];
+        walker.reset(std::max(-limitX, std::min(p1.first, 2 * limitX)),
+            std::max(-limitY, std::min(p1.second, 2 * limitY)),
+            std::max(-limitX, std::min(p2.first, 2 * limitX)),
+            std::max(-limitY, std::min(p2.second, 2 * limitY)));
+        int x;
+        int y;
+        while(walker.next(x, y))
+        {
+            if(x < 0 || y < 0 || x >= limitX || y >= limitY)
+                continue;
+
+            uint32_t index = static_cast<uint32_t>(y) * mWidth + static_cast<uint32_t>(x);
+            if(mFrustumPixels[index])
+                continue;
+
+            mFrustumPixels[index] = true;
+            mFrustumIndexes.push_back(index);
+            markDirty(static_cast<uint32_t>(x), static_cast<uint32_t>(x) + 1,
+                static_cast<uint32_t>(y), static_cast<uint32_t>(y) + 1);
+        }
+    }
+}
+
+bool MiniMapRaster::takeDirtyRect(uint32_t& xMin, uint32_t& xMax, uint32_t& yMin, uint32_t& yMax)
+{
+    if(!hasDirtyRect())
+        return false;
+
+    xMin = mDirtyXMin;
+    xMax = mDirtyXMax;
+    yMin = mDirtyYMin;
+    yMax = mDirtyYMax;
+    clearDirtyRect();
+    return true;
+}
+
+void MiniMapRaster::markDirty(uint32_t xMin, uint32_t xMax, uint32_t yMin, uint32_t yMax)
+{
+    if((xMin >= xMax) || (yMin >= yMax))
+        return;
+
+    if(!hasDirtyRect())
+    {
+        mDirtyXMin = xMin;
+        mDirtyXMax = xMax;
+        mDirtyYMin = yMin;
+        mDirtyYMax = yMax;
+        return;
+    }
+
+    mDirtyXMin = std::min(mDirtyXMin, xMin);
+    mDirtyXMax = std::max(mDirtyXMax, xMax);
+    mDirtyYMin = std::min(mDirtyYMin, yMin);
+    mDirtyYMax = std::max(mDirtyYMax, yMax);
+}
+
+void MiniMapRaster::clearDirtyRect()
+{
+    mDirtyXMin = 0;
+    mDirtyXMax = 0;
+    mDirtyYMin = 0;
+    mDirtyYMax = 0;
+}
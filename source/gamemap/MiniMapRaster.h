@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MINIMAPRASTER_H
+#define MINIMAPRASTER_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//! \brief CPU side image of the minimap. It is made of 2 layers: the tile colours, updated when
+//! tiles change, and the camera frustum outline drawn over them. Every change extends a dirty
+//! rectangle so that only the pixels that changed since the last upload have to be copied to the
+//! texture. Colours are stored as 0xRRGGBB.
+//! Like the minimap texture, y goes from the bottom (0) to the top (height - 1).
+class MiniMapRaster
+{
+public:
+    static const uint32_t FRUSTUM_COLOUR;
+
+    MiniMapRaster();
+
+    //! \brief Sets the raster size. Every pixel is set to black and the whole raster is dirty
+    void resize(uint32_t width, uint32_t height);
+
+    inline uint32_t getWidth() const
+    { return mWidth; }
+
+    inline uint32_t getHeight() const
+    { return mHeight; }
+
+    //! \brief Sets the tile colour of the pixels within [xMin, xMax[ x [yMin, yMax[. The dirty
+    //! rectangle is only extended if at least one pixel changed
+    void fillTileColour(uint32_t xMin, uint32_t xMax, uint32_t yMin, uint32_t yMax, uint32_t colour);
+
+    //! \brief Draws the frustum outline as the closed polygon going through the given corners
+    //! (in pixels). The previous outline is erased. Pixels outside the raster are ignored
+    void setFrustum(const std::vector<std::pair<int, int>>& corners);
+
+    //! \brief Returns the colour to display at the given position
+    inline uint32_t getPixel(uint32_t x, uint32_t y) const
+    {
+        uint32_t index = y * mWidth + x;
+        if(mFrustumPixels[index])
+            return FRUSTUM_COLOUR;
+
+        return mTilePixels[index];
+    }
+
+    inline bool hasDirtyRect() const
+    { return (mDirtyXMin < mDirtyXMax) && (mDirtyYMin < mDirtyYMax); }
+
+    //! \brief If some pixels changed since the last call, returns true and sets the rectangle
+    //! containing them (xMax and yMax excluded). The dirty rectangle is then cleared
+    bool takeDirtyRect(uint32_t& xMin, uint32_t& xMax, uint32_t& yMin, uint32_t& yMax);
+
+private:
+    uint32_t mWidth;
+    uint32_t mHeight;
+
+    std::vector<uint32_t> mTilePixels;
+    std::vector<bool> mFrustumPixels;
+    //! \brief Indexes of the pixels set in mFrustumPixels so that the outline can be erased
+    //! without going through the whole raster
+    std::vector<uint32_t> mFrustumIndexes;
+
+    uint32_t mDirtyXMin;
+    uint32_t mDirtyXMax;
+    uint32_t mDirtyYMin;
+    uint32_t mDirtyYMax;
+
+    void markDirty(uint32_t xMin, uint32_t xMax, uint32_t yMin, uint32_t yMax);
+
+    void clearDirtyRect();
+};
+
+#endif // MINIMAPRASTER_H
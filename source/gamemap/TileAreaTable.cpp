@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/TileAreaTable.h"
+
+#include "gamemap/TileBitPlane.h"
+
+#include <algorithm>
+
+TileAreaTable::TileAreaTable() :
+    mSizeX(0),
+    mSizeY(0),
+    mPlane(nullptr),
+    mPlaneVersion(0)
+{
+}
+
+bool TileAreaTable::update(const TileBitPlane& plane)
+{
+    if((mPlane == &plane) &&
+       (mPlaneVersion == plane.getVersion()) &&
+       (mSizeX == plane.getSizeX()) &&
+       (mSizeY == plane.getSizeY()))
+    {
+        return false;
+    }
+
+    mPlane = &plane;
+    mPlaneVersion = plane.getVersion();
+    mSizeX = plane.getSizeX();
+    mSizeY = plane.getSizeY();
+    mSums.assign((mSizeX + 1) * (mSizeY + 1), 0);
+
+    int width = mSizeX + 1;
+    for(int yy = 0; yy < mSizeY; ++yy)
+    {
+        uint32_t rowSum = 0;
+        for(int xx = 0; xx < mSizeX; ++xx)
+        {
+            if(plane.get(xx, yy))
+                ++rowSum;
+
+            mSums[(yy + 1) * width + xx + 1] = mSums[yy * width + xx + 1] + rowSum;
+        }
+    }
+
+    return true;
+}
+
+uint32_t TileAreaTable::count(int x, int y, int width, int height) const
+{
+    int x1 = std::max(x, 0);
+    int y1 = std::max(y, 0);
+    int x2 = std::min(x + width, mSizeX);
+    int y2 = std::min(y + height, mSizeY);
+    if((x1 >= x2) || (y1 >= y2))
+        return 0;
+
+    return sumAt(x2, y2) + sumAt(x1, y1) - sumAt(x1, y2) - sumAt(x2, y1);
+}
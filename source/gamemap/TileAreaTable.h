@@ -0,0 +1,64 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILEAREATABLE_H
+#define TILEAREATABLE_H
+
+#include <cstdint>
+#include <vector>
+
+class TileBitPlane;
+
+//! \brief Summed-area table built from a TileBitPlane. It allows to count the set tiles
+//! within any rectangle in constant time. The table is only rebuilt when the plane
+//! it was built from has changed.
+class TileAreaTable
+{
+public:
+    TileAreaTable();
+
+    //! \brief Rebuilds the table from the given plane if it changed since the last update.
+    //! Returns true if the table has been rebuilt
+    bool update(const TileBitPlane& plane);
+
+    //! \brief Returns the number of set tiles within the rectangle starting at (x, y) (included)
+    //! and of size width x height. The parts of the rectangle outside the map are ignored
+    uint32_t count(int x, int y, int width, int height) const;
+
+    inline int getSizeX() const
+    { return mSizeX; }
+
+    inline int getSizeY() const
+    { return mSizeY; }
+
+private:
+    int mSizeX;
+    int mSizeY;
+
+    //! \brief The plane the table was built from and its version at that time
+    const TileBitPlane* mPlane;
+    uint32_t mPlaneVersion;
+
+    //! \brief mSums[y * (mSizeX + 1) + x] is the number of set tiles with
+    //! coordinates lower than (x, y)
+    std::vector<uint32_t> mSums;
+
+    inline uint32_t sumAt(int x, int y) const
+    { return mSums[y * (mSizeX + 1) + x]; }
+};
+
+#endif // TILEAREATABLE_H
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/TileBitPlane.h"
+
+#include <algorithm>
+#include <bitset>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+std::atomic<uint32_t> TileBitPlane::sLastVersion(0);
+
+TileBitPlane::TileBitPlane() :
+    mSizeX(0),
+    mSizeY(0),
+    mVersion(++sLastVersion)
+{
+}
+
+void TileBitPlane::resize(int sizeX, int sizeY)
+{
+    mVersion = ++sLastVersion;
+    if(sizeX <= 0 || sizeY <= 0)
+    {
+        mSizeX = 0;
+        mSizeY = 0;
+        mWords.clear();
+        return;
+    }
+
+    mSizeX = sizeX;
+    mSizeY = sizeY;
+    uint32_t nbBits = static_cast<uint32_t>(mSizeX * mSizeY);
+    mWords.assign((nbBits + BITS_PER_WORD - 1) / BITS_PER_WORD, 0);
+}
+
+void TileBitPlane::clear()
+{
+    mVersion = ++sLastVersion;
+    std::fill(mWords.begin(), mWords.end(), 0);
+}
+
+void TileBitPlane::setAll()
+{
+    mVersion = ++sLastVersion;
+    for(uint32_t i = 0; i < mWords.size(); ++i)
+        mWords[i] = validMask(i);
+}
+
+uint32_t TileBitPlane::count() const
+{
+    uint32_t nb = 0;
+    for(uint64_t word : mWords)
+        nb += popCount(word);
+
+    return nb;
+}
+
+uint32_t TileBitPlane::countIntersection(const TileBitPlane& other) const
+{
+    if(other.mWords.size() != mWords.size())
+        return 0;
+
+    uint32_t nb = 0;
+    for(uint32_t i = 0; i < mWords.size(); ++i)
+        nb += popCount(mWords[i] & other.mWords[i]);
+
+    return nb;
+}
+
+bool TileBitPlane::empty() const
+{
+    for(uint64_t word : mWords)
+    {
+        if(word != 0)
+            return false;
+    }
+
+    return true;
+}
+
+uint64_t TileBitPlane::validMask(uint32_t wordIndex) const
+{
+    uint32_t nbBits = static_cast<uint32_t>(mSizeX * mSizeY);
+    uint32_t firstBit = wordIndex * BITS_PER_WORD;
+    if(firstBit + BITS_PER_WORD <= nbBits)
+        return ~static_cast<uint64_t>(0);
+
+    return (static_cast<uint64_t>(1) << (nbBits - firstBit)) - 1;
+}
+
+uint32_t TileBitPlane::lowestBitIndex(uint64_t word)
+{
+#if defined(__GNUC__)
+    return static_cast<uint32_t>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<uint32_t>(index);
+#else
+    uint32_t index = 0;
+    while((word & 1) == 0)
+    {
+        word >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+uint32_t TileBitPlane::popCount(uint64_t word)
+{
+#if defined(__GNUC__)
+    return static_cast<uint32_t>(__builtin_popcountll(word));
+#else
+    return static_cast<uint32_t>(std::bitset<64>(word).count());
+#endif
+}
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILEBITPLANE_H
+#define TILEBITPLANE_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+//! \brief Packed bitset storing one boolean property per tile of the map.
+//! Bits are stored row by row (y major, then x) in 64 bits words so that whole
+//! map queries (counts, intersections, scans) work on words instead of going
+//! through every Tile object. Iterating over set bits returns tiles in the same
+//! order as a for jj / for ii loop over the map.
+class TileBitPlane
+{
+public:
+    TileBitPlane();
+
+    //! \brief Sets the plane size. Every bit is cleared.
+    void resize(int sizeX, int sizeY);
+
+    //! \brief Clears every bit
+    void clear();
+
+    //! \brief Sets every bit
+    void setAll();
+
+    inline int getSizeX() const
+    { return mSizeX; }
+
+    inline int getSizeY() const
+    { return mSizeY; }
+
+    //! \brief Returns a value changed each time the plane changes. It allows data computed
+    //! from the plane to know when they have to be refreshed. Versions are unique among
+    //! all the planes so that a plane cannot be mistaken for another one
+    inline uint32_t getVersion() const
+    { return mVersion; }
+
+    //! \brief Returns the value for the given position. Positions outside the plane are unset
+    inline bool get(int x, int y) const
+    {
+        if(x < 0 || y < 0 || x >= mSizeX || y >= mSizeY)
+            return false;
+
+        uint32_t index = static_cast<uint32_t>(y * mSizeX + x);
+        return (mWords[index / BITS_PER_WORD] & (static_cast<uint64_t>(1) << (index % BITS_PER_WORD))) != 0;
+    }
+
+    //! \brief Sets the value for the given position. Positions outside the plane are ignored.
+    //! Returns true if the value has changed
+    inline bool set(int x, int y, bool value)
+    {
+        if(x < 0 || y < 0 || x >= mSizeX || y >= mSizeY)
+            return false;
+
+        uint32_t index = static_cast<uint32_t>(y * mSizeX + x);
+        uint64_t mask = static_cast<uint64_t>(1) << (index % BITS_PER_WORD);
+        uint64_t& word = mWords[index / BITS_PER_WORD];
+        if(((word & mask) != 0) == value)
+            return false;
+
+        word ^= mask;
+        mVersion = ++sLastVersion;
+        return true;
+    }
+
+    //! \brief Returns the number of set bits
+    uint32_t count() const;
+
+    //! \brief Returns the number of bits set in both this plane and the given one.
+    //! Both planes are expected to have the same size
+    uint32_t countIntersection(const TileBitPlane& other) const;
+
+    //! \brief Returns true if no bit is set
+    bool empty() const;
+
+    //! \brief Calls func(x, y) for every set bit, row by row
+    template<typename Func>
+    void forEachSet(Func func) const
+    {
+        for(uint32_t i = 0; i < mWords.size(); ++i)
+            forEachBit(i, mWords[i], func);
+    }
+
+    //! \brief Calls func(x, y) for every bit set in both this plane and the given one
+    template<typename Func>
+    void forEachSetIntersection(const TileBitPlane& other, Func func) const
+    {
+        if(other.mWords.size() != mWords.size())
+            return;
+
+        for(uint32_t i = 0; i < mWords.size(); ++i)
+            forEachBit(i, mWords[i] & other.mWords[i], func);
+    }
+
+    //! \brief Calls func(x, y) for every unset bit, row by row
+    template<typename Func>
+    void forEachUnset(Func func) const
+    {
+        for(uint32_t i = 0; i < mWords.size(); ++i)
+            forEachBit(i, ~mWords[i] & validMask(i), func);
+    }
+
+    //! \brief Number of bytes allocated for the bits
+    inline uint64_t getMemoryUsage() const
+    { return mWords.capacity() * sizeof(uint64_t); }
+
+    //! \brief Returns the index of the lowest set bit of the given word. word must not be 0
+    static uint32_t lowestBitIndex(uint64_t word);
+
+    //! \brief Returns the number of bits set in the given word
+    static uint32_t popCount(uint64_t word);
+
+private:
+    static const uint32_t BITS_PER_WORD = 64;
+
+    //! \brief Planes of different seats are modified from different threads when building
+    //! the seat notifications
+    static std::atomic<uint32_t> sLastVersion;
+
+    int mSizeX;
+    int mSizeY;
+    uint32_t mVersion;
+    std::vector<uint64_t> mWords;
+
+    //! \brief Returns the mask of the bits of the given word that correspond to a tile
+    uint64_t validMask(uint32_t wordIndex) const;
+
+    template<typename Func>
+    inline void forEachBit(uint32_t wordIndex, uint64_t word, Func& func) const
+    {
+        while(word != 0)
+        {
+            uint32_t index = wordIndex * BITS_PER_WORD + lowestBitIndex(word);
+            func(static_cast<int>(index % mSizeX), static_cast<int>(index / mSizeX));
+            // Clears the lowest set bit
+            word &= word - 1;
+        }
+    }
+};
+
+#endif // TILEBITPLANE_H
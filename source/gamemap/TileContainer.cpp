@@ -18,12 +18,14 @@
 #include "gamemap/TileContainer.h"
 
 #include "entities/Tile.h"
-
+#include "game/Seat.h"
 #include "network/ODPacket.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
-const std::vector<Tile*> EMPTY_TILES;
+#include <algorithm>
+
+const TileBitPlane EMPTY_TILE_PLANE;
 
 class TileDistance
 {
@@ -333,8 +335,14 @@ TileContainer::TileContainer(int initTileDistance):
     mMapSizeY(0),
     mRr(0),
     mTiles(nullptr),
-    mTileDistanceComputed(0)
+    mTileDistanceComputed(0),
+    mTileTypePlanes(static_cast<uint32_t>(TileType::countTileType)),
+    mPassableTilePlanes(static_cast<uint32_t>(FloodFillType::nbValues)),
+    mTilePlanesVersion(0),
+    mPassabilityVersion(0),
+    mNbFloodFillTeams(0)
 {
+    static_assert(NB_FLOODFILL_TYPES == static_cast<uint32_t>(FloodFillType::nbValues), "Wrong number of floodfill types");
     buildTileDistance(initTileDistance);
 }
 
@@ -361,6 +369,7 @@ void TileContainer::clearTiles()
     }
     mMapSizeX = 0;
     mMapSizeY = 0;
+    resizeTilePlanes();
 }
 
 bool TileContainer::addTile(Tile* t)
@@ -376,42 +385,14 @@ bool TileContainer::addTile(Tile* t)
             delete mTiles[x][y];
         }
         mTiles[x][y] = t;
+        refreshTilePlanes(*t);
+        refreshTileOccupiedPlane(*t);
         return true;
     }
 
     return false;
 }
 
-void TileContainer::setTileNeighbors(Tile *t)
-{
-    for (unsigned int i = 0; i < 2; ++i)
-    {
-        int tempX = t->getX(), tempY = t->getY();
-        switch (i)
-        {
-        case 0:
-            --tempX;
-            break;
-        case 1:
-            --tempY;
-            break;
-
-        default:
-            OD_LOG_ERR("Unknown neighbor index=" + Helper::toString(i));
-            continue;
-        }
-
-        // If the current neigbor tile exists, add the current tile as one of its
-        // neighbors and add it as one of the current tile's neighbors.
-        if (tempX >= 0 && tempY >= 0)
-        {
-            Tile *tempTile = getTile(tempX, tempY);
-            tempTile->addNeighbor(t);
-            t->addNeighbor(tempTile);
-        }
-    }
-}
-
 void TileContainer::tileToPacket(ODPacket& packet, Tile* tile) const
 {
     int32_t x = tile->getX();
@@ -473,9 +454,310 @@ bool TileContainer::allocateMapMemory(int xSize, int ySize)
         }
     }
 
+    resizeTilePlanes();
+
     return true;
 }
 
+void TileContainer::resizeTilePlanes()
+{
+    for(TileBitPlane& plane : mTileTypePlanes)
+        plane.resize(mMapSizeX, mMapSizeY);
+
+    mFullTilePlane.resize(mMapSizeX, mMapSizeY);
+    mClaimedTilePlanes.clear();
+    mClaimedTileCounts.clear();
+    mClaimedAnySeatPlane.resize(mMapSizeX, mMapSizeY);
+
+    for(TileBitPlane& plane : mPassableTilePlanes)
+        plane.resize(mMapSizeX, mMapSizeY);
+
+    mVisionTilePlane.resize(mMapSizeX, mMapSizeY);
+    mBuildingTilePlane.resize(mMapSizeX, mMapSizeY);
+    mOccupiedTilePlane.resize(mMapSizeX, mMapSizeY);
+    mMarkedForDiggingPlanes.clear();
+    resizeSeatPlanes(getNbSeatPlanes());
+    resizeFloodFillValues(mNbFloodFillTeams);
+    ++mTilePlanesVersion;
+    ++mPassabilityVersion;
+}
+
+void TileContainer::resizeSeatPlanes(uint32_t nbSeats)
+{
+    mTileChangedPlanes.resize(nbSeats);
+    for(TileBitPlane& plane : mTileChangedPlanes)
+    {
+        plane.resize(mMapSizeX, mMapSizeY);
+        // Every tile should be notified by default
+        plane.setAll();
+    }
+
+    mSeatVisionPlanes.resize(nbSeats);
+    for(TileBitPlane& plane : mSeatVisionPlanes)
+        plane.resize(mMapSizeX, mMapSizeY);
+}
+
+const TileBitPlane& TileContainer::getTileChangedPlane(uint32_t seatIndex) const
+{
+    if(seatIndex >= mTileChangedPlanes.size())
+        return EMPTY_TILE_PLANE;
+
+    return mTileChangedPlanes[seatIndex];
+}
+
+void TileContainer::setTileChangedForSeat(const Tile& tile, uint32_t seatIndex, bool changed)
+{
+    if(seatIndex >= mTileChangedPlanes.size())
+        return;
+
+    mTileChangedPlanes[seatIndex].set(tile.getX(), tile.getY(), changed);
+}
+
+void TileContainer::setTileChangedForAllSeats(const Tile& tile)
+{
+    for(TileBitPlane& plane : mTileChangedPlanes)
+        plane.set(tile.getX(), tile.getY(), true);
+}
+
+const TileBitPlane& TileContainer::getSeatVisionPlane(uint32_t seatIndex) const
+{
+    if(seatIndex >= mSeatVisionPlanes.size())
+        return EMPTY_TILE_PLANE;
+
+    return mSeatVisionPlanes[seatIndex];
+}
+
+bool TileContainer::setTileVisionForSeat(const Tile& tile, uint32_t seatIndex)
+{
+    if(seatIndex >= mSeatVisionPlanes.size())
+        return false;
+
+    return mSeatVisionPlanes[seatIndex].set(tile.getX(), tile.getY(), true);
+}
+
+void TileContainer::clearSeatVisionPlanes()
+{
+    for(TileBitPlane& plane : mSeatVisionPlanes)
+        plane.clear();
+}
+
+void TileContainer::resizeFloodFillValues(uint32_t nbTeams)
+{
+    mNbFloodFillTeams = nbTeams;
+    uint32_t nbTiles = static_cast<uint32_t>(mMapSizeX * mMapSizeY);
+    mFloodFillValues.assign(nbTeams * NB_FLOODFILL_TYPES * nbTiles, Tile::NO_FLOODFILL);
+    mWorkerFloodFill.resize(nbTiles, NB_FLOODFILL_TYPES, nbTeams);
+}
+
+void TileContainer::resetFloodFillValues()
+{
+    std::fill(mFloodFillValues.begin(), mFloodFillValues.end(), Tile::NO_FLOODFILL);
+    mWorkerFloodFill.setAllDirty();
+}
+
+TileBitPlane& TileContainer::getOrCreateSeatPlane(std::vector<TileBitPlane>& planes, int seatId)
+{
+    if(seatId >= static_cast<int>(planes.size()))
+    {
+        uint32_t oldSize = planes.size();
+        planes.resize(seatId + 1);
+        for(uint32_t i = oldSize; i < planes.size(); ++i)
+            planes[i].resize(mMapSizeX, mMapSizeY);
+    }
+
+    return planes[seatId];
+}
+
+void TileContainer::refreshTilePlanes(Tile& tile)
+{
+    if(mTiles == nullptr)
+        return;
+
+    int x = tile.getX();
+    int y = tile.getY();
+    // Tiles not yet added will be refreshed when added
+    if(getTile(x, y) != &tile)
+        return;
+
+    // Changes in types, fullness, buildings (bridges, doors) and vision (door locked state) may
+    // change where creatures can go. Claiming does not
+    bool passabilityChanged = false;
+    uint32_t typeIndex = static_cast<uint32_t>(tile.getType());
+    for(uint32_t i = 0; i < mTileTypePlanes.size(); ++i)
+        passabilityChanged = mTileTypePlanes[i].set(x, y, i == typeIndex) || passabilityChanged;
+
+    passabilityChanged = mFullTilePlane.set(x, y, tile.isFullTile()) || passabilityChanged;
+
+    bool hasChanged = passabilityChanged;
+    int seatId = -1;
+    if(tile.isClaimed() && (tile.getSeat() != nullptr))
+        seatId = tile.getSeat()->getId();
+
+    if(seatId >= 0)
+    {
+        getOrCreateSeatPlane(mClaimedTilePlanes, seatId);
+        mClaimedTileCounts.resize(mClaimedTilePlanes.size(), 0);
+    }
+
+    for(uint32_t i = 0; i < mClaimedTilePlanes.size(); ++i)
+    {
+        bool isClaimed = (static_cast<int>(i) == seatId);
+        if(!mClaimedTilePlanes[i].set(x, y, isClaimed))
+            continue;
+
+        hasChanged = true;
+        if(isClaimed)
+            ++mClaimedTileCounts[i];
+        else
+            --mClaimedTileCounts[i];
+    }
+
+    hasChanged = mClaimedAnySeatPlane.set(x, y, seatId >= 0) || hasChanged;
+
+    for(uint32_t i = 0; i < mPassableTilePlanes.size(); ++i)
+        passabilityChanged = mPassableTilePlanes[i].set(x, y, tile.isFloodFillPossible(nullptr, static_cast<FloodFillType>(i))) || passabilityChanged;
+
+    passabilityChanged = mVisionTilePlane.set(x, y, tile.permitsVision()) || passabilityChanged;
+    passabilityChanged = mBuildingTilePlane.set(x, y, tile.getCoveringBuilding() != nullptr) || passabilityChanged;
+
+    if(passabilityChanged)
+        ++mPassabilityVersion;
+
+    if(hasChanged || passabilityChanged)
+        ++mTilePlanesVersion;
+}
+
+void TileContainer::refreshTileOccupiedPlane(const Tile& tile)
+{
+    if(mTiles == nullptr)
+        return;
+
+    if(getTile(tile.getX(), tile.getY()) != &tile)
+        return;
+
+    mOccupiedTilePlane.set(tile.getX(), tile.getY(), tile.numEntitiesInTile() > 0);
+}
+
+void TileContainer::refreshTileMarkedForDiggingPlane(const Tile& tile, int seatId, bool marked)
+{
+    if(mTiles == nullptr)
+        return;
+
+    if(seatId < 0)
+        return;
+
+    if(getTile(tile.getX(), tile.getY()) != &tile)
+        return;
+
+    getOrCreateSeatPlane(mMarkedForDiggingPlanes, seatId).set(tile.getX(), tile.getY(), marked);
+}
+
+const TileBitPlane& TileContainer::getTileTypePlane(TileType type) const
+{
+    uint32_t index = static_cast<uint32_t>(type);
+    if(index >= mTileTypePlanes.size())
+    {
+        OD_LOG_ERR("Unexpected tile type=" + Helper::toString(index));
+        return EMPTY_TILE_PLANE;
+    }
+
+    return mTileTypePlanes[index];
+}
+
+const TileBitPlane& TileContainer::getClaimedTilePlane(int seatId) const
+{
+    if((seatId < 0) || (seatId >= static_cast<int>(mClaimedTilePlanes.size())))
+        return EMPTY_TILE_PLANE;
+
+    return mClaimedTilePlanes[seatId];
+}
+
+const TileBitPlane& TileContainer::getPassableTilePlane(FloodFillType type) const
+{
+    uint32_t index = static_cast<uint32_t>(type);
+    if(index >= mPassableTilePlanes.size())
+    {
+        OD_LOG_ERR("Unexpected floodfill type=" + Helper::toString(index));
+        return EMPTY_TILE_PLANE;
+    }
+
+    return mPassableTilePlanes[index];
+}
+
+const TileBitPlane& TileContainer::getMarkedForDiggingPlane(int seatId) const
+{
+    if((seatId < 0) || (seatId >= static_cast<int>(mMarkedForDiggingPlanes.size())))
+        return EMPTY_TILE_PLANE;
+
+    return mMarkedForDiggingPlanes[seatId];
+}
+
+uint32_t TileContainer::countClaimedTiles(int seatId) const
+{
+    if((seatId < 0) || (seatId >= static_cast<int>(mClaimedTileCounts.size())))
+        return 0;
+
+    return mClaimedTileCounts[seatId];
+}
+
+void TileContainer::sortNearestTiles(int x, int y, const TileBitPlane& plane, const TileBitPlane* mask,
+    uint32_t nb, int maxDistSquared, std::vector<std::pair<int, int>>& candidates) const
+{
+    auto addCandidate = [&](int xx, int yy)
+    {
+        int distSquared = (xx - x) * (xx - x) + (yy - y) * (yy - y);
+        if((maxDistSquared >= 0) && (distSquared > maxDistSquared))
+            return;
+
+        candidates.push_back(std::make_pair(distSquared, yy * mMapSizeX + xx));
+    };
+
+    if(mask != nullptr)
+        plane.forEachSetIntersection(*mask, addCandidate);
+    else
+        plane.forEachSet(addCandidate);
+
+    // Pairs are sorted by distance then by position index
+    if((nb > 0) && (nb < candidates.size()))
+    {
+        std::partial_sort(candidates.begin(), candidates.begin() + nb, candidates.end());
+        candidates.resize(nb);
+    }
+    else
+        std::sort(candidates.begin(), candidates.end());
+}
+
+std::vector<Tile*> TileContainer::findNearestTiles(int x, int y, const TileBitPlane& plane, const TileBitPlane* mask,
+    uint32_t nb, int maxDistSquared) const
+{
+    std::vector<std::pair<int, int>> candidates;
+    sortNearestTiles(x, y, plane, mask, nb, maxDistSquared, candidates);
+
+    std::vector<Tile*> tiles;
+    tiles.reserve(candidates.size());
+    for(const std::pair<int, int>& candidate : candidates)
+        tiles.push_back(getTile(candidate.second % mMapSizeX, candidate.second / mMapSizeX));
+
+    return tiles;
+}
+
+Tile* TileContainer::findNearestTile(int x, int y, const TileBitPlane& plane, const TileBitPlane* mask,
+    const std::function<bool(Tile*)>& filter) const
+{
+    std::vector<std::pair<int, int>> candidates;
+    sortNearestTiles(x, y, plane, mask, filter ? 0 : 1, -1, candidates);
+    for(const std::pair<int, int>& candidate : candidates)
+    {
+        Tile* tile = getTile(candidate.second % mMapSizeX, candidate.second / mMapSizeX);
+        if(filter && !filter(tile))
+            continue;
+
+        return tile;
+    }
+
+    return nullptr;
+}
+
 std::vector<Tile*> TileContainer::rectangularRegion(int x1, int y1, int x2, int y2)
 {
     std::vector<Tile*> returnList;
@@ -633,15 +915,6 @@ std::vector<Tile*> TileContainer::tilesBorderedByRegion(const std::vector<Tile*>
     return returnList;
 }
 
-const std::vector<Tile*>& TileContainer::neighborTiles(int x, int y) const
-{
-    Tile *tempTile = getTile(x, y);
-    if (tempTile == nullptr)
-        return EMPTY_TILES;
-
-    return tempTile->getAllNeighbors();
-}
-
 void TileContainer::buildTileDistance(int distance)
 {
     if(mTileDistanceComputed >= distance)
@@ -718,96 +991,6 @@ void TileContainer::buildTileDistance(int distance)
     mTileDistanceComputed = distance;
 }
 
-std::list<Tile*> TileContainer::tilesBetween(int x1, int y1, int x2, int y2) const
-{
-    std::list<Tile*> path;
-
-    double deltax = x2 - x1;
-    double deltay = y2 - y1;
-    // We don't have to check for deltay == 0 because if deltax > 0 and deltay == 0,
-    // we will never have std::abs(deltax) < std::abs(deltay) and, thus, we will
-    // never compute std::abs(deltax / deltay);
-    if(deltax == 0)
-    {
-        // Vertical line, no need to compute
-        int diffY = 1;
-        if(y1 > y2)
-            diffY = -1;
-
-        for(int y = y1; y != y2; y += diffY)
-        {
-            Tile* tile = getTile(x1, y);
-            if(tile == nullptr)
-                break;
-
-            path.push_back(tile);
-        }
-    }
-    else if(std::abs(deltax) >= std::abs(deltay))
-    {
-        double error = 0;
-        double deltaerr = std::abs(deltay / deltax);
-        int diffX = 1;
-        if(x1 > x2)
-            diffX = -1;
-
-        int diffY = 1;
-        if(y1 > y2)
-            diffY = -1;
-
-        int y = y1;
-        for(int x = x1; x != x2; x += diffX)
-        {
-            Tile* tile = getTile(x, y);
-            if(tile == nullptr)
-                break;
-
-            path.push_back(tile);
-            error += deltaerr;
-            if(error >= 0.5)
-            {
-                y += diffY;
-                error = error - 1.0;
-            }
-        }
-    }
-    else // if(std::abs(deltax) < std::abs(deltay))
-    {
-        double error = 0;
-        double deltaerr = std::abs(deltax / deltay);
-        int diffX = 1;
-        if(x1 > x2)
-            diffX = -1;
-
-        int diffY = 1;
-        if(y1 > y2)
-            diffY = -1;
-
-        int x = x1;
-        for(int y = y1; y != y2; y += diffY)
-        {
-            Tile* tile = getTile(x, y);
-            if(tile == nullptr)
-                break;
-
-            path.push_back(tile);
-            error += deltaerr;
-            if(error >= 0.5)
-            {
-                x += diffX;
-                error = error - 1.0;
-            }
-        }
-    }
-
-    // We add the last tile
-    Tile* tile = getTile(x2, y2);
-    if(tile != nullptr)
-        path.push_back(tile);
-
-    return path;
-}
-
 std::vector<Tile*> TileContainer::visibleTiles(int x, int y, int radius)
 {
     // To compute the tiles within this region, we use the symmetry of the square. That's why we mix tile x/y coordinate
@@ -969,3 +1152,43 @@ std::vector<Tile*> TileContainer::visibleTiles(int x, int y, int radius)
     }
     return returnList;
 }
+
+uint64_t TileContainer::getTilesMemoryUsage() const
+{
+    if(mTiles == nullptr)
+        return 0;
+
+    uint64_t bytes = static_cast<uint64_t>(mMapSizeX) * (sizeof(Tile**) + mMapSizeY * sizeof(Tile*));
+    for(int xx = 0; xx < mMapSizeX; ++xx)
+    {
+        for(int yy = 0; yy < mMapSizeY; ++yy)
+        {
+            if(mTiles[xx][yy] != nullptr)
+                bytes += mTiles[xx][yy]->getMemoryUsage();
+        }
+    }
+    return bytes;
+}
+
+uint64_t TileContainer::getFloodFillMemoryUsage() const
+{
+    return mFloodFillValues.capacity() * sizeof(uint32_t) + mWorkerFloodFill.getMemoryUsage();
+}
+
+uint64_t TileContainer::getTilePlanesMemoryUsage() const
+{
+    uint64_t bytes = mFullTilePlane.getMemoryUsage()
+        + mClaimedAnySeatPlane.getMemoryUsage()
+        + mVisionTilePlane.getMemoryUsage()
+        + mBuildingTilePlane.getMemoryUsage()
+        + mOccupiedTilePlane.getMemoryUsage()
+        + mClaimedTileCounts.capacity() * sizeof(uint32_t);
+    for(const std::vector<TileBitPlane>* planes : { &mTileTypePlanes, &mClaimedTilePlanes, &mPassableTilePlanes,
+        &mMarkedForDiggingPlanes, &mTileChangedPlanes, &mSeatVisionPlanes })
+    {
+        bytes += planes->capacity() * sizeof(TileBitPlane);
+        for(const TileBitPlane& plane : *planes)
+            bytes += plane.getMemoryUsage();
+    }
+    return bytes;
+}
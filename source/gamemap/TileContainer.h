@@ -18,7 +18,13 @@
 #ifndef TILECONTAINER_H
 #define TILECONTAINER_H
 
+#include "gamemap/TileBitPlane.h"
+#include "gamemap/TileLineWalker.h"
+#include "gamemap/TileNeighbors.h"
+#include "gamemap/WorkerFloodFill.h"
+
 #include <cassert>
+#include <functional>
 #include <list>
 #include <vector>
 
@@ -26,6 +32,7 @@ class ODPacket;
 class TileDistance;
 class Tile;
 
+enum class FloodFillType;
 enum class TileType;
 
 class TileContainer
@@ -41,9 +48,6 @@ public:
     //! \returns true if added.
     bool addTile(Tile* t);
 
-    //! \brief Adds the address of a new tile to be stored in this TileContainer.
-    void setTileNeighbors(Tile *t);
-
     //! \brief Returns a pointer to the tile at location (x, y) (const version).
     inline Tile* getTile(int xx, int yy) const
     {
@@ -57,6 +61,18 @@ public:
         }
     }
 
+    //! \brief Returns the (up to) 4 tiles sharing a side with the tile at (x, y). The order is
+    //! x - 1, y - 1, y + 1, x + 1
+    inline TileNeighbors getTileNeighbors(int xx, int yy) const
+    {
+        TileNeighbors neighbors;
+        neighbors.add(getTile(xx - 1, yy));
+        neighbors.add(getTile(xx, yy - 1));
+        neighbors.add(getTile(xx, yy + 1));
+        neighbors.add(getTile(xx + 1, yy));
+        return neighbors;
+    }
+
     //! \brief This functions exports the needed to retrieve a tile for networking.
     //! The tile informations are not embedded, only the needed to identify the tile
     void tileToPacket(ODPacket& packet, Tile* tile) const;
@@ -74,9 +90,6 @@ public:
     //! i.e. the "perimeter" of the region extended out one tile.
     std::vector<Tile*> tilesBorderedByRegion(const std::vector<Tile*> &region);
 
-    //! \brief Returns the (up to) 4 nearest neighbor tiles of the tile located at (x, y).
-    const std::vector<Tile*>& neighborTiles(int x, int y) const;
-
     //! \brief Gets the map size
     int getMapSizeX() const
     { return mMapSizeX; }
@@ -84,19 +97,164 @@ public:
     int getMapSizeY() const
     { return mMapSizeY; }
 
-    /*! \brief Returns a list of valid tiles along a straight line from (x1, y1) to (x2, y2)
-     * independently from their fullness or type.
+    /*! \brief Calls func(tile) for the tiles along a straight line from (x1, y1) to (x2, y2), both
+     * included, independently from their fullness or type. The walk stops at the first position
+     * outside the map or when func returns false, which allows to look for the first full tile, the first
+     * tile with an entity, ... without building the whole line.
+     * Returns the last tile func has been called for (nullptr if none).
      *
-     * This algorithm is from
-     * http://en.wikipedia.org/wiki/Bresenham%27s_line_algorithm
-     * A more detailed description of how it works can be found there.
+     * The tiles are computed with TileLineWalker (integer Bresenham). A more detailed description of
+     * how it works can be found at http://en.wikipedia.org/wiki/Bresenham%27s_line_algorithm
      */
-    std::list<Tile*> tilesBetween(int x1, int y1, int x2, int y2) const;
+    template<typename Func>
+    Tile* forEachTileBetween(int x1, int y1, int x2, int y2, Func func) const
+    {
+        Tile* lastTile = nullptr;
+        TileLineWalker walker(x1, y1, x2, y2);
+        int x;
+        int y;
+        while(walker.next(x, y))
+        {
+            Tile* tile = getTile(x, y);
+            if(tile == nullptr)
+                break;
+
+            lastTile = tile;
+            if(!func(tile))
+                break;
+        }
+        return lastTile;
+    }
 
     //! \brief Returns the tiles visible from the given start tile within radius. The tiles are ordered from the closest to
     //! the furthest
     std::vector<Tile*> visibleTiles(int x, int y, int radius);
 
+    //! \brief Refreshes the tile property planes (type, fullness, claiming, passability and vision)
+    //! for the given tile. Should be called each time one of these properties changes. Tiles that are
+    //! not yet added to the container are ignored
+    void refreshTilePlanes(Tile& tile);
+
+    //! \brief Refreshes the plane of the tiles having entities for the given tile. Should be called each
+    //! time an entity is added/removed from the tile
+    void refreshTileOccupiedPlane(const Tile& tile);
+
+    //! \brief Refreshes the plane of the tiles marked for digging by the seat with the given id
+    void refreshTileMarkedForDiggingPlane(const Tile& tile, int seatId, bool marked);
+
+    //! \brief Tile property planes. They allow whole map queries (counts, scans) without
+    //! going through every Tile object. They are kept up to date by refreshTilePlanes
+    const TileBitPlane& getTileTypePlane(TileType type) const;
+    inline const TileBitPlane& getFullTilePlane() const
+    { return mFullTilePlane; }
+    //! \brief Returns the tiles claimed by the seat with the given id
+    const TileBitPlane& getClaimedTilePlane(int seatId) const;
+    //! \brief Returns the tiles claimed by any seat
+    inline const TileBitPlane& getClaimedAnySeatPlane() const
+    { return mClaimedAnySeatPlane; }
+    //! \brief Returns the tiles where the given floodfill type is possible (see Tile::isFloodFillPossible)
+    const TileBitPlane& getPassableTilePlane(FloodFillType type) const;
+    inline const TileBitPlane& getVisionTilePlane() const
+    { return mVisionTilePlane; }
+    //! \brief Returns the tiles covered by a building
+    inline const TileBitPlane& getBuildingTilePlane() const
+    { return mBuildingTilePlane; }
+    inline const TileBitPlane& getOccupiedTilePlane() const
+    { return mOccupiedTilePlane; }
+    //! \brief Returns the tiles marked for digging by the seat with the given id
+    const TileBitPlane& getMarkedForDiggingPlane(int seatId) const;
+
+    //! \brief Sets the number of seats for the per seat planes below. They are indexed by Seat::getIndex().
+    //! Every tile is set as changed for every seat and vision is cleared
+    void resizeSeatPlanes(uint32_t nbSeats);
+
+    //! \brief Returns the tiles that changed since they were last sent to the seat with the given index
+    const TileBitPlane& getTileChangedPlane(uint32_t seatIndex) const;
+    //! \brief Sets if the given tile changed for the seat with the given index. Ignored if there is no
+    //! plane for this seat (for example on client side)
+    void setTileChangedForSeat(const Tile& tile, uint32_t seatIndex, bool changed);
+    //! \brief Sets the given tile as changed for every seat
+    void setTileChangedForAllSeats(const Tile& tile);
+
+    //! \brief Returns the tiles the seat with the given index has vision on during the current turn
+    const TileBitPlane& getSeatVisionPlane(uint32_t seatIndex) const;
+    //! \brief Gives vision on the given tile to the seat with the given index. Returns true if the seat
+    //! did not have vision on this tile yet and false otherwise (or if there is no plane for this seat)
+    bool setTileVisionForSeat(const Tile& tile, uint32_t seatIndex);
+    //! \brief Removes vision on every tile for every seat
+    void clearSeatVisionPlanes();
+
+    inline uint32_t getNbSeatPlanes() const
+    { return static_cast<uint32_t>(mTileChangedPlanes.size()); }
+
+    //! \brief Sets the number of teams for the floodfill values. Every value is reset to Tile::NO_FLOODFILL
+    void resizeFloodFillValues(uint32_t nbTeams);
+    //! \brief Sets every floodfill value to Tile::NO_FLOODFILL
+    void resetFloodFillValues();
+
+    inline uint32_t getNbFloodFillTeams() const
+    { return mNbFloodFillTeams; }
+
+    //! \brief Floodfill value for the given tile position, team index and floodfill type. Callers are
+    //! expected to check the team index against getNbFloodFillTeams()
+    inline uint32_t getFloodFillValue(int x, int y, uint32_t teamIndex, uint32_t intType) const
+    { return mFloodFillValues[floodFillIndex(x, y, teamIndex, intType)]; }
+
+    inline void setFloodFillValue(int x, int y, uint32_t teamIndex, uint32_t intType, uint32_t value)
+    {
+        uint32_t& floodFillValue = mFloodFillValues[floodFillIndex(x, y, teamIndex, intType)];
+        if(floodFillValue == value)
+            return;
+
+        floodFillValue = value;
+        mWorkerFloodFill.setTileDirty(static_cast<uint32_t>(y * mMapSizeX + x));
+    }
+
+    //! \brief Value of the workers floodfill layer (see WorkerFloodFill) for the given tile position and
+    //! floodfill type. Two tiles have the same value if workers can go from one to the other
+    inline uint32_t getWorkerFloodFillValue(int x, int y, uint32_t intType)
+    {
+        if(mWorkerFloodFill.isDirty())
+            mWorkerFloodFill.refresh(mFloodFillValues);
+
+        return mWorkerFloodFill.getValue(static_cast<uint32_t>(y * mMapSizeX + x), intType);
+    }
+
+    //! \brief Returns the number of tiles claimed by the seat with the given id. The count is kept
+    //! up to date when tiles are claimed or unclaimed so it does not depend on the map size
+    uint32_t countClaimedTiles(int seatId) const;
+
+    //! \brief Returns a value that changes each time a tile changes in one of the planes refreshed
+    //! by refreshTilePlanes. It allows to know if data computed from the tiles should be refreshed
+    inline uint32_t getTilePlanesVersion() const
+    { return mTilePlanesVersion; }
+
+    //! \brief Like getTilePlanesVersion but only changes when a tile change may change the paths
+    //! creatures can take (fullness, type, buildings and doors). Claiming tiles does not change it
+    inline uint32_t getPassabilityVersion() const
+    { return mPassabilityVersion; }
+
+    //! \brief Returns the tiles set in plane (and in mask if not nullptr) sorted by squared distance
+    //! to (x, y). Tiles at the same distance are sorted row by row. At most nb tiles are returned (no
+    //! limit if 0). If maxDistSquared is not negative, only the tiles within this distance are returned
+    std::vector<Tile*> findNearestTiles(int x, int y, const TileBitPlane& plane, const TileBitPlane* mask,
+        uint32_t nb, int maxDistSquared) const;
+
+    //! \brief Returns the closest tile to (x, y) set in plane (and in mask if not nullptr) for which filter
+    //! returns true (if filter is set). It can be used with GameMap::pathExists to find the closest tile within
+    //! a reachable floodfill region. Returns nullptr if there is no such tile
+    Tile* findNearestTile(int x, int y, const TileBitPlane& plane, const TileBitPlane* mask,
+        const std::function<bool(Tile*)>& filter) const;
+
+    //! \brief Approximate number of bytes used by the tiles (including what they allocate)
+    uint64_t getTilesMemoryUsage() const;
+
+    //! \brief Approximate number of bytes used by the floodfill values
+    uint64_t getFloodFillMemoryUsage() const;
+
+    //! \brief Approximate number of bytes used by the tile planes (including the per seat ones)
+    uint64_t getTilePlanesMemoryUsage() const;
+
 protected:
     //! \brief The map size
     int mMapSizeX;
@@ -118,6 +276,61 @@ private:
     //! \brief Stores the highest distance computed. If a bigger distance is asked, mTileDistance will have to be updated by
     //! calling buildTileDistance with the higher distance
     int mTileDistanceComputed;
+
+    //! \brief One plane per TileType
+    std::vector<TileBitPlane> mTileTypePlanes;
+    //! \brief Tiles with fullness > 0 (see Tile::isFullTile)
+    TileBitPlane mFullTilePlane;
+    //! \brief Claimed tiles. The index is the seat id. Planes are created when a tile is claimed by a new seat
+    std::vector<TileBitPlane> mClaimedTilePlanes;
+    //! \brief Number of bits set in each claimed plane, kept up to date when the planes change
+    std::vector<uint32_t> mClaimedTileCounts;
+    TileBitPlane mClaimedAnySeatPlane;
+    //! \brief One plane per FloodFillType
+    std::vector<TileBitPlane> mPassableTilePlanes;
+    //! \brief Tiles creatures can see through (see Tile::permitsVision)
+    TileBitPlane mVisionTilePlane;
+    TileBitPlane mBuildingTilePlane;
+    uint32_t mTilePlanesVersion;
+    uint32_t mPassabilityVersion;
+    //! \brief Tiles with at least one entity
+    TileBitPlane mOccupiedTilePlane;
+    //! \brief Tiles marked for digging. The index is the seat id
+    std::vector<TileBitPlane> mMarkedForDiggingPlanes;
+    //! \brief Tiles changed since they were last sent to each seat. The index is the seat index
+    std::vector<TileBitPlane> mTileChangedPlanes;
+    //! \brief Tiles each seat has vision on during the current turn. The index is the seat index
+    std::vector<TileBitPlane> mSeatVisionPlanes;
+
+    //! \brief Floodfill values for every team. Values of the same team and floodfill type are
+    //! contiguous so that whole map floodfill processing goes through memory in order
+    std::vector<uint32_t> mFloodFillValues;
+    uint32_t mNbFloodFillTeams;
+
+    //! \brief Workers floodfill layer. Tiles are set dirty when one of their floodfill values changes
+    //! and the layer is refreshed the first time it is used after that
+    WorkerFloodFill mWorkerFloodFill;
+
+    inline uint32_t floodFillIndex(int x, int y, uint32_t teamIndex, uint32_t intType) const
+    {
+        return (teamIndex * NB_FLOODFILL_TYPES + intType) * static_cast<uint32_t>(mMapSizeX * mMapSizeY)
+            + static_cast<uint32_t>(y * mMapSizeX + x);
+    }
+
+    //! \brief Must be equal to FloodFillType::nbValues (checked in TileContainer.cpp)
+    static const uint32_t NB_FLOODFILL_TYPES = 4;
+
+    //! \brief Resizes every plane to the map size and clears them
+    void resizeTilePlanes();
+
+    //! \brief Returns the plane for the given seat id from the given per seat planes. If it does
+    //! not exist yet, it is created
+    TileBitPlane& getOrCreateSeatPlane(std::vector<TileBitPlane>& planes, int seatId);
+
+    //! \brief Fills candidates with the squared distance and position index (y * mMapSizeX + x)
+    //! of the tiles matching the given planes, sorted by distance
+    void sortNearestTiles(int x, int y, const TileBitPlane& plane, const TileBitPlane* mask,
+        uint32_t nb, int maxDistSquared, std::vector<std::pair<int, int>>& candidates) const;
 };
 
 #endif //TILECONTAINER_H
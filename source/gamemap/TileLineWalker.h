@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILELINEWALKER_H
+#define TILELINEWALKER_H
+
+#include <cstdint>
+#include <cstdlib>
+
+//! \brief Iterates over the tile positions along a straight line from (x1, y1) to (x2, y2), both
+//! included, without allocating anything. It uses integer only Bresenham: the position moves by one
+//! tile on the major axis at each step and by one tile on the minor axis when the accumulated error
+//! reaches half a tile.
+//! The walker does not know about the map. Callers are expected to check the returned positions.
+class TileLineWalker
+{
+public:
+    //! \brief Creates a walker that returns no position
+    TileLineWalker() :
+        mX(0),
+        mY(0),
+        mDiffMajor(0),
+        mDiffMinor(0),
+        mStepMajorX(0),
+        mStepMajorY(0),
+        mStepMinorX(0),
+        mStepMinorY(0),
+        mError(0),
+        mNbStepsLeft(0)
+    {}
+
+    TileLineWalker(int x1, int y1, int x2, int y2)
+    {
+        reset(x1, y1, x2, y2);
+    }
+
+    //! \brief Restarts the walk on the given line
+    void reset(int x1, int y1, int x2, int y2)
+    {
+        int deltaX = x2 - x1;
+        int deltaY = y2 - y1;
+        int stepX = (deltaX < 0) ? -1 : 1;
+        int stepY = (deltaY < 0) ? -1 : 1;
+        mX = x1;
+        mY = y1;
+        mError = 0;
+        if(std::abs(deltaX) >= std::abs(deltaY))
+        {
+            mDiffMajor = std::abs(deltaX);
+            mDiffMinor = std::abs(deltaY);
+            mStepMajorX = stepX;
+            mStepMajorY = 0;
+            mStepMinorX = 0;
+            mStepMinorY = stepY;
+        }
+        else
+        {
+            mDiffMajor = std::abs(deltaY);
+            mDiffMinor = std::abs(deltaX);
+            mStepMajorX = 0;
+            mStepMajorY = stepY;
+            mStepMinorX = stepX;
+            mStepMinorY = 0;
+        }
+        mNbStepsLeft = mDiffMajor + 1;
+    }
+
+    //! \brief Sets x and y to the next position and returns true. Returns false if the
+    //! end of the line has already been returned
+    inline bool next(int& x, int& y)
+    {
+        if(mNbStepsLeft <= 0)
+            return false;
+
+        x = mX;
+        y = mY;
+        --mNbStepsLeft;
+
+        // The error is scaled by 2 * mDiffMajor so that it stays an integer: moving on the
+        // minor axis when error >= 0.5 tile is moving when mError >= mDiffMajor
+        mX += mStepMajorX;
+        mY += mStepMajorY;
+        mError += 2 * mDiffMinor;
+        if(mError >= mDiffMajor)
+        {
+            mX += mStepMinorX;
+            mY += mStepMinorY;
+            mError -= 2 * mDiffMajor;
+        }
+        return true;
+    }
+
+    //! \brief Returns the number of positions not returned yet
+    inline int getNbStepsLeft() const
+    { return mNbStepsLeft; }
+
+private:
+    int mX;
+    int mY;
+    int mDiffMajor;
+    int mDiffMinor;
+    int mStepMajorX;
+    int mStepMajorY;
+    int mStepMinorX;
+    int mStepMinorY;
+    int mError;
+    int mNbStepsLeft;
+};
+
+#endif // TILELINEWALKER_H
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILENEIGHBORS_H
+#define TILENEIGHBORS_H
+
+#include <array>
+#include <cstdint>
+
+class Tile;
+
+//! \brief The tiles sharing a side with a tile (up to 4). They are not stored in the tiles but
+//! computed from the map when needed (see TileContainer::getTileNeighbors), which saves a vector
+//! per tile on large maps. It can be iterated like a vector.
+class TileNeighbors
+{
+public:
+    static const uint32_t MAX_NEIGHBORS = 4;
+
+    TileNeighbors() :
+        mSize(0)
+    {}
+
+    //! \brief Adds the given tile if not nullptr
+    inline void add(Tile* tile)
+    {
+        if(tile != nullptr)
+            mTiles[mSize++] = tile;
+    }
+
+    inline Tile* const* begin() const
+    { return mTiles.data(); }
+
+    inline Tile* const* end() const
+    { return mTiles.data() + mSize; }
+
+    inline uint32_t size() const
+    { return mSize; }
+
+    inline bool empty() const
+    { return mSize == 0; }
+
+    inline Tile* operator[](uint32_t index) const
+    { return mTiles[index]; }
+
+    inline Tile* back() const
+    { return mTiles[mSize - 1]; }
+
+private:
+    std::array<Tile*, MAX_NEIGHBORS> mTiles;
+    uint32_t mSize;
+};
+
+#endif // TILENEIGHBORS_H
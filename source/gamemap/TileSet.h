@@ -26,7 +26,7 @@
 class Tile;
 
 enum class TileType;
-enum class TileVisual;
+enum class TileVisual : uint8_t;
 
 class TileSetValue
 {
@@ -0,0 +1,36 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/TileWindowPlane.h"
+
+TileWindowPlane::TileWindowPlane() :
+    mOriginX(0),
+    mOriginY(0)
+{
+}
+
+void TileWindowPlane::reset(int centerX, int centerY, int radius)
+{
+    mOriginX = centerX - radius;
+    mOriginY = centerY - radius;
+    int size = 2 * radius + 1;
+    // Most of the time, the window keeps the same size so we avoid reallocating it
+    if((mPlane.getSizeX() == size) && (mPlane.getSizeY() == size))
+        mPlane.clear();
+    else
+        mPlane.resize(size, size);
+}
@@ -0,0 +1,51 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILEWINDOWPLANE_H
+#define TILEWINDOWPLANE_H
+
+#include "gamemap/TileBitPlane.h"
+
+//! \brief TileBitPlane covering only a square window of the map centered on a given
+//! position. It is meant to be used alongside tile lists built around an entity (like
+//! the tiles a creature can see) to know in constant time if a tile belongs to the list
+//! without the memory cost of a whole map plane per entity.
+class TileWindowPlane
+{
+public:
+    TileWindowPlane();
+
+    //! \brief Centers the window on (centerX, centerY). It will cover every position within
+    //! radius tiles. Every bit is cleared
+    void reset(int centerX, int centerY, int radius);
+
+    //! \brief Returns the value for the given map position. Positions outside the window are unset
+    inline bool get(int x, int y) const
+    { return mPlane.get(x - mOriginX, y - mOriginY); }
+
+    //! \brief Sets the given map position. Positions outside the window are ignored
+    inline void set(int x, int y)
+    { mPlane.set(x - mOriginX, y - mOriginY, true); }
+
+private:
+    //! \brief Map position of the first tile of the window
+    int mOriginX;
+    int mOriginY;
+    TileBitPlane mPlane;
+};
+
+#endif // TILEWINDOWPLANE_H
@@ -0,0 +1,113 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/WorkerFloodFill.h"
+
+WorkerFloodFill::WorkerFloodFill() :
+    mNbTiles(0),
+    mNbTypes(0),
+    mNbTeams(0),
+    mIsAllDirty(true)
+{
+}
+
+std::size_t WorkerFloodFill::KeyHash::operator()(const std::vector<uint32_t>& key) const
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for(uint32_t value : key)
+    {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+void WorkerFloodFill::resize(uint32_t nbTiles, uint32_t nbTypes, uint32_t nbTeams)
+{
+    mNbTiles = nbTiles;
+    mNbTypes = nbTypes;
+    mNbTeams = nbTeams;
+    mValues.assign(mNbTiles * mNbTypes, 0);
+    mIsTileDirty.assign(mNbTiles, false);
+    setAllDirty();
+}
+
+void WorkerFloodFill::setAllDirty()
+{
+    mIsAllDirty = true;
+    for(uint32_t tileIndex : mDirtyTiles)
+        mIsTileDirty[tileIndex] = false;
+    mDirtyTiles.clear();
+}
+
+void WorkerFloodFill::refresh(const std::vector<uint32_t>& teamValues)
+{
+    // Combinations are never removed when tiles change. When there are many more than the
+    // tiles can use, we start again from an empty list
+    if(mCombinationValues.size() > 2 * static_cast<std::size_t>(mNbTiles) * mNbTypes)
+        setAllDirty();
+
+    if(mIsAllDirty)
+    {
+        mCombinationValues.clear();
+        for(uint32_t tileIndex = 0; tileIndex < mNbTiles; ++tileIndex)
+            computeTile(tileIndex, teamValues);
+
+        mIsAllDirty = false;
+        return;
+    }
+
+    for(uint32_t tileIndex : mDirtyTiles)
+    {
+        computeTile(tileIndex, teamValues);
+        mIsTileDirty[tileIndex] = false;
+    }
+    mDirtyTiles.clear();
+}
+
+void WorkerFloodFill::computeTile(uint32_t tileIndex, const std::vector<uint32_t>& teamValues)
+{
+    mKey.resize(mNbTeams + 1);
+    for(uint32_t type = 0; type < mNbTypes; ++type)
+    {
+        mKey[0] = type;
+        for(uint32_t teamIndex = 0; teamIndex < mNbTeams; ++teamIndex)
+            mKey[teamIndex + 1] = teamValues[(teamIndex * mNbTypes + type) * mNbTiles + tileIndex];
+
+        // Most combinations already exist. We only copy the key when a new one is found
+        auto it = mCombinationValues.find(mKey);
+        if(it == mCombinationValues.end())
+        {
+            uint32_t newValue = static_cast<uint32_t>(mCombinationValues.size());
+            it = mCombinationValues.emplace(mKey, newValue).first;
+        }
+
+        mValues[tileIndex * mNbTypes + type] = it->second;
+    }
+}
+
+uint64_t WorkerFloodFill::getMemoryUsage() const
+{
+    // Each combination is stored in a node with its own key vector
+    uint64_t combinationBytes = sizeof(std::vector<uint32_t>) + sizeof(uint32_t) + 2 * sizeof(void*)
+        + (mNbTeams + 1) * sizeof(uint32_t);
+    return mValues.capacity() * sizeof(uint32_t)
+        + mCombinationValues.size() * combinationBytes
+        + mCombinationValues.bucket_count() * sizeof(void*)
+        + mIsTileDirty.capacity() / 8
+        + mDirtyTiles.capacity() * sizeof(uint32_t);
+}
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WORKERFLOODFILL_H
+#define WORKERFLOODFILL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+//! \brief Floodfill layer "open for everyone" used for workers. For each tile and floodfill type,
+//! 2 tiles have the same value if and only if they have the same floodfill value for every team. That
+//! allows to know if workers can go from one tile to another (no door closed for anybody) with a single
+//! comparison instead of checking every team.
+//! Each combination of team values gets its own value. When team values change, only the tiles set
+//! dirty get their value again, the other tiles keep theirs since their combination did not change.
+class WorkerFloodFill
+{
+public:
+    WorkerFloodFill();
+
+    //! \brief Sets the number of tiles, floodfill types and teams. Every tile is set dirty
+    void resize(uint32_t nbTiles, uint32_t nbTypes, uint32_t nbTeams);
+
+    //! \brief Sets every tile dirty
+    void setAllDirty();
+
+    //! \brief Sets dirty the tile with the given index. Its value will be computed again by the next refresh
+    inline void setTileDirty(uint32_t tileIndex)
+    {
+        if(mIsAllDirty || mIsTileDirty[tileIndex])
+            return;
+
+        mIsTileDirty[tileIndex] = true;
+        mDirtyTiles.push_back(tileIndex);
+    }
+
+    //! \brief Computes the value of the dirty tiles. teamValues holds the floodfill values of every team
+    //! at index (teamIndex * nbTypes + type) * nbTiles + tileIndex
+    void refresh(const std::vector<uint32_t>& teamValues);
+
+    //! \brief Returns the value of the given tile. It is only up to date after refresh
+    inline uint32_t getValue(uint32_t tileIndex, uint32_t type) const
+    { return mValues[tileIndex * mNbTypes + type]; }
+
+    inline bool isDirty() const
+    { return mIsAllDirty || !mDirtyTiles.empty(); }
+
+    //! \brief Approximate number of bytes used
+    uint64_t getMemoryUsage() const;
+
+private:
+    struct KeyHash
+    {
+        std::size_t operator()(const std::vector<uint32_t>& key) const;
+    };
+
+    uint32_t mNbTiles;
+    uint32_t mNbTypes;
+    uint32_t mNbTeams;
+
+    //! \brief Values stored at index tileIndex * mNbTypes + type
+    std::vector<uint32_t> mValues;
+
+    //! \brief Value given to each combination of floodfill type and team values. Combinations
+    //! that are not used anymore are only removed when every value is computed again
+    std::unordered_map<std::vector<uint32_t>, uint32_t, KeyHash> mCombinationValues;
+
+    //! \brief Key used to look for a combination without allocating a new one each time
+    std::vector<uint32_t> mKey;
+
+    bool mIsAllDirty;
+    std::vector<bool> mIsTileDirty;
+    std::vector<uint32_t> mDirtyTiles;
+
+    //! \brief Computes the value of the given tile for every floodfill type
+    void computeTile(uint32_t tileIndex, const std::vector<uint32_t>& teamValues);
+};
+
+#endif // WORKERFLOODFILL_H
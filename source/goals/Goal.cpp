@@ -19,6 +19,12 @@
 
 #include "utils/LogManager.h"
 
+const uint32_t Goal::EventCreatures;
+const uint32_t Goal::EventRooms;
+const uint32_t Goal::EventClaimedTiles;
+const uint32_t Goal::EventGoldMined;
+const uint32_t Goal::EventAll;
+
 Goal::Goal(const std::string& nName, const std::string& nArguments) :
     mName(nName),
     mArguments(nArguments)
@@ -45,6 +51,11 @@ bool Goal::isFailed(const Seat& s, const GameMap&)
     return false;
 }
 
+uint32_t Goal::getDependencies() const
+{
+    return EventAll;
+}
+
 void Goal::addSuccessSubGoal(std::unique_ptr<Goal>&& g)
 {
     mSuccessSubGoals.emplace_back(std::move(g));
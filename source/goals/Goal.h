@@ -18,6 +18,7 @@
 #ifndef GOAL_H
 #define GOAL_H
 
+#include <cstdint>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -29,6 +30,14 @@ class GameMap;
 class Goal
 {
 public:
+    //! \brief Events goals can depend on. They are given as a bitmask. A goal is only evaluated
+    //! again when one of the events it depends on happened since the last evaluation
+    static const uint32_t EventCreatures = 1 << 0;
+    static const uint32_t EventRooms = 1 << 1;
+    static const uint32_t EventClaimedTiles = 1 << 2;
+    static const uint32_t EventGoldMined = 1 << 3;
+    static const uint32_t EventAll = 0xFFFFFFFF;
+
     // Constructors
     Goal(const std::string& nName, const std::string& nArguments);
     virtual ~Goal() {}
@@ -45,6 +54,10 @@ public:
     virtual bool isUnmet(const Seat& s, const GameMap& gameMap);
     virtual bool isFailed(const Seat&, const GameMap&);
 
+    //! \brief Returns the events (as a bitmask) the goal state depends on. By default, goals are
+    //! evaluated again after any event
+    virtual uint32_t getDependencies() const;
+
     // Functions which cannot be overridden by child classes
     const std::string& getName() const
     { return mName; }
@@ -57,3 +57,8 @@ std::string GoalClaimNTiles::getDescription(const Seat& s)
             << mNumberOfTiles << " tiles.";
     return tempSS.str();
 }
+
+uint32_t GoalClaimNTiles::getDependencies() const
+{
+    return EventClaimedTiles;
+}
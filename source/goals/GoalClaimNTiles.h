@@ -32,6 +32,7 @@ public:
     std::string getDescription(const Seat& s);
     std::string getSuccessMessage(const Seat&);
     std::string getFailedMessage(const Seat&);
+    uint32_t getDependencies() const;
 
 private:
     unsigned int mNumberOfTiles;
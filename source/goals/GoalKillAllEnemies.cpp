@@ -40,19 +40,14 @@ bool GoalKillAllEnemies::isMet(const Seat &s, const GameMap& gameMap)
             return false;
     }
 
-    // Considers also creature spawner rooms as enemy to be killed.
-    // Temples
-    std::vector<Room*> temples = gameMap.getRoomsByType(RoomType::dungeonTemple);
-    for (Room* temple : temples)
+    // Considers also creature spawner rooms (temples and portals) as enemy to be killed.
+    for (Room* room : gameMap.getRooms())
     {
-        if (!temple->getSeat()->isAlliedSeat(&s))
-            return false;
-    }
-    // Portals
-    std::vector<Room*> portals = gameMap.getRoomsByType(RoomType::portal);
-    for (Room* portal : portals)
-    {
-        if (!portal->getSeat()->isAlliedSeat(&s))
+        if((room->getType() != RoomType::dungeonTemple) && (room->getType() != RoomType::portal))
+            continue;
+        if(room->getHP(nullptr) <= 0.0)
+            continue;
+        if (!room->getSeat()->isAlliedSeat(&s))
             return false;
     }
 
@@ -73,3 +68,8 @@ std::string GoalKillAllEnemies::getDescription(const Seat&)
 {
     return "Kill all enemy creatures,\ntemples and portals.";
 }
+
+uint32_t GoalKillAllEnemies::getDependencies() const
+{
+    return EventCreatures | EventRooms;
+}
@@ -32,6 +32,7 @@ public:
     std::string getDescription(const Seat&);
     std::string getSuccessMessage(const Seat&);
     std::string getFailedMessage(const Seat&);
+    uint32_t getDependencies() const;
 };
 
 #endif // GOAKILLALLENEMIES_H
@@ -57,3 +57,7 @@ std::string GoalMineNGold::getFailedMessage(const Seat &s)
     return tempSS.str();
 }
 
+uint32_t GoalMineNGold::getDependencies() const
+{
+    return EventGoldMined;
+}
@@ -32,6 +32,7 @@ public:
     std::string getDescription(const Seat &s);
     std::string getSuccessMessage(const Seat &s);
     std::string getFailedMessage(const Seat &s);
+    uint32_t getDependencies() const;
 
 private:
     int mGoldToMine;
@@ -53,3 +53,7 @@ std::string GoalProtectCreature::getDescription(const Seat&)
     return "Protect the creature named " + mCreatureName + ".";
 }
 
+uint32_t GoalProtectCreature::getDependencies() const
+{
+    return EventCreatures;
+}
@@ -58,3 +58,8 @@ std::string GoalProtectDungeonTemple::getFailedMessage(const Seat&)
 {
     return "Your dungeon temple has been destroyed";
 }
+
+uint32_t GoalProtectDungeonTemple::getDependencies() const
+{
+    return EventRooms;
+}
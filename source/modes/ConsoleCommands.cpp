@@ -15,6 +15,7 @@
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/ObjectPool.h"
 
 #include <OgreCamera.h>
 #include <OgreSceneManager.h>
@@ -22,6 +23,7 @@
 #include <boost/algorithm/string/join.hpp>
 
 #include <functional>
+#include <sstream>
 
 namespace
 {
@@ -53,6 +55,10 @@ const std::string HELPMESSAGE =
         "\n\tsetcreaturedest - Sets the creature destination/"
         "\n\tlistmeshanims - Lists all the animations for the given mesh."
         "\n\ttriggercompositor - Starts the given Ogre Compositor."
+        "\n\ttilerefreshstats - Displays the tile refresh and material cache counters."
+        "\n\ttilechunks - Enables/disables the merging of tile meshes in static geometry chunks."
+        "\n\tpoolstats - Displays the allocation stats of the game object pools."
+        "\n\tmemstats - Displays the memory used by the game map subsystems."
         "\n\tcatmullspline - Triggers the catmullspline camera movement type."
         "\n\tcirclearound - Triggers the circle camera movement type."
         "\n\tsetcamerafovy - Sets the camera vertical field of view aspect ratio value."
@@ -485,6 +491,116 @@ Command::Result cTriggerCompositor(const Command::ArgumentList_t& args, ConsoleI
     return Command::Result::SUCCESS;
 }
 
+Command::Result cTileRefreshStats(const Command::ArgumentList_t& args, ConsoleInterface& c, AbstractModeManager&)
+{
+    RenderManager& renderManager = RenderManager::getSingleton();
+    if((args.size() >= 2) && (args[1] == "reset"))
+    {
+        renderManager.resetTileRefreshStats();
+        c.print("Tile refresh statistics reset");
+        return Command::Result::SUCCESS;
+    }
+
+    const TileRefreshStats& stats = renderManager.getTileRefreshStats();
+    uint64_t nbMaterialLookups = stats.mNbMaterialCacheHits + stats.mNbMaterialCacheMisses;
+    double hitRate = 0.0;
+    if(nbMaterialLookups > 0)
+        hitRate = 100.0 * static_cast<double>(stats.mNbMaterialCacheHits) / static_cast<double>(nbMaterialLookups);
+
+    c.print("Tile refreshes queued: " + Helper::toString(stats.mNbRefreshQueued)
+        + "\nTile refreshes done: " + Helper::toString(stats.mNbRefreshDone)
+        + "\nMaterial cache hits: " + Helper::toString(stats.mNbMaterialCacheHits)
+        + "\nMaterial cache misses: " + Helper::toString(stats.mNbMaterialCacheMisses)
+        + "\nMaterial cache hit rate: " + Helper::toString(hitRate) + "%");
+    return Command::Result::SUCCESS;
+}
+
+Command::Result cTileChunks(const Command::ArgumentList_t& args, ConsoleInterface& c, AbstractModeManager&)
+{
+    RenderManager& renderManager = RenderManager::getSingleton();
+    if(args.size() >= 2)
+    {
+        bool enable;
+        if(args[1] == "on")
+            enable = true;
+        else if(args[1] == "off")
+            enable = false;
+        else
+        {
+            c.print("ERROR: Expected 'on' or 'off'");
+            return Command::Result::INVALID_ARGUMENT;
+        }
+
+        GameMap* gameMap = ODFrameListener::getSingleton().getClientGameMap();
+        renderManager.setTileChunksEnabled(enable, *gameMap);
+        renderManager.getTileChunkGrid().resetStats();
+    }
+
+    const TileChunkGrid& grid = renderManager.getTileChunkGrid();
+    c.print("Tile chunks: " + std::string(renderManager.getTileChunksEnabled() ? "on" : "off")
+        + "\nChunk size: " + Helper::toString(grid.getChunkSize())
+        + "\nChunks: " + Helper::toString(grid.getNbChunks())
+        + "\nChunks built: " + Helper::toString(renderManager.getNbTileChunksBuilt())
+        + "\nChunk rebuilds: " + Helper::toString(grid.getNbRebuilds())
+        + "\nTiles marked: " + Helper::toString(grid.getNbTilesMarked())
+        + "\nTile scene nodes: " + Helper::toString(renderManager.getNbTileSceneNodes()));
+    return Command::Result::SUCCESS;
+}
+
+Command::Result cPoolStats(const Command::ArgumentList_t&, ConsoleInterface& c, AbstractModeManager&)
+{
+    // Pools are shared by every game map of the process (client and local server)
+    c.print(ObjectPool::getStatsReport());
+    return Command::Result::SUCCESS;
+}
+
+std::string formatMemoryUsage(const GameMap& gameMap)
+{
+    std::stringstream ss;
+    uint64_t total = 0;
+    for(const std::pair<std::string, uint64_t>& usage : gameMap.getMemoryUsage())
+    {
+        ss << usage.first << ": " << (usage.second / 1024) << " KB\n";
+        total += usage.second;
+    }
+    ss << "total: " << (total / 1024) << " KB (map " << gameMap.getMapSizeX() << "x" << gameMap.getMapSizeY() << ")";
+    return ss.str();
+}
+
+std::string formatPoolsMemoryUsage()
+{
+    std::stringstream ss;
+    uint64_t total = 0;
+    for(const ObjectPool* pool : ObjectPool::getPools())
+    {
+        ss << pool->getName() << ": " << (pool->getReservedBytes() / 1024) << " KB\n";
+        total += pool->getReservedBytes();
+    }
+    ss << "total: " << (total / 1024) << " KB";
+    return ss.str();
+}
+
+Command::Result cMemStats(const Command::ArgumentList_t& args, ConsoleInterface& c, AbstractModeManager& mm)
+{
+    // Pools are shared by every game map of the process (client and local server) so they are only printed once
+    c.print("Object pools:\n" + formatPoolsMemoryUsage());
+
+    GameMap* gameMap = ODFrameListener::getSingleton().getClientGameMap();
+    c.print("Client game map:\n" + formatMemoryUsage(*gameMap));
+
+    // When we host the game, the server map is logged too
+    if(ODServer::getSingleton().isConnected())
+        return cSendCmdToServer(args, c, mm);
+
+    return Command::Result::SUCCESS;
+}
+
+Command::Result cSrvMemStats(const Command::ArgumentList_t&, ConsoleInterface& c, GameMap& gameMap)
+{
+    c.print("Server game map:\n" + formatMemoryUsage(gameMap));
+    return Command::Result::SUCCESS;
+}
+
 } // namespace <none>
 
 namespace ConsoleCommands
@@ -655,6 +771,32 @@ void addConsoleCommands(ConsoleInterface& cl)
                    cTriggerCompositor,
                    Command::cStubServer,
                    {AbstractModeManager::ModeType::GAME, AbstractModeManager::ModeType::EDITOR});
+    cl.addCommand("tilerefreshstats",
+                   "Displays how many tile refreshes were asked and done and the hit rate of the colourized material cache. "
+                   "Use 'tilerefreshstats reset' to reset the counters.",
+                   cTileRefreshStats,
+                   Command::cStubServer,
+                   {AbstractModeManager::ModeType::GAME, AbstractModeManager::ModeType::EDITOR});
+    cl.addCommand("tilechunks",
+                   "Merges the tile meshes in static geometry chunks that are rebuilt when one of their tiles changes "
+                   "and displays the chunk counters.\n\nExample:\n"
+                   "tilechunks on",
+                   cTileChunks,
+                   Command::cStubServer,
+                   {AbstractModeManager::ModeType::GAME, AbstractModeManager::ModeType::EDITOR});
+    cl.addCommand("poolstats",
+                   "Displays, for each pool used to allocate game objects, the number of slabs, the objects in use "
+                   "and the number of allocations that went to the heap.",
+                   cPoolStats,
+                   Command::cStubServer,
+                   {AbstractModeManager::ModeType::GAME, AbstractModeManager::ModeType::EDITOR});
+    cl.addCommand("memstats",
+                   "Displays the approximate memory used by the client game map subsystems (tiles, floodfill, seat tile "
+                   "states, entities and pathfinding) and by the object pools, which are shared by every game map. "
+                   "When hosting the game, the server game map is logged too.",
+                   cMemStats,
+                   cSrvMemStats,
+                   {AbstractModeManager::ModeType::GAME, AbstractModeManager::ModeType::EDITOR});
     cl.addCommand("helpmessage",
                    "Display help message",
                    [](const Command::ArgumentList_t&, ConsoleInterface& c, AbstractModeManager&) {
@@ -26,7 +26,7 @@
 class GameMap;
 class Gui; // Used to change the Current tile type
 
-enum class TileVisual;
+enum class TileVisual : uint8_t;
 
 class EditorMode final: public GameEditorModeBase, public InputCommand
 {
@@ -175,7 +175,7 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
                 tile->setType(TileType::gem);
                 tile->setTileVisual(TileVisual::gemFull);
             }
-            gameMap->setAllFullnessAndNeighbors();
+            gameMap->setAllFullness();
 
             ODPacket packSend;
             packSend << ClientNotificationType::levelOK;
@@ -207,9 +207,9 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
                     OD_LOG_ERR("Unknown server mode=" + Helper::toString(static_cast<int32_t>(serverMode)));
                     break;
             }
-            // If we are watching a replay, we force stopping the processing loop to
+            // If we are watching a replay or spectating, we force stopping the processing loop to
             // allow changing mode (because there is no synchronization as there is no server)
-            if(getSource() == ODSource::file)
+            if(getSource() != ODSource::network)
                 return false;
             break;
         }
@@ -377,9 +377,9 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
                 startY = 0.0;
 
             frameListener->resetCamera(Ogre::Vector3(startX, startY, MAX_CAMERA_Z));
-            // If we are watching a replay, we force stopping the processing loop to
+            // If we are watching a replay or spectating, we force stopping the processing loop to
             // allow changing mode (because there is no synchronization as there is no server)
-            if(getSource() == ODSource::file)
+            if(getSource() != ODSource::network)
                 return false;
             break;
         }
@@ -674,8 +674,7 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
         case ServerNotificationType::notifyCreatureInfo:
         {
             std::string name;
-            std::string infos;
-            OD_ASSERT_TRUE(packetReceived >> name >> infos);
+            OD_ASSERT_TRUE(packetReceived >> name);
             Creature* creature = gameMap->getCreature(name);
             if(creature == nullptr)
             {
@@ -683,7 +682,7 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
                 break;
             }
 
-            creature->updateStatsWindow(infos);
+            creature->importStatsFromPacket(packetReceived);
             break;
         }
 
@@ -1054,6 +1053,21 @@ bool ODClient::replay(const std::string& filename)
     return true;
 }
 
+bool ODClient::spectate(const std::string& host, const int port, uint32_t timeout)
+{
+    mIsPlayerConfig = false;
+    if (ODClient::getSingleton().isConnected())
+    {
+        OD_LOG_INF("Couldn't try to spectate: The client is already connected");
+        return false;
+    }
+
+    if(!ODSocketClient::spectate(host, port, timeout))
+        return false;
+
+    return true;
+}
+
 void ODClient::queueClientNotification(ClientNotification* n)
 {
     mClientNotificationQueue.push_back(n);
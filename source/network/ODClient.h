@@ -53,6 +53,9 @@ class ODClient: public Ogre::Singleton<ODClient>,
     //! \brief Connects to the server host:port
     bool replay(const std::string& filename);
 
+    //! \brief Watches the game relayed by the spectator relay of the server host:port
+    bool spectate(const std::string& host, const int port, uint32_t timeout) override;
+
     //! \brief Adds a client notification to the client notification queue.
     void queueClientNotification(ClientNotification* n);
 
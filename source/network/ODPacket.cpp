@@ -17,6 +17,10 @@
 
 #include "network/ODPacket.h"
 
+#include <cstring>
+#include <istream>
+#include <ostream>
+
 #define OD_INT64TOINT32H(valInt64)              (static_cast<int32_t>(valInt64 >> 32))
 #define OD_INT64TOINT32L(valInt64)              (static_cast<int32_t>(valInt64))
 #define OD_INT32TOINT64(valInt32h,valInt32l)    ((((static_cast<int64_t>(valInt32h)) << 32) & static_cast<int64_t>(0xFFFFFFFF00000000)) + ((static_cast<int64_t>(valInt32l)) & static_cast<int64_t>(0x00000000FFFFFFFF)))
@@ -238,12 +242,23 @@ ODPacket::operator bool() const
     return mPacket;
 }
 
+bool ODPacket::operator ==(const ODPacket& other) const
+{
+    if(mPacket.getDataSize() != other.mPacket.getDataSize())
+        return false;
+
+    if(mPacket.getDataSize() == 0)
+        return true;
+
+    return std::memcmp(mPacket.getData(), other.mPacket.getData(), mPacket.getDataSize()) == 0;
+}
+
 void ODPacket::clear()
 {
     mPacket.clear();
 }
 
-void ODPacket::writePacket(int32_t timestamp, std::ofstream& os)
+void ODPacket::writePacket(int32_t timestamp, std::ostream& os) const
 {
     int32_t bufferSize = mPacket.getDataSize();
     const char* buffer = static_cast<const char*>(mPacket.getData());
@@ -252,7 +267,7 @@ void ODPacket::writePacket(int32_t timestamp, std::ofstream& os)
     os.write(buffer, bufferSize);
 }
 
-int32_t ODPacket::readPacket(std::ifstream& is)
+int32_t ODPacket::readPacket(std::istream& is)
 {
     int32_t timestamp;
     int32_t packetSize;
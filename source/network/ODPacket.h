@@ -23,6 +23,7 @@
 
 #include <string>
 #include <cstdint>
+#include <iosfwd>
 
 /*! \brief This class is an utility class to transfer data through ODSocketClient.
  * It should also override operators << and >> for each standard types.
@@ -120,20 +121,26 @@ class ODPacket
          */
         operator bool() const;
 
+        //! \brief Returns true if both packets contain the same data
+        bool operator ==(const ODPacket& other) const;
+        bool operator !=(const ODPacket& other) const
+        { return !(*this == other); }
+
         /*! \brief Clears the packet. After calling Clear, the packet should
          * be empty.
          */
         void clear();
 
-        /*! \brief Writes the packet content to the given ofstream.
+        /*! \brief Writes the packet content to the given stream (replay record format:
+         *         timestamp, data size then data).
          */
-        void writePacket(int32_t timestamp, std::ofstream& os);
+        void writePacket(int32_t timestamp, std::ostream& os) const;
 
-        /*! \brief Reads the packet content from the given ifstream.
+        /*! \brief Reads the packet content from the given stream.
          *         Returns the timestamp at which the packet has been sent.
          *         If EOF has been reached, returns -1
          */
-        int32_t readPacket(std::ifstream& is);
+        int32_t readPacket(std::istream& is);
 
         /*! \brief Template function to put arguments in a packet, used for in-place construction.
          */
@@ -75,6 +75,7 @@ ODServer::ODServer() :
     mSeatsConfigured(false),
     mPlayerConfig(nullptr),
     mConsoleInterface(std::bind(&ODServer::printConsoleMsg, this, std::placeholders::_1)),
+    mSpectatorSourceAttached(false),
     mMasterServerGameStatusUpdateTime(0)
 {
     ConsoleCommands::addConsoleCommands(mConsoleInterface);
@@ -134,6 +135,12 @@ bool ODServer::startServer(const std::string& creator, const std::string& levelF
         return false;
     }
 
+    // Spectators are optional. If the relay cannot be started, the game is launched anyway
+    mSpectatorSourceAttached = false;
+    int32_t spectatorPort = ResourceManager::getSingleton().getSpectatorPort();
+    if((spectatorPort != -1) && !mSpectatorRelay.start(spectatorPort))
+        OD_LOG_ERR("Could not start spectator relay on port=" + Helper::toString(spectatorPort));
+
     // We configure what is fixed (fixed AI, faction or team). While iterating seats, we keep in mind if there is
     // at least a human only seat. If yes, we configure all player type choosable to AI. If not, we configure all player
     // type choosable to AI except the first one.
@@ -332,32 +339,53 @@ void ODServer::startNewTurn(double timeSinceLastTurn)
         Player* player = sock->getPlayer();
         // For now, only the player whose seat changed is notified. If we need it, we could send the event to every player
         // so that they can see how far from the goals the other players are
-        ServerNotification *serverNotification = new ServerNotification(
-            ServerNotificationType::refreshPlayerSeat, player);
-        std::string goals = gameMap->getGoalsStringForPlayer(player);
+        // The seat is only sent if its content changed since the last time
+        ODPacket seatPacket;
+        const std::string& goals = gameMap->getGoalsStringForPlayer(player);
         Seat* seat = player->getSeat();
-        seat->exportToPacketForUpdate(serverNotification->mPacket);
-        serverNotification->mPacket << goals;
-        ODServer::getSingleton().queueServerNotification(serverNotification);
+        seat->exportToPacketForUpdate(seatPacket);
+        seatPacket << goals;
+        auto itLastSeat = mLastSeatRefreshSent.find(sock);
+        if((itLastSeat == mLastSeatRefreshSent.end()) || (itLastSeat->second != seatPacket))
+        {
+            ServerNotification *serverNotification = new ServerNotification(
+                ServerNotificationType::refreshPlayerSeat, player);
+            serverNotification->mPacket = seatPacket;
+            ODServer::getSingleton().queueServerNotification(serverNotification);
+            mLastSeatRefreshSent[sock] = seatPacket;
+        }
 
         // Here, the creature list is pulled. It could be possible that the creature dies before the stat window is
         // closed. So, if we cannot find the creature, we just erase it.
-        std::vector<std::string>& creatures = mCreaturesInfoWanted[sock];
-        std::vector<std::string>::iterator itCreatures = creatures.begin();
+        // Only the fields that changed since the last stats sent are exported. If nothing changed,
+        // nothing is sent.
+        std::vector<CreatureInfoWanted>& creatures = mCreaturesInfoWanted[sock];
+        std::vector<CreatureInfoWanted>::iterator itCreatures = creatures.begin();
         while(itCreatures != creatures.end())
         {
-            std::string& name = *itCreatures;
-            Creature* creature = gameMap->getCreature(name);
+            CreatureInfoWanted& infoWanted = *itCreatures;
+            Creature* creature = gameMap->getCreature(infoWanted.mName);
             if(creature == nullptr)
                 itCreatures = creatures.erase(itCreatures);
             else
             {
-                std::string creatureInfos = creature->getStatsText();
+                CreatureStats stats;
+                creature->fillStats(stats);
+                uint32_t fields = CreatureStats::FieldAll;
+                if(infoWanted.mSent)
+                    fields = stats.getChangedFields(infoWanted.mLastSent);
 
-                ServerNotification *serverNotification = new ServerNotification(
-                    ServerNotificationType::notifyCreatureInfo, player);
-                serverNotification->mPacket << name << creatureInfos;
-                ODServer::getSingleton().queueServerNotification(serverNotification);
+                if(fields != 0)
+                {
+                    ServerNotification *serverNotification = new ServerNotification(
+                        ServerNotificationType::notifyCreatureInfo, player);
+                    serverNotification->mPacket << infoWanted.mName;
+                    stats.exportToPacket(serverNotification->mPacket, fields);
+                    ODServer::getSingleton().queueServerNotification(serverNotification);
+
+                    infoWanted.mSent = true;
+                    infoWanted.mLastSent = stats;
+                }
 
                 ++itCreatures;
             }
@@ -398,6 +426,9 @@ void ODServer::serverThread()
     bool isClientConnected = true;
     while(isConnected() && isClientConnected)
     {
+        // What was sent during the last turn is relayed to the spectators
+        mSpectatorRelay.flush();
+
         // doTask should return after the length of 1 turn even if their are communications. When
         // it returns, we can launch next turn.
         doTask(static_cast<int32_t>(turnLengthMs));
@@ -424,14 +455,7 @@ void ODServer::serverThread()
 
                 // We configure the game for launching
                 const std::vector<Seat*>& seats = gameMap->getSeats();
-                for (int jj = 0; jj < gameMap->getMapSizeY(); ++jj)
-                {
-                    for (int ii = 0; ii < gameMap->getMapSizeX(); ++ii)
-                    {
-                        Tile* tile = gameMap->getTile(ii,jj);
-                        tile->setSeats(seats);
-                    }
-                }
+                gameMap->resizeSeatPlanes(static_cast<uint32_t>(seats.size()));
 
                 // We set allied seats
                 for(Seat* seat : seats)
@@ -515,6 +539,8 @@ void ODServer::serverThread()
         processServerNotifications();
     }
 
+    mSpectatorRelay.flush();
+
     if(!mMasterServerGameId.empty())
     {
         mMasterServerGameStatusUpdateTime = 0.0;
@@ -1423,12 +1449,13 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             std::string name;
             bool refreshEachTurn;
             OD_ASSERT_TRUE(packetReceived >> name >> refreshEachTurn);
-            std::vector<std::string>& creatures = mCreaturesInfoWanted[clientSocket];
+            std::vector<CreatureInfoWanted>& creatures = mCreaturesInfoWanted[clientSocket];
 
-            std::vector<std::string>::iterator it = std::find(creatures.begin(), creatures.end(), name);
+            std::vector<CreatureInfoWanted>::iterator it = std::find_if(creatures.begin(), creatures.end(),
+                [&name](const CreatureInfoWanted& infoWanted) { return infoWanted.mName == name; });
             if(refreshEachTurn && (it == creatures.end()))
             {
-                creatures.push_back(name);
+                creatures.push_back(CreatureInfoWanted(name));
             }
             else if(!refreshEachTurn && (it != creatures.end()))
                 creatures.erase(it);
@@ -1847,6 +1874,13 @@ ODSocketClient* ODServer::notifyNewConnection(sf::TcpListener& sockListener)
         case ServerState::StateConfiguration:
         {
             newClient->setState("connected");
+            // Spectators see the game like the first player connected (usually the game creator).
+            // As the stream is the replay of this player, it has to be recorded from the connexion
+            if(mSpectatorRelay.isStarted() && !mSpectatorSourceAttached)
+            {
+                newClient->setSpectatorRelay(&mSpectatorRelay);
+                mSpectatorSourceAttached = true;
+            }
             return newClient;
         }
         case ServerState::StateGame:
@@ -1897,6 +1931,9 @@ bool ODServer::notifyClientMessage(ODSocketClient *clientSocket)
             mDisconnectedPlayers.push_back(clientSocket->getPlayer());
         }
         // TODO : wait at least 1 minute if the client reconnects if deconnexion happens during game
+
+        mLastSeatRefreshSent.erase(clientSocket);
+        mCreaturesInfoWanted.erase(clientSocket);
     }
     return ret;
 }
@@ -1909,7 +1946,11 @@ void ODServer::stopServer()
     mServerState = ServerState::StateNone;
     mSeatsConfigured = false;
     mDisconnectedPlayers.clear();
+    mLastSeatRefreshSent.clear();
+    mCreaturesInfoWanted.clear();
     mPlayerConfig = nullptr;
+    mSpectatorRelay.stop();
+    mSpectatorSourceAttached = false;
 
     // Now that the server is stopped, we can remove all pending messages
     while(!mServerNotificationQueue.empty())
@@ -19,6 +19,8 @@
 #define ODSERVER_H
 
 #include "ODSocketServer.h"
+#include "network/SpectatorRelay.h"
+#include "entities/CreatureStats.h"
 #include "modes/ConsoleInterface.h"
 
 #include <OgreSingleton.h>
@@ -112,10 +114,31 @@ private:
 
     std::deque<ServerNotification*> mServerNotificationQueue;
 
-    std::map<ODSocketClient*, std::vector<std::string>> mCreaturesInfoWanted;
+    //! \brief Stats last sent for a creature the client has the stats window opened
+    struct CreatureInfoWanted
+    {
+        CreatureInfoWanted(const std::string& name) :
+            mName(name),
+            mSent(false)
+        {}
+
+        std::string mName;
+        //! \brief False until the first (complete) stats have been sent
+        bool mSent;
+        CreatureStats mLastSent;
+    };
+
+    std::map<ODSocketClient*, std::vector<CreatureInfoWanted>> mCreaturesInfoWanted;
+
+    //! \brief Last refreshPlayerSeat content sent to each client. Used to avoid sending it when nothing changed
+    std::map<ODSocketClient*, ODPacket> mLastSeatRefreshSent;
 
     ConsoleInterface mConsoleInterface;
 
+    //! \brief Relays the game, as seen by the first player connected, to the spectators
+    SpectatorRelay mSpectatorRelay;
+    bool mSpectatorSourceAttached;
+
     std::string mMasterServerGameId;
     double mMasterServerGameStatusUpdateTime;
 
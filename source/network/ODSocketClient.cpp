@@ -18,6 +18,7 @@
 #include "ODSocketClient.h"
 #include "network/ODPacket.h"
 #include "network/ServerNotification.h"
+#include "network/SpectatorRelay.h"
 
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
@@ -25,6 +26,13 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/filesystem.hpp>
 
+#include <cstring>
+#include <sstream>
+
+//! \brief Size of a replay record header (timestamp and data size)
+static const std::size_t RECORD_HEADER_SIZE = 2 * sizeof(int32_t);
+static const std::size_t SPECTATOR_RECEIVE_SIZE = 16384;
+
 bool ODSocketClient::connect(const std::string& host, const int port, uint32_t timeout, const std::string& outputReplayFilename)
 {
     mSource = ODSource::none;
@@ -58,6 +66,29 @@ bool ODSocketClient::replay(const std::string& filename)
     return true;
 }
 
+bool ODSocketClient::spectate(const std::string& host, const int port, uint32_t timeout)
+{
+    mSource = ODSource::none;
+
+    sf::Socket::Status status = mSockClient.connect(host, port, sf::milliseconds(timeout));
+    if (status != sf::Socket::Done)
+    {
+        OD_LOG_ERR("Could not connect to spectator relay status="
+            + Helper::toString(status));
+        mSockClient.disconnect();
+        return false;
+    }
+    mSockSelector.add(mSockClient);
+    OD_LOG_INF("Connected to spectator relay successfully");
+
+    mSpectatorBuffer.clear();
+    mSpectatorOffset = 0;
+    mSpectatorStreamEnded = false;
+    mGameClock.restart();
+    mSource = ODSource::spectator;
+    return true;
+}
+
 void ODSocketClient::disconnect(bool keepReplay)
 {
     mPendingTimestamp = -1;
@@ -83,6 +114,15 @@ void ODSocketClient::disconnect(bool keepReplay)
             mReplayInputStream.close();
             return;
         }
+        case ODSource::spectator:
+        {
+            mSockSelector.clear();
+            mSockClient.disconnect();
+            mSpectatorBuffer.clear();
+            mSpectatorOffset = 0;
+            mSpectatorStreamEnded = false;
+            return;
+        }
         default:
             assert(false);
             break;
@@ -127,6 +167,40 @@ bool ODSocketClient::isDataAvailable()
 
             return false;
         }
+        case ODSource::spectator:
+        {
+            // Records are processed as soon as they are received. Timestamps are not waited for
+            // so that spectators joining late catch up with the game
+            if(mPendingTimestamp != -1)
+                return true;
+
+            if(readSpectatorRecord())
+                return true;
+
+            if(mSpectatorStreamEnded)
+                return false;
+
+            if(!mSockSelector.wait(sf::milliseconds(5)))
+                return false;
+
+            if(!mSockSelector.isReady(mSockClient))
+                return false;
+
+            char buffer[SPECTATOR_RECEIVE_SIZE];
+            std::size_t received = 0;
+            sf::Socket::Status status = mSockClient.receive(buffer, SPECTATOR_RECEIVE_SIZE, received);
+            if(status != sf::Socket::Done)
+            {
+                // recv will report the end of the stream
+                OD_LOG_WRN("Spectator relay disconnected status=" + Helper::toString(status));
+                mSockSelector.clear();
+                mSpectatorStreamEnded = true;
+                return true;
+            }
+
+            mSpectatorBuffer.append(buffer, received);
+            return readSpectatorRecord();
+        }
         default:
             assert(false);
             break;
@@ -137,6 +211,9 @@ bool ODSocketClient::isDataAvailable()
 
 ODSocketClient::ODComStatus ODSocketClient::send(ODPacket& s)
 {
+    if(mSpectatorRelay != nullptr)
+        mSpectatorRelay->recordPacket(s, getGameTimeMillis());
+
     if(mSource != ODSource::network)
         return ODComStatus::OK;
 
@@ -190,6 +267,16 @@ ODSocketClient::ODComStatus ODSocketClient::recv(ODPacket& s)
             mPendingTimestamp = -1;
             return ODComStatus::OK;
         }
+        case ODSource::spectator:
+        {
+            // If no record is pending, the stream ended
+            if(mPendingTimestamp == -1)
+                return ODComStatus::Error;
+
+            s = mPendingPacket;
+            mPendingTimestamp = -1;
+            return ODComStatus::OK;
+        }
         default:
             break;
     }
@@ -229,3 +316,28 @@ bool ODSocketClient::processOneClientSocketMessage()
 
     return processMessage(serverCommand, packetReceived);
 }
+
+bool ODSocketClient::readSpectatorRecord()
+{
+    std::size_t available = mSpectatorBuffer.size() - mSpectatorOffset;
+    if(available < RECORD_HEADER_SIZE)
+        return false;
+
+    int32_t dataSize;
+    std::memcpy(&dataSize, mSpectatorBuffer.data() + mSpectatorOffset + sizeof(int32_t), sizeof(int32_t));
+    std::size_t recordSize = RECORD_HEADER_SIZE + static_cast<std::size_t>(dataSize);
+    if(available < recordSize)
+        return false;
+
+    std::istringstream is(mSpectatorBuffer.substr(mSpectatorOffset, recordSize));
+    mPendingTimestamp = mPendingPacket.readPacket(is);
+    mSpectatorOffset += recordSize;
+
+    // We drop the records already read once they take most of the buffer
+    if(mSpectatorOffset * 2 >= mSpectatorBuffer.size())
+    {
+        mSpectatorBuffer.erase(0, mSpectatorOffset);
+        mSpectatorOffset = 0;
+    }
+    return mPendingTimestamp != -1;
+}
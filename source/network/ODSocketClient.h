@@ -27,6 +27,7 @@
 #include <fstream>
 
 class Player;
+class SpectatorRelay;
 
 enum class ServerNotificationType;
 
@@ -42,14 +43,18 @@ class ODSocketClient
         {
             none,
             network,
-            file
+            file,
+            spectator
         };
 
         ODSocketClient():
             mSource(ODSource::none),
             mPlayer(nullptr),
             mLastTurnAck(-1),
-            mPendingTimestamp(-1)
+            mPendingTimestamp(-1),
+            mSpectatorRelay(nullptr),
+            mSpectatorOffset(0),
+            mSpectatorStreamEnded(false)
         {}
 
         virtual ~ODSocketClient()
@@ -82,6 +87,10 @@ class ODSocketClient
         void setSource(ODSource source)
         { mSource = source; }
 
+        //! \brief Every packet sent to this client will also be recorded in the given relay
+        void setSpectatorRelay(SpectatorRelay* relay)
+        { mSpectatorRelay = relay; }
+
         // Data Transimission
         /*! \brief Sends a packet through the network
          * ODPacket should preserve integrity. That means that if an ODSocketClient
@@ -100,6 +109,9 @@ class ODSocketClient
     protected:
         virtual bool connect(const std::string& host, const int port, uint32_t timeout, const std::string& outputReplayFilename);
         virtual bool replay(const std::string& filename);
+        //! \brief Connects to the spectator relay of the server host:port. The stream received
+        //! is read like a replay
+        virtual bool spectate(const std::string& host, const int port, uint32_t timeout);
         inline ODSource getSource() const
         { return mSource; }
 
@@ -111,6 +123,10 @@ class ODSocketClient
     private :
         bool processOneClientSocketMessage();
 
+        //! \brief Reads the next complete record received from the spectator relay, if any,
+        //! into mPendingPacket. Returns true if a record was read
+        bool readSpectatorRecord();
+
         ODSource mSource;
         sf::SocketSelector mSockSelector;
         sf::TcpSocket mSockClient;
@@ -127,6 +143,13 @@ class ODSocketClient
         //! \brief the replay filename being written. Used to later optionally delete it
         //! if asked to.
         std::string mOutputReplayFilename;
+
+        SpectatorRelay* mSpectatorRelay;
+
+        //! \brief Bytes received from the spectator relay. Records are read from mSpectatorOffset
+        std::string mSpectatorBuffer;
+        std::size_t mSpectatorOffset;
+        bool mSpectatorStreamEnded;
 };
 
 #endif // ODSOCKETCLIENT_H
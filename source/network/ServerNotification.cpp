@@ -19,6 +19,22 @@
 
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/ObjectPool.h"
+
+namespace
+{
+ObjectPool sServerNotificationPool("ServerNotification", sizeof(ServerNotification));
+} // namespace <none>
+
+void* ServerNotification::operator new(std::size_t size)
+{
+    return sServerNotificationPool.allocate(size);
+}
+
+void ServerNotification::operator delete(void* ptr, std::size_t size)
+{
+    sServerNotificationPool.release(ptr, size);
+}
 
 ServerNotification::ServerNotification(ServerNotificationType type,
     Player* concernedPlayer) :
@@ -20,6 +20,7 @@
 
 #include "network/ODPacket.h"
 
+#include <cstddef>
 #include <deque>
 #include <string>
 #include <OgreVector3.h>
@@ -106,6 +107,10 @@ class ServerNotification
         virtual ~ServerNotification()
         {}
 
+        //! \brief Notifications are allocated from a pool (see ObjectPool)
+        static void* operator new(std::size_t size);
+        static void operator delete(void* ptr, std::size_t size);
+
         ODPacket mPacket;
 
         static std::string typeString(ServerNotificationType type);
@@ -0,0 +1,148 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "network/SpectatorRelay.h"
+
+#include "network/ODPacket.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <SFML/Config.hpp>
+
+SpectatorRelay::SpectatorRelay() :
+    mStarted(false),
+    mNbBytesSent(0)
+{
+}
+
+SpectatorRelay::~SpectatorRelay()
+{
+    stop();
+}
+
+bool SpectatorRelay::start(int32_t port)
+{
+    stop();
+
+    sf::Socket::Status status = mListener.listen(static_cast<unsigned short>(port));
+    if(status != sf::Socket::Done)
+    {
+        OD_LOG_ERR("Could not listen to spectator port=" + Helper::toString(port)
+            + ", status=" + Helper::toString(status));
+        return false;
+    }
+
+    // The relay is flushed from the server thread so it should never wait for spectators
+    mListener.setBlocking(false);
+    mStarted = true;
+    OD_LOG_INF("Relaying game to spectators on port=" + Helper::toString(port));
+    return true;
+}
+
+void SpectatorRelay::stop()
+{
+    if(!mStarted)
+        return;
+
+    for(Spectator& spectator : mSpectators)
+        spectator.mSocket->disconnect();
+
+    OD_LOG_INF("Spectator relay stopped spectators=" + Helper::toString(getNbSpectators())
+        + ", stream bytes=" + Helper::toString(getStreamSize())
+        + ", bytes sent=" + Helper::toString(mNbBytesSent));
+
+    mSpectators.clear();
+    mListener.close();
+    mStream.clear();
+    mNbBytesSent = 0;
+    mStarted = false;
+}
+
+void SpectatorRelay::recordPacket(const ODPacket& packet, int32_t timestamp)
+{
+    if(!mStarted)
+        return;
+
+    mRecord.str(std::string());
+    packet.writePacket(timestamp, mRecord);
+    mStream.append(mRecord.str());
+}
+
+void SpectatorRelay::flush()
+{
+    if(!mStarted)
+        return;
+
+    while(true)
+    {
+        Spectator spectator;
+        if(mListener.accept(*spectator.mSocket) != sf::Socket::Done)
+            break;
+
+        OD_LOG_INF("New spectator connected from " + spectator.mSocket->getRemoteAddress().toString());
+        spectator.mSocket->setBlocking(false);
+        mSpectators.push_back(std::move(spectator));
+    }
+
+    for(auto it = mSpectators.begin(); it != mSpectators.end();)
+    {
+        if(sendPending(*it))
+        {
+            ++it;
+            continue;
+        }
+
+        OD_LOG_INF("Spectator disconnected from " + it->mSocket->getRemoteAddress().toString());
+        it->mSocket->disconnect();
+        it = mSpectators.erase(it);
+    }
+}
+
+bool SpectatorRelay::sendPending(Spectator& spectator)
+{
+    if(spectator.mOffset >= mStream.size())
+        return true;
+
+    const char* data = mStream.data() + spectator.mOffset;
+    std::size_t size = static_cast<std::size_t>(mStream.size() - spectator.mOffset);
+#if (SFML_VERSION_MAJOR > 2) || (SFML_VERSION_MINOR >= 3)
+    // Slow spectators only get what their socket can take. The rest will be sent on the next turns
+    std::size_t sent = 0;
+    sf::Socket::Status status = spectator.mSocket->send(data, size, sent);
+    spectator.mOffset += sent;
+    mNbBytesSent += sent;
+    if((status == sf::Socket::Done) ||
+       (status == sf::Socket::Partial) ||
+       (status == sf::Socket::NotReady))
+    {
+        return true;
+    }
+#else
+    // Partial sends cannot be tracked on older SFML versions so the whole pending data is sent at once
+    spectator.mSocket->setBlocking(true);
+    sf::Socket::Status status = spectator.mSocket->send(data, size);
+    spectator.mSocket->setBlocking(false);
+    if(status == sf::Socket::Done)
+    {
+        spectator.mOffset += size;
+        mNbBytesSent += size;
+        return true;
+    }
+#endif
+
+    return false;
+}
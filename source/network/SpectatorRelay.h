@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPECTATORRELAY_H
+#define SPECTATORRELAY_H
+
+#include <SFML/Network.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class ODPacket;
+
+//! \brief Server side relay letting any number of spectators watch a game. The packets sent to
+//! the watched player are encoded once, in the replay record format, into a single stream. Each
+//! spectator only has an offset in this stream: once per turn, the bytes it did not receive yet
+//! are sent to it. Adding a spectator then only costs the bytes sent to it, there is no per
+//! spectator game state.
+//! Spectators joining late receive the whole stream from the beginning so that they can rebuild
+//! the game. As the stream is a replay, it can also be forwarded as is by an external relay.
+class SpectatorRelay
+{
+public:
+    SpectatorRelay();
+    ~SpectatorRelay();
+
+    //! \brief Starts listening for spectators on the given port. Returns false if it cannot be opened
+    bool start(int32_t port);
+
+    //! \brief Disconnects every spectator and clears the stream
+    void stop();
+
+    inline bool isStarted() const
+    { return mStarted; }
+
+    //! \brief Appends the given packet to the stream
+    void recordPacket(const ODPacket& packet, int32_t timestamp);
+
+    //! \brief Accepts the new spectators and sends each spectator the part of the stream it
+    //! did not receive yet. Should be called once per turn
+    void flush();
+
+    inline uint32_t getNbSpectators() const
+    { return static_cast<uint32_t>(mSpectators.size()); }
+
+    inline uint64_t getStreamSize() const
+    { return mStream.size(); }
+
+    inline uint64_t getNbBytesSent() const
+    { return mNbBytesSent; }
+
+private:
+    struct Spectator
+    {
+        Spectator() :
+            mSocket(new sf::TcpSocket),
+            mOffset(0)
+        {}
+
+        std::unique_ptr<sf::TcpSocket> mSocket;
+        //! \brief Number of bytes of the stream already sent to this spectator
+        uint64_t mOffset;
+    };
+
+    bool mStarted;
+    sf::TcpListener mListener;
+    std::vector<Spectator> mSpectators;
+
+    //! \brief Every record since the beginning of the game
+    std::string mStream;
+    //! \brief Used to encode the records before appending them to mStream
+    std::ostringstream mRecord;
+    uint64_t mNbBytesSent;
+
+    //! \brief Sends the given spectator the part of the stream it did not receive yet. Returns
+    //! false if the spectator disconnected
+    bool sendPending(Spectator& spectator);
+};
+
+#endif // SPECTATORRELAY_H
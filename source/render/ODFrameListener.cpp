@@ -198,7 +198,11 @@ bool ODFrameListener::frameRenderingQueued(const Ogre::FrameEvent& evt)
         mCameraManager.getActiveCameraOrientation());
 
     if((currentTurn != -1) && (mGameMap->getGamePaused()) && (!mExitRequested))
+    {
+        // Tiles changed locally while the game is paused still need to be refreshed
+        mRenderManager->rrRefreshQueuedTiles();
         return true;
+    }
 
     //If an exit has been requested, start cleaning up.
     if(mExitRequested == true || mContinue == false)
@@ -214,6 +218,9 @@ bool ODFrameListener::frameRenderingQueued(const Ogre::FrameEvent& evt)
     ODClient::getSingleton().processClientSocketMessages();
     ODClient::getSingleton().processClientNotifications();
 
+    // The tiles changed by the server messages are rebuilt before the next frame is rendered
+    mRenderManager->rrRefreshQueuedTiles();
+
     return mContinue;
 }
 
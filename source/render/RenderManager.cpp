@@ -43,6 +43,7 @@
 #include <OgreCamera.h>
 #include <OgreCompositorManager.h>
 #include <OgreEntity.h>
+#include <OgreMaterial.h>
 #include <OgreMaterialManager.h>
 #include <OgreMesh.h>
 #include <OgreMovableObject.h>
@@ -52,6 +53,7 @@
 #include <OgreSceneNode.h>
 #include <OgreSkeleton.h>
 #include <OgreSkeletonInstance.h>
+#include <OgreStaticGeometry.h>
 #include <OgreSubEntity.h>
 #include <OgreSubMesh.h>
 #include <OgreRoot.h>
@@ -88,7 +90,9 @@ RenderManager::RenderManager(Ogre::OverlaySystem* overlaySystem) :
     mFactorWidth(0.0f),
     mFactorHeight(0.0f),
     mCreatureTextOverlayDisplayed(false),
-    mHandKeeperHandVisibility(0)
+    mHandKeeperHandVisibility(0),
+    mTileChunksEnabled(false),
+    mTileChunksGameMap(nullptr)
 {
     // Use Ogre::SceneType enum instead of string to identify the scene manager type; this is more robust!
     mSceneManager = Ogre::Root::getSingleton().createSceneManager(Ogre::ST_INTERIOR, "SceneManager");
@@ -169,6 +173,11 @@ void RenderManager::stopGameRenderer(GameMap* gameMap)
         mSceneManager->destroyLight(mHandLight);
         mHandLight = nullptr;
     }
+
+    mTilesToRefresh.clear();
+    mOriginalMaterials.clear();
+    mMaterialVariants.clear();
+    destroyTileChunks();
 }
 
 void RenderManager::triggerCompositor(const std::string& compositorName)
@@ -582,6 +591,180 @@ void RenderManager::rrRefreshTile(const Tile& tile, const GameMap& gameMap, cons
 
         colourizeEntity(customMeshEnt, seatColor, isMarked, vision);
     }
+
+    // When tile chunks are used, the tile entities are only used as a source for the chunk geometry
+    if(tileMeshEnt != nullptr)
+        tileMeshEnt->setVisible(!mTileChunksEnabled);
+    if(customMeshEnt != nullptr)
+        customMeshEnt->setVisible(!mTileChunksEnabled);
+
+    markTileChunkDirty(tile);
+}
+
+void RenderManager::rrQueueTileRefresh(Tile& tile)
+{
+    ++mTileRefreshStats.mNbRefreshQueued;
+    mTilesToRefresh.insert(&tile);
+}
+
+void RenderManager::rrRefreshQueuedTiles()
+{
+    for(Tile* tile : mTilesToRefresh)
+    {
+        ++mTileRefreshStats.mNbRefreshDone;
+        GameMap* gameMap = tile->getGameMap();
+        rrRefreshTile(*tile, *gameMap, *gameMap->getLocalPlayer());
+    }
+    mTilesToRefresh.clear();
+
+    rebuildTileChunks();
+}
+
+void RenderManager::setTileChunksEnabled(bool enabled, GameMap& gameMap)
+{
+    if(mTileChunksEnabled == enabled)
+        return;
+
+    mTileChunksEnabled = enabled;
+    if(!mTileChunksEnabled)
+        destroyTileChunks();
+
+    // The tiles are refreshed to show/hide their entities and to build the chunks
+    for(int xx = 0; xx < gameMap.getMapSizeX(); ++xx)
+    {
+        for(int yy = 0; yy < gameMap.getMapSizeY(); ++yy)
+        {
+            Tile* tile = gameMap.getTile(xx, yy);
+            if(tile->getEntityNode() == nullptr)
+                continue;
+
+            rrQueueTileRefresh(*tile);
+        }
+    }
+}
+
+uint32_t RenderManager::getNbTileSceneNodes() const
+{
+    return mTileSceneNode->numChildren();
+}
+
+uint32_t RenderManager::getNbTileChunksBuilt() const
+{
+    uint32_t nbChunks = 0;
+    for(Ogre::StaticGeometry* chunk : mTileChunks)
+    {
+        if(chunk != nullptr)
+            ++nbChunks;
+    }
+    return nbChunks;
+}
+
+void RenderManager::markTileChunkDirty(const Tile& tile)
+{
+    if(!mTileChunksEnabled)
+        return;
+
+    const GameMap* gameMap = tile.getGameMap();
+    if((gameMap != mTileChunksGameMap) ||
+       (gameMap->getMapSizeX() != mTileChunkGrid.getMapSizeX()) ||
+       (gameMap->getMapSizeY() != mTileChunkGrid.getMapSizeY()))
+    {
+        destroyTileChunks();
+        mTileChunksGameMap = gameMap;
+        mTileChunkGrid.resize(gameMap->getMapSizeX(), gameMap->getMapSizeY(), TileChunkGrid::DEFAULT_CHUNK_SIZE);
+    }
+
+    mTileChunkGrid.markTileDirty(tile.getX(), tile.getY());
+}
+
+void RenderManager::rebuildTileChunks()
+{
+    if(!mTileChunksEnabled || (mTileChunksGameMap == nullptr) || !mTileChunkGrid.hasDirtyChunks())
+        return;
+
+    // If the map has been resized since the chunks were built, they have to be rebuilt from scratch
+    if((mTileChunksGameMap->getMapSizeX() != mTileChunkGrid.getMapSizeX()) ||
+       (mTileChunksGameMap->getMapSizeY() != mTileChunkGrid.getMapSizeY()))
+    {
+        const GameMap* gameMap = mTileChunksGameMap;
+        destroyTileChunks();
+        mTileChunksGameMap = gameMap;
+        mTileChunkGrid.resize(gameMap->getMapSizeX(), gameMap->getMapSizeY(), TileChunkGrid::DEFAULT_CHUNK_SIZE);
+    }
+
+    mTileChunks.resize(mTileChunkGrid.getNbChunks(), nullptr);
+    mTileChunkGrid.rebuildDirtyChunks([this](uint32_t chunkIndex)
+    {
+        rebuildTileChunk(chunkIndex);
+    });
+}
+
+void RenderManager::rebuildTileChunk(uint32_t chunkIndex)
+{
+    int x1;
+    int y1;
+    int x2;
+    int y2;
+    mTileChunkGrid.getChunkTiles(chunkIndex, x1, y1, x2, y2);
+
+    Ogre::StaticGeometry* chunk = mTileChunks[chunkIndex];
+    if(chunk == nullptr)
+    {
+        chunk = mSceneManager->createStaticGeometry("TileChunk_" + Helper::toString(chunkIndex));
+        // The whole chunk should fit in one region. Tile meshes are centered on their tile
+        Ogre::Real chunkSize = static_cast<Ogre::Real>(mTileChunkGrid.getChunkSize());
+        chunk->setRegionDimensions(Ogre::Vector3(chunkSize + 1.0f, chunkSize + 1.0f, 100.0f));
+        chunk->setOrigin(Ogre::Vector3(static_cast<Ogre::Real>(x1) - 1.0f, static_cast<Ogre::Real>(y1) - 1.0f, -50.0f));
+        chunk->setCastShadows(false);
+        mTileChunks[chunkIndex] = chunk;
+    }
+    else
+        chunk->reset();
+
+    bool hasGeometry = false;
+    for(int yy = y1; yy < y2; ++yy)
+    {
+        for(int xx = x1; xx < x2; ++xx)
+        {
+            Tile* tile = mTileChunksGameMap->getTile(xx, yy);
+            if((tile == nullptr) || (tile->getEntityNode() == nullptr))
+                continue;
+
+            std::string tileName = tile->getOgreNamePrefix() + tile->getName();
+            if(addTileMeshToChunk(*chunk, *tile, tileName + "_tileMesh"))
+                hasGeometry = true;
+            if(addTileMeshToChunk(*chunk, *tile, tileName + "_customMesh"))
+                hasGeometry = true;
+        }
+    }
+
+    if(hasGeometry)
+        chunk->build();
+}
+
+bool RenderManager::addTileMeshToChunk(Ogre::StaticGeometry& chunk, const Tile& tile, const std::string& meshName)
+{
+    if(!mSceneManager->hasEntity(meshName))
+        return false;
+
+    // The mesh node is a child of the tile node which is only translated
+    Ogre::Entity* ent = mSceneManager->getEntity(meshName);
+    Ogre::SceneNode* meshNode = mSceneManager->getSceneNode(meshName + "_node");
+    Ogre::Vector3 position(static_cast<Ogre::Real>(tile.getX()), static_cast<Ogre::Real>(tile.getY()), 0.0f);
+    chunk.addEntity(ent, position + meshNode->getPosition(), meshNode->getOrientation(), meshNode->getScale());
+    return true;
+}
+
+void RenderManager::destroyTileChunks()
+{
+    for(Ogre::StaticGeometry* chunk : mTileChunks)
+    {
+        if(chunk != nullptr)
+            mSceneManager->destroyStaticGeometry(chunk);
+    }
+    mTileChunks.clear();
+    mTileChunksGameMap = nullptr;
+    mTileChunkGrid.resize(0, 0, TileChunkGrid::DEFAULT_CHUNK_SIZE);
 }
 
 void RenderManager::rrCreateTile(Tile& tile, const GameMap& gameMap, const Player& localPlayer)
@@ -597,9 +780,14 @@ void RenderManager::rrCreateTile(Tile& tile, const GameMap& gameMap, const Playe
 
 void RenderManager::rrDestroyTile(Tile& tile)
 {
+    mTilesToRefresh.erase(&tile);
+
     if (tile.getEntityNode() == nullptr)
         return;
 
+    // The tile geometry has been copied in its chunk
+    markTileChunkDirty(tile);
+
     std::string tileName = tile.getOgreNamePrefix() + tile.getName();
     std::string selectorName = tileName + "_selection_indicator";
     if(mSceneManager->hasEntity(selectorName))
@@ -1251,20 +1439,68 @@ std::string RenderManager::consoleListAnimationsForMesh(const std::string& meshN
 
 void RenderManager::colourizeEntity(Ogre::Entity *ent, const Seat* seat, bool markedForDigging, bool playerHasVision)
 {
+    // The colourized materials are cached by material handle and variant so that refreshing a tile
+    // does not need to build material names nor to look for materials by name. The variant is
+    // built from the seat (0 if none) and the dig/vision taint (marked for digging has priority
+    // over vision like in colourizeMaterial)
+    uint32_t variant = (seat == nullptr) ? 0 : static_cast<uint32_t>(seat->getId() + 1) << 2;
+    if(markedForDigging)
+        variant |= 1;
+    else if(!playerHasVision)
+        variant |= 2;
+
     // Colorize the the textures
     // Loop over the sub entities in the mesh
     for (unsigned int i = 0; i < ent->getNumSubEntities(); ++i)
     {
         Ogre::SubEntity *tempSubEntity = ent->getSubEntity(i);
+        const Ogre::MaterialPtr& material = tempSubEntity->getMaterial();
+        if(material.isNull())
+            continue;
+
+        Ogre::MaterialPtr originalMaterial;
+        auto itOriginal = mOriginalMaterials.find(material->getHandle());
+        if(itOriginal != mOriginalMaterials.end())
+            originalMaterial = itOriginal->second;
+        else
+        {
+            // If the material name have been modified, we restore the original name
+            std::string materialName = material->getName();
+            std::size_t index = materialName.find("##");
+            if(index == std::string::npos)
+                originalMaterial = material;
+            else
+                originalMaterial = Ogre::MaterialManager::getSingleton().getByName(materialName.substr(0, index));
 
-        std::string materialName = tempSubEntity->getMaterialName();
-        // If the material name have been modified, we restore the original name
-        std::size_t index = materialName.find("##");
-        if(index != std::string::npos)
-            materialName = materialName.substr(0, index);
+            if(originalMaterial.isNull())
+            {
+                OD_LOG_ERR("Cannot find original material for " + materialName);
+                continue;
+            }
+            mOriginalMaterials[material->getHandle()] = originalMaterial;
+        }
 
-        materialName = colourizeMaterial(materialName, seat, markedForDigging, playerHasVision);
-        tempSubEntity->setMaterialName(materialName);
+        std::pair<uint64_t, uint32_t> key(originalMaterial->getHandle(), variant);
+        auto itVariant = mMaterialVariants.find(key);
+        if(itVariant != mMaterialVariants.end())
+        {
+            ++mTileRefreshStats.mNbMaterialCacheHits;
+            if(material != itVariant->second)
+                tempSubEntity->setMaterial(itVariant->second);
+            continue;
+        }
+
+        ++mTileRefreshStats.mNbMaterialCacheMisses;
+        std::string materialName = colourizeMaterial(originalMaterial->getName(), seat, markedForDigging, playerHasVision);
+        Ogre::MaterialPtr variantMaterial = Ogre::MaterialManager::getSingleton().getByName(materialName);
+        if(variantMaterial.isNull())
+        {
+            OD_LOG_ERR("Cannot find colourized material " + materialName);
+            continue;
+        }
+        mMaterialVariants[key] = variantMaterial;
+        mOriginalMaterials[variantMaterial->getHandle()] = originalMaterial;
+        tempSubEntity->setMaterial(variantMaterial);
     }
 }
 
@@ -22,8 +22,15 @@
 #ifndef RENDERMANAGER_H
 #define RENDERMANAGER_H
 
+#include "render/TileChunkGrid.h"
+
 #include <deque>
+#include <map>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 #include <OgreSingleton.h>
 #include <OgreMath.h>
 #include <cstdint>
@@ -47,12 +54,31 @@ class OverlaySystem;
 class SceneManager;
 class SceneNode;
 class ParticleSystem;
+class StaticGeometry;
 
 namespace RTShader {
     class ShaderGenerator;
 }
 } //End namespace Ogre
 
+//! \brief Counters allowing to measure the cost of the tiles refreshes on the client
+struct TileRefreshStats
+{
+    TileRefreshStats() :
+        mNbRefreshQueued(0),
+        mNbRefreshDone(0),
+        mNbMaterialCacheHits(0),
+        mNbMaterialCacheMisses(0)
+    {}
+
+    //! \brief Number of tile refreshes asked
+    uint64_t mNbRefreshQueued;
+    //! \brief Number of tile refreshes actually done (each queued tile is refreshed once per frame)
+    uint64_t mNbRefreshDone;
+    uint64_t mNbMaterialCacheHits;
+    uint64_t mNbMaterialCacheMisses;
+};
+
 class RenderManager: public Ogre::Singleton<RenderManager>
 {
 public:
@@ -98,6 +124,13 @@ public:
 
     //Render request functions
     void rrRefreshTile(const Tile& tile, const GameMap& gameMap, const Player& localPlayer);
+    //! \brief Queues the refresh of the given tile meshes. The queued tiles are refreshed once
+    //! per frame so that a tile refreshed several times during a frame (for example, when it
+    //! borders many tiles changed by the server) is rebuilt only once
+    void rrQueueTileRefresh(Tile& tile);
+    //! \brief Refreshes the tiles queued with rrQueueTileRefresh. Called by the frame listener
+    //! after the server messages of the frame have been processed
+    void rrRefreshQueuedTiles();
     void rrCreateTile(Tile& tile, const GameMap& gameMap, const Player& localPlayer);
     void rrDestroyTile(Tile& tile);
     void rrTemporalMarkTile(Tile* curTile);
@@ -132,6 +165,33 @@ public:
     void rrEntityRemoveParticleEffect(GameEntity* entity, Ogre::ParticleSystem* particleSystem);
     void rrToggleHandSelectorVisibility();
 
+    inline const TileRefreshStats& getTileRefreshStats() const
+    { return mTileRefreshStats; }
+
+    inline void resetTileRefreshStats()
+    { mTileRefreshStats = TileRefreshStats(); }
+
+    //! \brief When enabled, the tile meshes are not rendered one by one anymore. They are merged in
+    //! static geometries of TileChunkGrid::DEFAULT_CHUNK_SIZE x TileChunkGrid::DEFAULT_CHUNK_SIZE tiles
+    //! which are rebuilt when one of their tiles is refreshed and culled as a whole by Ogre.
+    //! Note that Ogre chooses the lights for a whole chunk so point lights (like the keeper hand one)
+    //! may not light every tile as they do with the per tile rendering.
+    void setTileChunksEnabled(bool enabled, GameMap& gameMap);
+
+    inline bool getTileChunksEnabled() const
+    { return mTileChunksEnabled; }
+
+    inline const TileChunkGrid& getTileChunkGrid() const
+    { return mTileChunkGrid; }
+
+    inline TileChunkGrid& getTileChunkGrid()
+    { return mTileChunkGrid; }
+
+    //! \brief Returns the number of scene nodes used for the tiles (not counting their children)
+    //! and the number of tile chunks currently built
+    uint32_t getNbTileSceneNodes() const;
+    uint32_t getNbTileChunksBuilt() const;
+
     //! \brief Toggles the creatures text overlay
     void rrSetCreaturesTextOverlay(GameMap& gameMap, bool value);
 
@@ -198,6 +258,18 @@ private:
     //! \returns The new material name according to the current opacity.
     std::string setMaterialOpacity(const std::string& materialName, float opacity);
 
+    //! \brief Marks the chunk containing the given tile as needing a rebuild if tile chunks are enabled
+    void markTileChunkDirty(const Tile& tile);
+
+    //! \brief Rebuilds the static geometry of every dirty chunk
+    void rebuildTileChunks();
+    void rebuildTileChunk(uint32_t chunkIndex);
+
+    //! \brief Adds the given tile mesh entity (if it exists) to the given chunk. Returns true if it was added
+    bool addTileMeshToChunk(Ogre::StaticGeometry& chunk, const Tile& tile, const std::string& meshName);
+
+    void destroyTileChunks();
+
     //! \brief Disables all animations of the given entity and starts the given one
     Ogre::AnimationState* setEntityAnimation(Ogre::Entity* ent, const std::string& animation, bool loop);
 
@@ -233,6 +305,26 @@ private:
 
     //! Bit array to allow to display tile hand (= 0) or not (!= 0)
     uint32_t mHandKeeperHandVisibility;
+
+    //! \brief Tiles waiting for rrRefreshQueuedTiles
+    std::unordered_set<Tile*> mTilesToRefresh;
+
+    //! \brief Uncolourized material for each material already given to colourizeEntity (including
+    //! the colourized ones), indexed by material handle
+    std::unordered_map<uint64_t, Ogre::MaterialPtr> mOriginalMaterials;
+
+    //! \brief Colourized materials indexed by the original material handle and the colourization
+    //! variant (see colourizeEntity)
+    std::map<std::pair<uint64_t, uint32_t>, Ogre::MaterialPtr> mMaterialVariants;
+
+    TileRefreshStats mTileRefreshStats;
+
+    bool mTileChunksEnabled;
+    //! \brief GameMap the chunks are built for
+    const GameMap* mTileChunksGameMap;
+    TileChunkGrid mTileChunkGrid;
+    //! \brief Static geometry of each chunk (nullptr if not built yet), indexed like in mTileChunkGrid
+    std::vector<Ogre::StaticGeometry*> mTileChunks;
 };
 
 #endif // RENDERMANAGER_H
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/TileChunkGrid.h"
+
+#include <algorithm>
+
+const int TileChunkGrid::DEFAULT_CHUNK_SIZE = 16;
+
+TileChunkGrid::TileChunkGrid() :
+    mMapSizeX(0),
+    mMapSizeY(0),
+    mChunkSize(DEFAULT_CHUNK_SIZE),
+    mNbChunksX(0),
+    mNbChunksY(0),
+    mNbTilesMarked(0),
+    mNbRebuilds(0)
+{
+}
+
+void TileChunkGrid::resize(int mapSizeX, int mapSizeY, int chunkSize)
+{
+    mMapSizeX = std::max(mapSizeX, 0);
+    mMapSizeY = std::max(mapSizeY, 0);
+    mChunkSize = std::max(chunkSize, 1);
+    mNbChunksX = (mMapSizeX + mChunkSize - 1) / mChunkSize;
+    mNbChunksY = (mMapSizeY + mChunkSize - 1) / mChunkSize;
+    mDirty.assign(static_cast<uint32_t>(mNbChunksX * mNbChunksY), false);
+    mDirtyChunks.clear();
+    markAllDirty();
+}
+
+int TileChunkGrid::getChunkIndex(int x, int y) const
+{
+    if(x < 0 || y < 0 || x >= mMapSizeX || y >= mMapSizeY)
+        return -1;
+
+    return (y / mChunkSize) * mNbChunksX + (x / mChunkSize);
+}
+
+void TileChunkGrid::getChunkTiles(uint32_t chunkIndex, int& x1, int& y1, int& x2, int& y2) const
+{
+    if(mNbChunksX <= 0)
+    {
+        x1 = y1 = x2 = y2 = 0;
+        return;
+    }
+
+    int chunkX = static_cast<int>(chunkIndex) % mNbChunksX;
+    int chunkY = static_cast<int>(chunkIndex) / mNbChunksX;
+    x1 = chunkX * mChunkSize;
+    y1 = chunkY * mChunkSize;
+    x2 = std::min(x1 + mChunkSize, mMapSizeX);
+    y2 = std::min(y1 + mChunkSize, mMapSizeY);
+}
+
+void TileChunkGrid::markTileDirty(int x, int y)
+{
+    int chunkIndex = getChunkIndex(x, y);
+    if(chunkIndex < 0)
+        return;
+
+    ++mNbTilesMarked;
+    if(mDirty[chunkIndex])
+        return;
+
+    mDirty[chunkIndex] = true;
+    mDirtyChunks.push_back(static_cast<uint32_t>(chunkIndex));
+}
+
+void TileChunkGrid::markAllDirty()
+{
+    for(uint32_t i = 0; i < mDirty.size(); ++i)
+    {
+        if(mDirty[i])
+            continue;
+
+        mDirty[i] = true;
+        mDirtyChunks.push_back(i);
+    }
+}
+
+void TileChunkGrid::resetStats()
+{
+    mNbTilesMarked = 0;
+    mNbRebuilds = 0;
+}
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILECHUNKGRID_H
+#define TILECHUNKGRID_H
+
+#include <cstdint>
+#include <vector>
+
+//! \brief Splits the map in square chunks of tiles and keeps track of the chunks that have to
+//! be rebuilt because one of their tiles changed. It does not know anything about rendering so
+//! that it can be used (and measured) without Ogre. The RenderManager uses it to merge the tile
+//! meshes of each chunk in a single static geometry.
+class TileChunkGrid
+{
+public:
+    static const int DEFAULT_CHUNK_SIZE;
+
+    TileChunkGrid();
+
+    //! \brief Sets the map size. Every chunk is marked as dirty
+    void resize(int mapSizeX, int mapSizeY, int chunkSize);
+
+    inline int getMapSizeX() const
+    { return mMapSizeX; }
+
+    inline int getMapSizeY() const
+    { return mMapSizeY; }
+
+    inline int getChunkSize() const
+    { return mChunkSize; }
+
+    inline int getNbChunksX() const
+    { return mNbChunksX; }
+
+    inline int getNbChunksY() const
+    { return mNbChunksY; }
+
+    inline uint32_t getNbChunks() const
+    { return static_cast<uint32_t>(mDirty.size()); }
+
+    //! \brief Returns the index of the chunk containing the given tile or -1 if outside the map
+    int getChunkIndex(int x, int y) const;
+
+    //! \brief Gets the tiles covered by the given chunk. x2 and y2 are excluded
+    void getChunkTiles(uint32_t chunkIndex, int& x1, int& y1, int& x2, int& y2) const;
+
+    //! \brief Marks the chunk containing the given tile as needing a rebuild
+    void markTileDirty(int x, int y);
+
+    //! \brief Marks every chunk as needing a rebuild
+    void markAllDirty();
+
+    inline bool hasDirtyChunks() const
+    { return !mDirtyChunks.empty(); }
+
+    //! \brief Calls func(chunkIndex) once for every dirty chunk and clears the dirty flags
+    template<typename Func>
+    void rebuildDirtyChunks(Func func)
+    {
+        // func may mark tiles dirty again. They will be processed on the next call
+        std::vector<uint32_t> dirtyChunks;
+        dirtyChunks.swap(mDirtyChunks);
+        for(uint32_t chunkIndex : dirtyChunks)
+        {
+            mDirty[chunkIndex] = false;
+            ++mNbRebuilds;
+            func(chunkIndex);
+        }
+    }
+
+    //! \brief Number of times a tile was marked as dirty
+    inline uint64_t getNbTilesMarked() const
+    { return mNbTilesMarked; }
+
+    //! \brief Number of chunks rebuilt
+    inline uint64_t getNbRebuilds() const
+    { return mNbRebuilds; }
+
+    void resetStats();
+
+private:
+    int mMapSizeX;
+    int mMapSizeY;
+    int mChunkSize;
+    int mNbChunksX;
+    int mNbChunksY;
+    std::vector<bool> mDirty;
+    std::vector<uint32_t> mDirtyChunks;
+    uint64_t mNbTilesMarked;
+    uint64_t mNbRebuilds;
+};
+
+#endif // TILECHUNKGRID_H
@@ -37,12 +37,17 @@
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
 
+#include <algorithm>
 #include <istream>
 #include <ostream>
+#include <utility>
 
 Room::Room(GameMap* gameMap):
     Building(gameMap),
-    mNumActiveSpots(0)
+    mNumActiveSpots(0),
+    mIsFootprintValid(false),
+    mNextAppendedKey(0),
+    mNbAppendedKeys(0)
 {
 }
 
@@ -117,11 +122,30 @@ void Room::absorbRoom(Room *r)
     mBuildingObjects.insert(r->mBuildingObjects.begin(), r->mBuildingObjects.end());
     r->mBuildingObjects.clear();
 
+    // When a tile is built next to a big room, the new room absorbs the big one. In that case, we take the
+    // footprint of the absorbed room and add our tiles to it instead of adding every absorbed tile to ours
+    bool isFootprintTaken = r->mIsFootprintValid &&
+        (!mIsFootprintValid || (r->mFootprint.getNbTiles() > mFootprint.getNbTiles()));
+    if(isFootprintTaken)
+    {
+        std::swap(mFootprint, r->mFootprint);
+        std::swap(mFootprintChanges, r->mFootprintChanges);
+        std::swap(mNextAppendedKey, r->mNextAppendedKey);
+        std::swap(mNbAppendedKeys, r->mNbAppendedKeys);
+        mIsFootprintValid = true;
+        for(Tile* tile : mCoveredTiles)
+            notifyCoveredTileAppended(tile);
+    }
+    r->mIsFootprintValid = false;
+
     // We consider that the new room will be composed with the covered tiles it uses + the covered tiles absorbed. In the
     // absorbed room, we consider all tiles as destroyed. It will get removed from gamemap when enemy vision will be cleared
     for(Tile* tile : r->mCoveredTiles)
     {
         mCoveredTiles.push_back(tile);
+        if(!isFootprintTaken)
+            notifyCoveredTileAppended(tile);
+
         TileData* tileData = r->mTileData[tile];
         mTileData[tile] = tileData->cloneTileData();
         tileData->mHP = 0.0;
@@ -225,7 +249,10 @@ void Room::checkForRoomAbsorbtion()
     }
 
     if(isRoomAbsorbed)
+    {
         reorderRoomTiles(mCoveredTiles);
+        notifyCoveredTilesSorted();
+    }
 }
 
 void Room::updateActiveSpots()
@@ -236,70 +263,12 @@ void Room::updateActiveSpots()
     std::vector<Tile*> topWallsActiveSpotTiles;
     std::vector<Tile*> bottomWallsActiveSpotTiles;
 
-    // Detect the centers of 3x3 squares tiles
-    for(unsigned int i = 0, size = mCoveredTiles.size(); i < size; ++i)
-    {
-        bool foundTop = false;
-        bool foundTopLeft = false;
-        bool foundTopRight = false;
-        bool foundLeft = false;
-        bool foundRight = false;
-        bool foundBottomLeft = false;
-        bool foundBottomRight = false;
-        bool foundBottom = false;
-        Tile* tile = mCoveredTiles[i];
-        int tileX = tile->getX();
-        int tileY = tile->getY();
-
-        // Check all other tiles to know whether we have one center tile.
-        for(unsigned int j = 0; j < size; ++j)
-        {
-            // Don't check the tile itself
-            if (tile == mCoveredTiles[j])
-                continue;
-
-            // Check whether the tile around the tile checked is already a center spot
-            // as we can't have two center spots next to one another.
-            if (std::find(centralActiveSpotTiles.begin(), centralActiveSpotTiles.end(), mCoveredTiles[j]) != centralActiveSpotTiles.end())
-                continue;
-
-            int tile2X = mCoveredTiles[j]->getX();
-            int tile2Y = mCoveredTiles[j]->getY();
-
-            if(tile2X == tileX - 1)
-            {
-                if (tile2Y == tileY + 1)
-                    foundTopLeft = true;
-                else if (tile2Y == tileY)
-                    foundLeft = true;
-                else if (tile2Y == tileY - 1)
-                    foundBottomLeft = true;
-            }
-            else if(tile2X == tileX)
-            {
-                if (tile2Y == tileY + 1)
-                    foundTop = true;
-                else if (tile2Y == tileY - 1)
-                    foundBottom = true;
-            }
-            else if(tile2X == tileX + 1)
-            {
-                if (tile2Y == tileY + 1)
-                    foundTopRight = true;
-                else if (tile2Y == tileY)
-                    foundRight = true;
-                else if (tile2Y == tileY - 1)
-                    foundBottomRight = true;
-            }
-        }
-
-        // Check whether we found a tile at the center of others
-        if (foundTop && foundTopLeft && foundTopRight && foundLeft && foundRight
-                && foundBottomLeft && foundBottomRight && foundBottom)
-        {
-            centralActiveSpotTiles.push_back(tile);
-        }
-    }
+    // Only the neighborhood of the tiles added or removed since the last call is checked. Most calls
+    // come from claimed walls changing next to the room. In that case, the centers did not change
+    refreshFootprint();
+    centralActiveSpotTiles.reserve(mFootprint.getCenters().size());
+    for(const std::pair<const int64_t, std::pair<int, int>>& center : mFootprint.getCenters())
+        centralActiveSpotTiles.push_back(getGameMap()->getTile(center.second.first, center.second.second));
 
     // Now that we've got the center tiles, we can test the tile around for walls.
     for (unsigned int i = 0, size = centralActiveSpotTiles.size(); i < size; ++i)
@@ -449,14 +418,132 @@ void Room::updateActiveSpots()
                       + mTopWallsActiveSpotTiles.size() + mBottomWallsActiveSpotTiles.size();
 }
 
+bool Room::removeCoveredTile(Tile* t)
+{
+    if(!Building::removeCoveredTile(t))
+        return false;
+
+    if(mIsFootprintValid)
+        mFootprintChanges.push_back(std::make_pair(t, RoomFootprint::NOT_COVERED));
+
+    return true;
+}
+
+int64_t Room::getSortedTileKey(const Tile* tile) const
+{
+    return static_cast<int64_t>(tile->getX()) * getGameMap()->getMapSizeY() + tile->getY();
+}
+
+int64_t Room::getFirstAppendedKey() const
+{
+    return static_cast<int64_t>(getGameMap()->getMapSizeX()) * getGameMap()->getMapSizeY();
+}
+
+void Room::notifyCoveredTileAppended(Tile* tile)
+{
+    if(!mIsFootprintValid)
+        return;
+
+    mFootprintChanges.push_back(std::make_pair(tile, mNextAppendedKey));
+    ++mNextAppendedKey;
+}
+
+void Room::notifyCoveredTilesSorted()
+{
+    if(!mIsFootprintValid)
+        return;
+
+    // The tiles already in the footprint keep their key. It is only possible if it is their position key
+    if(mNbAppendedKeys > 0)
+    {
+        mIsFootprintValid = false;
+        mFootprintChanges.clear();
+        return;
+    }
+
+    for(std::pair<Tile*, int64_t>& change : mFootprintChanges)
+    {
+        if(change.second != RoomFootprint::NOT_COVERED)
+            change.second = getSortedTileKey(change.first);
+    }
+    mNextAppendedKey = getFirstAppendedKey();
+}
+
+void Room::refreshFootprint()
+{
+    int64_t firstAppendedKey = getFirstAppendedKey();
+    if(mIsFootprintValid)
+    {
+        for(const std::pair<Tile*, int64_t>& change : mFootprintChanges)
+        {
+            Tile* tile = change.first;
+            if(change.second == RoomFootprint::NOT_COVERED)
+            {
+                if(mFootprint.removeTile(tile->getX(), tile->getY()) >= firstAppendedKey)
+                    --mNbAppendedKeys;
+
+                continue;
+            }
+
+            if(mFootprint.getKey(tile->getX(), tile->getY()) != RoomFootprint::NOT_COVERED)
+            {
+                OD_LOG_ERR("room=" + getName() + ", tile added twice=" + Tile::displayAsString(tile));
+                mIsFootprintValid = false;
+                break;
+            }
+
+            mFootprint.addTile(tile->getX(), tile->getY(), change.second);
+            if(change.second >= firstAppendedKey)
+                ++mNbAppendedKeys;
+        }
+
+        // Covered tiles can be changed without going through the functions above (for example when
+        // they are cleared). In that case, the footprint is built again
+        if(mFootprint.getNbTiles() != mCoveredTiles.size())
+            mIsFootprintValid = false;
+    }
+    mFootprintChanges.clear();
+
+    if(!mIsFootprintValid)
+    {
+        // If the tiles are sorted, we use the position keys so that the footprint can be kept when
+        // tiles are added and sorted again. Otherwise, keys follow the order of mCoveredTiles
+        mFootprint.clear();
+        mNbAppendedKeys = 0;
+        mNextAppendedKey = firstAppendedKey;
+        bool isSorted = std::is_sorted(mCoveredTiles.begin(), mCoveredTiles.end(), Room::compareTile);
+        for(Tile* tile : mCoveredTiles)
+        {
+            if(isSorted)
+            {
+                mFootprint.addTile(tile->getX(), tile->getY(), getSortedTileKey(tile));
+                continue;
+            }
+
+            mFootprint.addTile(tile->getX(), tile->getY(), mNextAppendedKey);
+            ++mNextAppendedKey;
+            ++mNbAppendedKeys;
+        }
+        mIsFootprintValid = true;
+    }
+
+    mFootprint.updateCenters();
+}
+
 void Room::activeSpotCheckChange(ActiveSpotPlace place, const std::vector<Tile*>& originalSpotTiles,
     const std::vector<Tile*>& newSpotTiles)
 {
+    // Sorted copies allow to check the differences without comparing every pair of tiles. We
+    // still go through the original vectors to notify the changes in the same order
+    std::vector<Tile*> originalSorted = originalSpotTiles;
+    std::sort(originalSorted.begin(), originalSorted.end());
+    std::vector<Tile*> newSorted = newSpotTiles;
+    std::sort(newSorted.begin(), newSorted.end());
+
     // We create the non existing tiles
-    for(std::vector<Tile*>::const_iterator it = newSpotTiles.begin(); it != newSpotTiles.end(); ++it)
+    for(Tile* tile : newSpotTiles)
     {
-        Tile* tile = *it;
-        if(std::find(originalSpotTiles.begin(), originalSpotTiles.end(), tile) == originalSpotTiles.end())
+        if(!std::binary_search(originalSorted.begin(), originalSorted.end(), tile))
         {
             // The tile do not exist
             BuildingObject* ro = notifyActiveSpotCreated(place, tile);
@@ -469,10 +556,9 @@ void Room::activeSpotCheckChange(ActiveSpotPlace place, const std::vector<Tile*>
         }
     }
     // We remove the suppressed tiles
-    for(std::vector<Tile*>::const_iterator it = originalSpotTiles.begin(); it != originalSpotTiles.end(); ++it)
+    for(Tile* tile : originalSpotTiles)
     {
-        Tile* tile = *it;
-        if(std::find(newSpotTiles.begin(), newSpotTiles.end(), tile) == newSpotTiles.end())
+        if(!std::binary_search(newSorted.begin(), newSorted.end(), tile))
         {
             // The tile has been removed
             notifyActiveSpotRemoved(place, tile);
@@ -665,6 +751,7 @@ void Room::repairRoom()
         OD_LOG_INF("Repairing room=" + getName() + ", tile=" + Tile::displayAsString(tile));
 
         mCoveredTiles.push_back(tile);
+        notifyCoveredTileAppended(tile);
         TileData* tileData;
         auto it = mTileData.find(tile);
         if(it != mTileData.end())
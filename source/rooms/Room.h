@@ -19,9 +19,12 @@
 #define ROOM_H
 
 #include "entities/Building.h"
+#include "rooms/RoomFootprint.h"
 
+#include <cstdint>
 #include <string>
 #include <iosfwd>
+#include <utility>
 
 class BuildingObject;
 class GameMap;
@@ -52,6 +55,8 @@ public:
 
     virtual void absorbRoom(Room* r);
 
+    virtual bool removeCoveredTile(Tile* t) override;
+
     //! \brief By default, we consider that creatures using the room are working and
     //! should be forced to work in the new room (if possible). If not, this function
     //! should be overriden
@@ -169,9 +174,44 @@ protected:
     //! \brief This function will be called when reordering room is needed (for example if another room has been absorbed)
     static void reorderRoomTiles(std::vector<Tile*>& tiles);
 private :
+    //! \brief Covered tiles with the centers of 3x3 squares used for the central active spots. The key
+    //! of a tile gives its order in mCoveredTiles. When mCoveredTiles is sorted with compareTile, the
+    //! key only depends on the tile position (see getSortedTileKey). Tiles added at the end of an
+    //! unsorted mCoveredTiles get keys greater than any position key
+    RoomFootprint mFootprint;
+
+    //! \brief False if the footprint has to be built again from mCoveredTiles by the next
+    //! updateActiveSpots (first call, tiles reordered, ...)
+    bool mIsFootprintValid;
+
+    //! \brief Tiles added (with their key) or removed (with RoomFootprint::NOT_COVERED) since the
+    //! last updateActiveSpots
+    std::vector<std::pair<Tile*, int64_t>> mFootprintChanges;
+
+    //! \brief Key given to the next tile added at the end of an unsorted mCoveredTiles
+    int64_t mNextAppendedKey;
+
+    //! \brief Number of tiles in the footprint with a key that is not a position key
+    uint32_t mNbAppendedKeys;
+
     void activeSpotCheckChange(ActiveSpotPlace place, const std::vector<Tile*>& originalSpotTiles,
         const std::vector<Tile*>& newSpotTiles);
 
+    //! \brief Key of the given tile when mCoveredTiles is sorted with compareTile
+    int64_t getSortedTileKey(const Tile* tile) const;
+
+    //! \brief Lowest key given to the tiles added at the end of an unsorted mCoveredTiles
+    int64_t getFirstAppendedKey() const;
+
+    //! \brief Records a tile pushed at the end of mCoveredTiles for the next footprint update
+    void notifyCoveredTileAppended(Tile* tile);
+
+    //! \brief Called after mCoveredTiles has been sorted with compareTile
+    void notifyCoveredTilesSorted();
+
+    //! \brief Applies the changes to the footprint and updates its centers. The footprint is built
+    //! again from mCoveredTiles if needed
+    void refreshFootprint();
 };
 
 #endif // ROOM_H
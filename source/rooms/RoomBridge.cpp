@@ -231,7 +231,7 @@ bool BridgeRoomFactory::readBridgeFromPacket(std::vector<Tile*>& tiles, GameMap*
             break;
         }
 
-        const std::vector<Tile*>& neighs = tile->getAllNeighbors();
+        TileNeighbors neighs = tile->getAllNeighbors();
         bool isOk = isEditor;
         // We check if it is the next tile from the bridge
         if(!tiles.empty() &&
@@ -351,7 +351,9 @@ void RoomBridge::claimForSeat(Seat* seat, Tile* tile, double danceRate)
 
     OD_LOG_INF("Bridge=" + getName() + " claimed by seat id=" + Helper::toString(seat->getId()));
     mClaimedValue = static_cast<double>(numCoveredTiles());
+    getSeat()->removeRoomFromLedger(this);
     setSeat(seat);
+    seat->addRoomToLedger(this);
 
     for(Tile* tile : mCoveredTiles)
         tile->claimTile(seat);
@@ -23,7 +23,7 @@
 
 class Tile;
 
-enum class TileVisual;
+enum class TileVisual : uint8_t;
 
 class BridgeRoomFactory : public RoomFactory
 {
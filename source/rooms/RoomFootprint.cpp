@@ -0,0 +1,229 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "rooms/RoomFootprint.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+const int64_t RoomFootprint::NOT_COVERED = -1;
+
+//! \brief Tiles added around the grid when it grows so that a growing room does not
+//! reallocate it each time
+static const int GRID_MARGIN = 4;
+
+RoomFootprint::RoomFootprint() :
+    mMinX(0),
+    mMinY(0),
+    mSizeX(0),
+    mSizeY(0),
+    mNbTiles(0)
+{
+}
+
+void RoomFootprint::clear()
+{
+    mMinX = 0;
+    mMinY = 0;
+    mSizeX = 0;
+    mSizeY = 0;
+    mCells.clear();
+    mNbTiles = 0;
+    mCenters.clear();
+    mChangedTiles.clear();
+}
+
+void RoomFootprint::addTile(int x, int y, int64_t key)
+{
+    Cell* cell = getCell(x, y);
+    if(cell == nullptr)
+    {
+        growGrid(x, y);
+        cell = getCell(x, y);
+    }
+
+    if(cell->mKey == NOT_COVERED)
+        ++mNbTiles;
+
+    cell->mKey = key;
+    cell->mIsCenter = false;
+    mChangedTiles.push_back(std::make_pair(x, y));
+}
+
+int64_t RoomFootprint::removeTile(int x, int y)
+{
+    Cell* cell = getCell(x, y);
+    if((cell == nullptr) || (cell->mKey == NOT_COVERED))
+        return NOT_COVERED;
+
+    int64_t key = cell->mKey;
+    if(cell->mIsCenter)
+        mCenters.erase(key);
+
+    cell->mKey = NOT_COVERED;
+    cell->mIsCenter = false;
+    --mNbTiles;
+    mChangedTiles.push_back(std::make_pair(x, y));
+    return key;
+}
+
+int64_t RoomFootprint::getKey(int x, int y) const
+{
+    const Cell* cell = getCell(x, y);
+    if(cell == nullptr)
+        return NOT_COVERED;
+
+    return cell->mKey;
+}
+
+bool RoomFootprint::isCenter(int x, int y) const
+{
+    const Cell* cell = getCell(x, y);
+    if(cell == nullptr)
+        return false;
+
+    return cell->mIsCenter;
+}
+
+void RoomFootprint::updateCenters()
+{
+    // Tiles to check by increasing key. The changed tiles and their neighbors are checked
+    typedef std::pair<int64_t, std::pair<int, int>> QueuedTile;
+    std::priority_queue<QueuedTile, std::vector<QueuedTile>, std::greater<QueuedTile>> tilesToCheck;
+    for(const std::pair<int, int>& tile : mChangedTiles)
+    {
+        for(int dy = -1; dy <= 1; ++dy)
+        {
+            for(int dx = -1; dx <= 1; ++dx)
+            {
+                int64_t key = getKey(tile.first + dx, tile.second + dy);
+                if(key == NOT_COVERED)
+                    continue;
+
+                tilesToCheck.push(std::make_pair(key, std::make_pair(tile.first + dx, tile.second + dy)));
+            }
+        }
+    }
+    mChangedTiles.clear();
+
+    // A tile can be queued several times. As keys are unique, its entries are next to each other
+    int64_t lastKey = NOT_COVERED;
+    while(!tilesToCheck.empty())
+    {
+        QueuedTile queued = tilesToCheck.top();
+        tilesToCheck.pop();
+        int64_t key = queued.first;
+        if(key == lastKey)
+            continue;
+
+        lastKey = key;
+        int x = queued.second.first;
+        int y = queued.second.second;
+        Cell* cell = getCell(x, y);
+        bool isCenter = computeIsCenter(x, y, key);
+        if(cell->mIsCenter == isCenter)
+            continue;
+
+        cell->mIsCenter = isCenter;
+        if(isCenter)
+            mCenters.emplace(key, queued.second);
+        else
+            mCenters.erase(key);
+
+        // Only the neighbors coming after this tile depend on it
+        for(int dy = -1; dy <= 1; ++dy)
+        {
+            for(int dx = -1; dx <= 1; ++dx)
+            {
+                int64_t neighKey = getKey(x + dx, y + dy);
+                if(neighKey <= key)
+                    continue;
+
+                tilesToCheck.push(std::make_pair(neighKey, std::make_pair(x + dx, y + dy)));
+            }
+        }
+    }
+}
+
+RoomFootprint::Cell* RoomFootprint::getCell(int x, int y)
+{
+    if((x < mMinX) || (y < mMinY) || (x >= mMinX + mSizeX) || (y >= mMinY + mSizeY))
+        return nullptr;
+
+    return &mCells[(y - mMinY) * mSizeX + x - mMinX];
+}
+
+const RoomFootprint::Cell* RoomFootprint::getCell(int x, int y) const
+{
+    if((x < mMinX) || (y < mMinY) || (x >= mMinX + mSizeX) || (y >= mMinY + mSizeY))
+        return nullptr;
+
+    return &mCells[(y - mMinY) * mSizeX + x - mMinX];
+}
+
+void RoomFootprint::growGrid(int x, int y)
+{
+    int minX = x - GRID_MARGIN;
+    int minY = y - GRID_MARGIN;
+    int maxX = x + GRID_MARGIN;
+    int maxY = y + GRID_MARGIN;
+    if(!mCells.empty())
+    {
+        minX = std::min(minX, mMinX);
+        minY = std::min(minY, mMinY);
+        maxX = std::max(maxX, mMinX + mSizeX - 1);
+        maxY = std::max(maxY, mMinY + mSizeY - 1);
+    }
+
+    int sizeX = maxX - minX + 1;
+    int sizeY = maxY - minY + 1;
+    std::vector<Cell> cells(static_cast<uint32_t>(sizeX * sizeY));
+    for(int yy = 0; yy < mSizeY; ++yy)
+    {
+        std::copy(mCells.begin() + yy * mSizeX, mCells.begin() + (yy + 1) * mSizeX,
+            cells.begin() + (mMinY + yy - minY) * sizeX + mMinX - minX);
+    }
+
+    mMinX = minX;
+    mMinY = minY;
+    mSizeX = sizeX;
+    mSizeY = sizeY;
+    mCells.swap(cells);
+}
+
+bool RoomFootprint::computeIsCenter(int x, int y, int64_t key) const
+{
+    for(int dy = -1; dy <= 1; ++dy)
+    {
+        for(int dx = -1; dx <= 1; ++dx)
+        {
+            if((dx == 0) && (dy == 0))
+                continue;
+
+            // Centers need a full ring of covered tiles around them
+            const Cell* cell = getCell(x + dx, y + dy);
+            if((cell == nullptr) || (cell->mKey == NOT_COVERED))
+                return false;
+
+            // We can't have two center spots next to one another
+            if((cell->mKey < key) && cell->mIsCenter)
+                return false;
+        }
+    }
+
+    return true;
+}
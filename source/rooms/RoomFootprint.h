@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ROOMFOOTPRINT_H
+#define ROOMFOOTPRINT_H
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+//! \brief Tiles covered by a room, stored on a grid around the room so that the neighbors of a tile
+//! can be looked up without going through the covered tiles. It keeps the centers of 3x3 squares used
+//! for the central active spots.
+//! Each tile has a key giving its order in the room tiles. Tiles are checked by increasing key and a
+//! tile next to a center coming before it cannot be a center, so the centers depend on that order.
+//! When tiles are added or removed, only their neighborhood is checked again. A tile whose center state
+//! changes can only change the neighbors coming after it, which are checked in turn.
+class RoomFootprint
+{
+public:
+    static const int64_t NOT_COVERED;
+
+    RoomFootprint();
+
+    //! \brief Removes every tile
+    void clear();
+
+    //! \brief Adds the tile at (x, y). Tiles with a lower key come first. Keys must be unique and
+    //! not negative. The centers are only updated by updateCenters
+    void addTile(int x, int y, int64_t key);
+
+    //! \brief Removes the tile at (x, y) and returns its key (NOT_COVERED if it was not covered).
+    //! The centers are only updated by updateCenters
+    int64_t removeTile(int x, int y);
+
+    //! \brief Returns the key of the tile at (x, y) or NOT_COVERED
+    int64_t getKey(int x, int y) const;
+
+    //! \brief Returns true if the tile at (x, y) is a center
+    bool isCenter(int x, int y) const;
+
+    inline uint32_t getNbTiles() const
+    { return mNbTiles; }
+
+    //! \brief Updates the centers around the tiles added or removed since the last call
+    void updateCenters();
+
+    //! \brief Centers sorted by key. Values are the (x, y) coordinates of the center
+    inline const std::map<int64_t, std::pair<int, int>>& getCenters() const
+    { return mCenters; }
+
+private:
+    struct Cell
+    {
+        Cell() :
+            mKey(NOT_COVERED),
+            mIsCenter(false)
+        {}
+
+        int64_t mKey;
+        bool mIsCenter;
+    };
+
+    //! \brief Grid origin and size. The grid grows when a tile outside of it is added
+    int mMinX;
+    int mMinY;
+    int mSizeX;
+    int mSizeY;
+    std::vector<Cell> mCells;
+
+    uint32_t mNbTiles;
+    std::map<int64_t, std::pair<int, int>> mCenters;
+
+    //! \brief Tiles added or removed since the last call to updateCenters
+    std::vector<std::pair<int, int>> mChangedTiles;
+
+    //! \brief Returns the cell at (x, y) or nullptr if it is outside of the grid
+    Cell* getCell(int x, int y);
+    const Cell* getCell(int x, int y) const;
+
+    //! \brief Grows the grid so that it contains (x, y)
+    void growGrid(int x, int y);
+
+    //! \brief Returns true if the covered tile at (x, y) with the given key is a center. The tiles with
+    //! a lower key must be up to date
+    bool computeIsCenter(int x, int y, int64_t key) const;
+};
+
+#endif // ROOMFOOTPRINT_H
@@ -147,7 +147,9 @@ void RoomPortal::claimForSeat(Seat* seat, Tile* tile, double danceRate)
     }
 
     mClaimedValue = static_cast<double>(numCoveredTiles());
+    getSeat()->removeRoomFromLedger(this);
     setSeat(seat);
+    seat->addRoomToLedger(this);
 
     for(Tile* tile : mCoveredTiles)
         tile->claimTile(seat);
@@ -24,6 +24,7 @@
 #include "entities/Tile.h"
 #include "game/Player.h"
 #include "game/Seat.h"
+#include "gamemap/DigCostField.h"
 #include "gamemap/Pathfinding.h"
 #include "gamemap/GameMap.h"
 #include "network/ODServer.h"
@@ -100,38 +101,6 @@ class RoomPortalWaveFactory : public RoomFactory
 static RoomRegister reg(new RoomPortalWaveFactory);
 }
 
-class TileSearch
-{
-public:
-    TileSearch() :
-        mTile(nullptr),
-        mRotationClockWise(false),
-        mRotationCounterClockWise(false)
-    {}
-
-    static std::pair<int,int> computeNextRotation(const std::pair<int,int>& currentRotation,
-        bool rotationClockWise)
-    {
-        if(rotationClockWise)
-        {
-            int newY = currentRotation.first;
-            int newX = currentRotation.second * -1;
-            return std::pair<int, int>(newX, newY);
-        }
-        else
-        {
-            int newY = currentRotation.first * -1;
-            int newX = currentRotation.second;
-            return std::pair<int, int>(newX, newY);
-        }
-    }
-
-    Tile* mTile;
-    bool mRotationClockWise;
-    bool mRotationCounterClockWise;
-    std::pair<int,int> mDirectionHit;
-};
-
 static const double CLAIMED_VALUE_PER_TILE = 1.0;
 
 RoomPortalWave::RoomPortalWave(GameMap* gameMap) :
@@ -879,214 +848,53 @@ bool RoomPortalWave::handleDigging()
         return false;
     }
 
-    bool isWayFound = false;
-    tilesToMark.clear();
+    // We go for the dungeon that needs the least digging. They are sorted by distance so
+    // that the closest one is taken if several cost the same
+    Room* bestDungeon = nullptr;
+    uint32_t bestCost = DigCostField::NO_WAY;
     for(std::pair<Room*,Ogre::Real>& p : tileDungeons)
     {
-        mMarkedTilesToEnemy.clear();
         Tile* tileDungeon = p.first->getCentralTile();
         if(tileDungeon == nullptr)
             continue;
 
-        if(!findBestDiggablePath(tileStart, tileDungeon, creature, mMarkedTilesToEnemy) &&
-           mMarkedTilesToEnemy.empty())
-        {
+        uint32_t cost = getGameMap()->getDigCost(*creature, getSeat(), tileStart, tileDungeon, false);
+        if(cost >= bestCost)
             continue;
-        }
-
-        if(mTargetDungeon != nullptr)
-            mTargetDungeon->removeGameEntityListener(this);
 
-        mTargetDungeon = p.first;
-        mTargetDungeon->addGameEntityListener(this);
-        OD_LOG_INF("PortalWave=" + getName()+ " wants to attack dungeon=" + mTargetDungeon->getName());
-        isWayFound = true;
-        for(Tile* tile : mMarkedTilesToEnemy)
-            tilesToMark.push_back(tile);
-
-        break;
+        bestCost = cost;
+        bestDungeon = p.first;
     }
 
-    if(!isWayFound)
+    if(bestDungeon == nullptr)
         return false;
 
-    getSeat()->getPlayer()->markTilesForDigging(true, tilesToMark, false);
-
-    return true;
-}
-
-bool RoomPortalWave::findBestDiggablePath(Tile* tileStart, Tile* tileDest, Creature* creature, std::vector<Tile*>& tiles)
-{
-    if(!creature->canGoThroughTile(tileStart) &&
-       !tileStart->isDiggable(creature->getSeat()))
+    mMarkedTilesToEnemy.clear();
+    if(!getGameMap()->findTilesToDig(*creature, getSeat(), tileStart, bestDungeon->getCentralTile(), false, mMarkedTilesToEnemy))
     {
+        OD_LOG_ERR("room=" + getName() + ", dungeon=" + bestDungeon->getName());
         return false;
     }
 
-    std::vector<std::pair<int, int>> rotations;
-    std::vector<TileSearch> blockingTiles;
-    Tile* tile = tileStart;
-    Tile* lastTileBlocked = nullptr;
-    bool currentRotationClockWise = false;
-    while(true)
-    {
-        if(tile == tileDest)
-            return true;
-
-        if(tile == nullptr)
-        {
-            // We reach the end of the map.
-            // We try the last blocking tile we found in the other direction (if any)
-            lastTileBlocked = nullptr;
-            for(auto it = blockingTiles.rbegin(); it != blockingTiles.rend(); ++it)
-            {
-                TileSearch& tileSearch = *it;
-                if(tileSearch.mRotationClockWise &&
-                   tileSearch.mRotationCounterClockWise)
-                {
-                    continue;
-                }
-
-                lastTileBlocked = tileSearch.mTile;
-                if(tileSearch.mRotationClockWise)
-                {
-                    tileSearch.mRotationCounterClockWise = true;
-                    currentRotationClockWise = false;
-                }
-                else
-                {
-                    tileSearch.mRotationClockWise = true;
-                    currentRotationClockWise = true;
-                }
-
-                rotations.clear();
-                rotations.push_back(tileSearch.mDirectionHit);
-                rotations.push_back(TileSearch::computeNextRotation(rotations.back(), currentRotationClockWise));
-                break;
-            }
-
-            if(lastTileBlocked == nullptr)
-                return false;
+    if(mTargetDungeon != nullptr)
+        mTargetDungeon->removeGameEntityListener(this);
 
-            tile = getGameMap()->getTile(lastTileBlocked->getX() + rotations.back().first, lastTileBlocked->getY() + rotations.back().second);
-        }
+    mTargetDungeon = bestDungeon;
+    mTargetDungeon->addGameEntityListener(this);
+    OD_LOG_INF("PortalWave=" + getName()+ " wants to attack dungeon=" + mTargetDungeon->getName());
 
-        // A nullptr tile is possible if we are searching near the map border after applying the rotation
-        if(tile == nullptr)
+    tilesToMark.clear();
+    for(Tile* tile : mMarkedTilesToEnemy)
+    {
+        if(tile->getMarkedForDigging(getSeat()->getPlayer()))
             continue;
 
-        bool isTilePassable = false;
-        // If the tile is walkable, no need to dig it
-        if(creature->canGoThroughTile(tile))
-        {
-            isTilePassable = true;
-        }
-        else if(tile->getMarkedForDigging(creature->getSeat()->getPlayer()))
-        {
-            isTilePassable = true;
-        }
-        else if(tile->isDiggable(creature->getSeat()))
-        {
-            tiles.push_back(tile);
-            isTilePassable = true;
-        }
-
-        if(isTilePassable)
-        {
-            // The tile is passable. If we were rotating, we try the next rotation
-            // If not, we continue our way
-            if(!rotations.empty())
-                rotations.pop_back();
-
-            if(rotations.empty())
-            {
-                int diffX = tileDest->getX() - tile->getX();
-                int diffY = tileDest->getY() - tile->getY();
-                if(std::abs(diffX) > std::abs(diffY))
-                {
-                    if(diffX < 0)
-                        rotations.push_back(std::pair<int, int>(-1, 0));
-                    else
-                        rotations.push_back(std::pair<int, int>(1, 0));
-                }
-                else
-                {
-                    if(diffY < 0)
-                        rotations.push_back(std::pair<int, int>(0, -1));
-                    else
-                        rotations.push_back(std::pair<int, int>(0, 1));
-                }
-
-                // We are not blocked
-                lastTileBlocked = nullptr;
-            }
-            tile = getGameMap()->getTile(tile->getX() + rotations.back().first, tile->getY() + rotations.back().second);
-        }
-        else
-        {
-            // We start from the previous tile (that was good to go)
-            tile = getGameMap()->getTile(tile->getX() - rotations.back().first, tile->getY() - rotations.back().second);
-            if(tile == nullptr)
-            {
-                OD_LOG_ERR("room=" + getName());
-                return false;
-            }
-
-            // Tile is not passable. We try to go around. If we are not already following a wall, we start to
-            if(lastTileBlocked == nullptr)
-            {
-                // We check if we already hit this tile
-                bool isFound = false;
-                for(TileSearch& tileSearch : blockingTiles)
-                {
-                    if(tileSearch.mTile != tile)
-                        continue;
-
-                    // We already hit this tile. We stop searching this way
-                    isFound = true;
-                }
-
-                if(isFound)
-                {
-                    tile = nullptr;
-                    continue;
-                }
-
-                // We have never been blocked here
-                lastTileBlocked = tile;
+        tilesToMark.push_back(tile);
+    }
 
-                int diffX = tileDest->getX() - tile->getX();
-                int diffY = tileDest->getY() - tile->getY();
-                if(rotations.back().first == 0)
-                {
-                    if(diffX < 0)
-                        currentRotationClockWise = (rotations.back().second > 0);
-                    else
-                        currentRotationClockWise = (rotations.back().second < 0);
-                }
-                else // rotations.back().second should be 0
-                {
-                    if(diffY < 0)
-                        currentRotationClockWise = (rotations.back().first < 0);
-                    else
-                        currentRotationClockWise = (rotations.back().first > 0);
-                }
-                TileSearch tileSearch;
-                tileSearch.mTile = tile;
-                tileSearch.mDirectionHit = rotations.back();
-                if(currentRotationClockWise)
-                    tileSearch.mRotationClockWise = true;
-                else
-                    tileSearch.mRotationCounterClockWise = true;
-
-                blockingTiles.push_back(tileSearch);
-            }
+    getSeat()->getPlayer()->markTilesForDigging(true, tilesToMark, false);
 
-            // We set next direction
-            rotations.push_back(TileSearch::computeNextRotation(rotations.back(), currentRotationClockWise));
-            tile = getGameMap()->getTile(tile->getX() + rotations.back().first, tile->getY() + rotations.back().second);
-        }
-    }
+    return true;
 }
 
 void RoomPortalWave::handleFirstUpkeep()
@@ -157,12 +157,6 @@ private:
     //! \brief Updates the portal mesh position.
     void updatePortalPosition();
 
-    //! \brief Finds the best diggable path between tileStart and tileDest.
-    //! Note that a path is returned even if tileDest is not reachable. It should go around
-    //! the undiggable tiles
-    //! Returns true if a path was found to the dungeon and false otherwise
-    bool findBestDiggablePath(Tile* tileStart, Tile* tileDest, Creature* creature, std::vector<Tile*>& tiles);
-
     //! \brief Spawns a wave
     void spawnWave(RoomPortalWaveData* roomPortalWaveData, uint32_t maxCreaturesToSpawn);
 
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE BenchmarkReport
+#include "BoostTestTargetConfig.h"
+
+#include "utils/BenchmarkReport.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+BenchmarkResult makeResult(const std::string& level, const std::string& benchmark, uint32_t runs,
+    int64_t totalUs, uint64_t checksum)
+{
+    BenchmarkResult result;
+    result.mLevel = level;
+    result.mBenchmark = benchmark;
+    result.mRuns = runs;
+    result.mTotalUs = totalUs;
+    result.mChecksum = checksum;
+    return result;
+}
+} // namespace <none>
+
+BOOST_AUTO_TEST_CASE(test_BenchmarkReportJson)
+{
+    std::vector<BenchmarkResult> results;
+    results.push_back(makeResult("b.level", "path", 200, 5000, 1234));
+    results.push_back(makeResult("a.level", "visibleTiles r5", 200, 300, 42));
+    results.push_back(makeResult("a.level", "path", 10, 0, 0));
+    BenchmarkReport::sortResults(results);
+    BOOST_CHECK(results[0].mLevel == "a.level" && results[0].mBenchmark == "path");
+    BOOST_CHECK(results[1].mLevel == "a.level" && results[1].mBenchmark == "visibleTiles r5");
+    BOOST_CHECK(results[2].mLevel == "b.level");
+
+    // Writing twice the same results gives the same text
+    std::string json = BenchmarkReport::toJson(results);
+    BOOST_CHECK(json == BenchmarkReport::toJson(results));
+
+    std::stringstream ss(json);
+    std::vector<BenchmarkResult> read;
+    BOOST_CHECK(BenchmarkReport::fromJson(ss, read));
+    BOOST_CHECK(read.size() == results.size());
+    for(uint32_t i = 0; i < read.size() && i < results.size(); ++i)
+    {
+        BOOST_CHECK(read[i].mLevel == results[i].mLevel);
+        BOOST_CHECK(read[i].mBenchmark == results[i].mBenchmark);
+        BOOST_CHECK(read[i].mRuns == results[i].mRuns);
+        BOOST_CHECK(read[i].mTotalUs == results[i].mTotalUs);
+        BOOST_CHECK(read[i].mChecksum == results[i].mChecksum);
+    }
+
+    std::stringstream empty("{}");
+    read.clear();
+    BOOST_CHECK(!BenchmarkReport::fromJson(empty, read));
+}
+
+BOOST_AUTO_TEST_CASE(test_BenchmarkReportCompare)
+{
+    std::vector<BenchmarkResult> baseline;
+    baseline.push_back(makeResult("a.level", "path", 100, 1000, 1));
+    baseline.push_back(makeResult("a.level", "circularRegion r10", 100, 1000, 2));
+    baseline.push_back(makeResult("a.level", "enableFloodFill", 5, 500, 3));
+
+    std::vector<BenchmarkResult> results;
+    // 5% slower is within the tolerance
+    results.push_back(makeResult("a.level", "path", 100, 1050, 1));
+    // 50% slower
+    results.push_back(makeResult("a.level", "circularRegion r10", 100, 1500, 2));
+    // Faster but different result
+    results.push_back(makeResult("a.level", "enableFloodFill", 5, 100, 4));
+    // Not in the baseline
+    results.push_back(makeResult("a.level", "forEachTileBetween", 1000, 100, 5));
+
+    std::string report;
+    BOOST_CHECK(BenchmarkReport::compare(results, baseline, 0.1, report) == 2);
+    BOOST_CHECK(report.find("SLOWER") != std::string::npos);
+    BOOST_CHECK(report.find("RESULT CHANGED") != std::string::npos);
+    BOOST_CHECK(report.find("not in baseline") != std::string::npos);
+
+    BOOST_CHECK(BenchmarkReport::compare(results, results, 0.1, report) == 0);
+}
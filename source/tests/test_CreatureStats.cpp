@@ -0,0 +1,130 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE CreatureStats
+#include "BoostTestTargetConfig.h"
+
+#include "creatureaction/CreatureAction.h"
+#include "creaturemood/CreatureMood.h"
+#include "entities/CreatureStats.h"
+#include "network/ODPacket.h"
+
+namespace
+{
+CreatureStats buildStats()
+{
+    CreatureStats stats;
+    stats.mIsWorker = true;
+    stats.mLevel = 7;
+    stats.mExp = 123.5;
+    stats.mHp = 42.0;
+    stats.mMaxHP = 80.0;
+    stats.mGoldCarried = 250;
+    stats.mWakefulness = 61.0;
+    stats.mHunger = 12.0;
+    stats.mMoveSpeedGround = 1.5;
+    stats.mMoveSpeedWater = 0.5;
+    stats.mMoveSpeedLava = 0.25;
+    stats.mWeaponL.mEquipped = true;
+    stats.mWeaponL.mName = "Pickaxe";
+    stats.mWeaponL.mPhysicalDamage = 3.0;
+    stats.mWeaponL.mMagicalDamage = 0.5;
+    stats.mWeaponL.mElementDamage = 1.0;
+    stats.mPhysicalDefense = 2.0;
+    stats.mMagicalDefense = 1.0;
+    stats.mElementDefense = 4.0;
+    stats.mDigRate = 0.8;
+    stats.mClaimRate = 0.6;
+    stats.mSeatId = 2;
+    stats.mTeamId = 1;
+    stats.mPosition = Ogre::Vector3(12.0, 5.0, 0.0);
+    stats.mActions.push_back(CreatureActionType::searchTileToDig);
+    stats.mActions.push_back(CreatureActionType::digTile);
+    stats.mDestinations.push_back(Ogre::Vector3(13.0, 5.0, 0.0));
+    stats.mDestinations.push_back(Ogre::Vector3(14.0, 6.0, 0.0));
+    stats.mMoodValue = CreatureMoodLevel::Upset;
+    stats.mMoodPoints = -35;
+    return stats;
+}
+} // namespace <none>
+
+BOOST_AUTO_TEST_CASE(test_CreatureStatsFullRecord)
+{
+    const CreatureStats stats = buildStats();
+    BOOST_CHECK(stats.getChangedFields(CreatureStats()) != 0);
+
+    ODPacket packet;
+    stats.exportToPacket(packet, CreatureStats::FieldAll);
+
+    CreatureStats imported;
+    BOOST_REQUIRE(imported.importFromPacket(packet));
+    BOOST_CHECK_EQUAL(imported.getChangedFields(stats), 0u);
+    BOOST_CHECK_EQUAL(imported.mImportedFields, CreatureStats::FieldAll);
+    BOOST_CHECK(imported.toString() == stats.toString());
+}
+
+BOOST_AUTO_TEST_CASE(test_CreatureStatsDelta)
+{
+    const CreatureStats previous = buildStats();
+    CreatureStats current = previous;
+    current.mHp = 30.0;
+    current.mMoodValue = CreatureMoodLevel::Angry;
+    current.mActions.pop_back();
+
+    const uint32_t fields = current.getChangedFields(previous);
+    BOOST_CHECK_EQUAL(fields, CreatureStats::FieldHP | CreatureStats::FieldActions | CreatureStats::FieldMood);
+
+    // Applying the delta to the previous record gives the current one
+    ODPacket packet;
+    current.exportToPacket(packet, fields);
+    CreatureStats client = previous;
+    BOOST_REQUIRE(client.importFromPacket(packet));
+    BOOST_CHECK_EQUAL(client.getChangedFields(current), 0u);
+
+    // Only the fields in the mask are sent
+    ODPacket packetPartial;
+    current.exportToPacket(packetPartial, fields);
+    CreatureStats partial;
+    BOOST_REQUIRE(partial.importFromPacket(packetPartial));
+    BOOST_CHECK_EQUAL(partial.mImportedFields, fields);
+    BOOST_CHECK_EQUAL(partial.mHp, current.mHp);
+    BOOST_CHECK(partial.mMoodValue == CreatureMoodLevel::Angry);
+    BOOST_CHECK_EQUAL(partial.mActions.size(), 1u);
+    BOOST_CHECK_EQUAL(partial.mLevel, 0u);
+    BOOST_CHECK(partial.mDestinations.empty());
+    BOOST_CHECK(!partial.mWeaponL.mEquipped);
+}
+
+BOOST_AUTO_TEST_CASE(test_CreatureStatsUnchanged)
+{
+    const CreatureStats stats = buildStats();
+    CreatureStats copy = stats;
+    BOOST_CHECK_EQUAL(copy.getChangedFields(stats), 0u);
+
+    // Values of a weapon that is not equipped are not displayed so they do not count as a change
+    CreatureStats noWeapon = stats;
+    noWeapon.mWeaponR.mName = "Ignored";
+    noWeapon.mWeaponR.mPhysicalDamage = 9.0;
+    BOOST_CHECK_EQUAL(noWeapon.getChangedFields(stats), 0u);
+
+    // An empty mask does not carry any value
+    ODPacket packet;
+    stats.exportToPacket(packet, 0);
+    CreatureStats imported;
+    BOOST_REQUIRE(imported.importFromPacket(packet));
+    BOOST_CHECK_EQUAL(imported.getChangedFields(CreatureStats()), 0u);
+}
@@ -0,0 +1,69 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE MiniMapRaster
+#include "BoostTestTargetConfig.h"
+
+#include "gamemap/MiniMapRaster.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(test_MiniMapRaster)
+{
+    MiniMapRaster raster;
+    raster.resize(20, 10);
+    uint32_t xMin;
+    uint32_t xMax;
+    uint32_t yMin;
+    uint32_t yMax;
+    BOOST_CHECK(raster.takeDirtyRect(xMin, xMax, yMin, yMax));
+    BOOST_CHECK(xMin == 0 && xMax == 20 && yMin == 0 && yMax == 10);
+    BOOST_CHECK(!raster.hasDirtyRect());
+
+    // Only the changed pixels are dirty
+    raster.fillTileColour(2, 4, 3, 5, 0x123456);
+    raster.fillTileColour(6, 7, 1, 2, 0x654321);
+    BOOST_CHECK(raster.takeDirtyRect(xMin, xMax, yMin, yMax));
+    BOOST_CHECK(xMin == 2 && xMax == 7 && yMin == 1 && yMax == 5);
+    BOOST_CHECK(raster.getPixel(3, 4) == 0x123456);
+    BOOST_CHECK(raster.getPixel(6, 1) == 0x654321);
+
+    // Setting the same colour again does not dirty anything
+    raster.fillTileColour(2, 4, 3, 5, 0x123456);
+    BOOST_CHECK(!raster.hasDirtyRect());
+
+    // The frustum outline is drawn over the tile colours
+    raster.fillTileColour(0, 20, 0, 10, 0xFFFFFF);
+    raster.takeDirtyRect(xMin, xMax, yMin, yMax);
+    std::vector<std::pair<int, int>> corners = { {5, 2}, {10, 2}, {10, 6}, {5, 6} };
+    raster.setFrustum(corners);
+    BOOST_CHECK(raster.takeDirtyRect(xMin, xMax, yMin, yMax));
+    BOOST_CHECK(xMin == 5 && xMax == 11 && yMin == 2 && yMax == 7);
+    BOOST_CHECK(raster.getPixel(5, 2) == MiniMapRaster::FRUSTUM_COLOUR);
+    BOOST_CHECK(raster.getPixel(7, 6) == MiniMapRaster::FRUSTUM_COLOUR);
+    BOOST_CHECK(raster.getPixel(7, 4) == 0xFFFFFF);
+
+    // Moving the frustum erases the previous outline. Corners outside the raster are clipped
+    corners = { {15, 8}, {25, 8}, {25, 12}, {15, 12} };
+    raster.setFrustum(corners);
+    BOOST_CHECK(raster.takeDirtyRect(xMin, xMax, yMin, yMax));
+    BOOST_CHECK(xMin == 5 && xMax == 20 && yMin == 2 && yMax == 10);
+    BOOST_CHECK(raster.getPixel(5, 2) == 0xFFFFFF);
+    BOOST_CHECK(raster.getPixel(17, 8) == MiniMapRaster::FRUSTUM_COLOUR);
+}
@@ -20,6 +20,8 @@
 
 #include "network/ODPacket.h"
 
+#include <sstream>
+
 BOOST_AUTO_TEST_CASE(test_ODPacket)
 {
     //Test input/output
@@ -53,4 +55,21 @@ BOOST_AUTO_TEST_CASE(test_ODPacket)
         BOOST_CHECK(inInt == outInt);
 
     }
+    //Test replay records
+    {
+        ODPacket packet1;
+        packet1 << std::string("record1");
+        ODPacket packet2;
+        packet2 << static_cast<int32_t>(42);
+        std::stringstream ss;
+        packet1.writePacket(10, ss);
+        packet2.writePacket(20, ss);
+
+        ODPacket readPacket;
+        BOOST_CHECK(readPacket.readPacket(ss) == 10);
+        BOOST_CHECK(readPacket == packet1);
+        BOOST_CHECK(readPacket.readPacket(ss) == 20);
+        BOOST_CHECK(readPacket == packet2);
+        BOOST_CHECK(readPacket.readPacket(ss) == -1);
+    }
 }
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE ObjectPool
+#include "BoostTestTargetConfig.h"
+
+#include "utils/ObjectPool.h"
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace
+{
+struct PooledObject
+{
+    PooledObject(int value) :
+        mValue(value)
+    {}
+    virtual ~PooledObject()
+    {}
+
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
+    int mValue;
+};
+
+struct BiggerPooledObject : public PooledObject
+{
+    BiggerPooledObject() :
+        PooledObject(0)
+    {}
+
+    double mOther[4];
+};
+
+ObjectPool pool("PooledObject", sizeof(PooledObject), 4);
+
+void* PooledObject::operator new(std::size_t size)
+{
+    return pool.allocate(size);
+}
+
+void PooledObject::operator delete(void* ptr, std::size_t size)
+{
+    pool.release(ptr, size);
+}
+} // namespace <none>
+
+BOOST_AUTO_TEST_CASE(test_ObjectPool)
+{
+    // Filling several slabs
+    std::vector<PooledObject*> objects;
+    std::set<PooledObject*> addresses;
+    for(int i = 0; i < 10; ++i)
+    {
+        objects.push_back(new PooledObject(i));
+        addresses.insert(objects.back());
+    }
+    BOOST_CHECK(addresses.size() == 10);
+    BOOST_CHECK(pool.getNbSlabs() == 3);
+    BOOST_CHECK(pool.getNbUsed() == 10);
+    for(int i = 0; i < 10; ++i)
+        BOOST_CHECK(objects[i]->mValue == i);
+
+    // Handles are invalidated when the object is deleted
+    ObjectPoolHandle handle = ObjectPool::findHandle(objects[3]);
+    BOOST_CHECK(!handle.isNull());
+    BOOST_CHECK(ObjectPool::isHandleAlive(handle));
+    delete objects[3];
+    BOOST_CHECK(!ObjectPool::isHandleAlive(handle));
+    BOOST_CHECK(pool.getNbUsed() == 9);
+
+    // Released slots are reused but old handles stay invalid
+    PooledObject* reused = new PooledObject(42);
+    BOOST_CHECK(reused == objects[3]);
+    BOOST_CHECK(!ObjectPool::isHandleAlive(handle));
+    BOOST_CHECK(ObjectPool::isHandleAlive(ObjectPool::findHandle(reused)));
+    objects[3] = reused;
+    BOOST_CHECK(pool.getNbSlabs() == 3);
+    BOOST_CHECK(pool.getPeakUsed() == 10);
+
+    // Bigger derived objects go to the heap and have no handle
+    PooledObject* bigger = new BiggerPooledObject();
+    BOOST_CHECK(pool.getNbHeapAllocations() == 1);
+    BOOST_CHECK(ObjectPool::findHandle(bigger).isNull());
+    BOOST_CHECK(!ObjectPool::isHandleAlive(ObjectPool::findHandle(bigger)));
+    delete bigger;
+    BOOST_CHECK(pool.getNbUsed() == 10);
+
+    // Smaller objects use the pool slots
+    ObjectPool sharedPool("Shared", sizeof(BiggerPooledObject), 4);
+    void* small = sharedPool.allocate(sizeof(int));
+    BOOST_CHECK(!ObjectPool::findHandle(small).isNull());
+    BOOST_CHECK(sharedPool.getNbHeapAllocations() == 0);
+    sharedPool.release(small, sizeof(int));
+    BOOST_CHECK(sharedPool.getNbUsed() == 0);
+
+    int dummy = 0;
+    BOOST_CHECK(ObjectPool::findHandle(&dummy).isNull());
+
+    for(PooledObject* object : objects)
+        delete object;
+    BOOST_CHECK(pool.getNbUsed() == 0);
+    BOOST_CHECK(pool.getNbAllocations() == 12);
+}
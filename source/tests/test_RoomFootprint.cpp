@@ -0,0 +1,166 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#define BOOST_TEST_MODULE RoomFootprint
+#include "BoostTestTargetConfig.h"
+
+#include "rooms/RoomFootprint.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+const int MAP_SIZE = 24;
+
+//! \brief Room tiles stored like Room::mCoveredTiles. Tiles are sorted by key
+typedef std::map<int64_t, std::pair<int, int>> RoomTiles;
+
+//! \brief Reference centers computed like Room::updateActiveSpots used to: every tile is checked
+//! in the room order and a tile next to a center found before it cannot be a center
+std::map<int64_t, std::pair<int, int>> buildReference(const RoomTiles& tiles)
+{
+    std::vector<int64_t> keys(MAP_SIZE * MAP_SIZE, RoomFootprint::NOT_COVERED);
+    for(const std::pair<const int64_t, std::pair<int, int>>& tile : tiles)
+        keys[tile.second.second * MAP_SIZE + tile.second.first] = tile.first;
+
+    std::vector<bool> isCenter(MAP_SIZE * MAP_SIZE, false);
+    std::map<int64_t, std::pair<int, int>> centers;
+    for(const std::pair<const int64_t, std::pair<int, int>>& tile : tiles)
+    {
+        int x = tile.second.first;
+        int y = tile.second.second;
+        bool isTileCenter = true;
+        for(int dy = -1; dy <= 1; ++dy)
+        {
+            for(int dx = -1; dx <= 1; ++dx)
+            {
+                if((dx == 0) && (dy == 0))
+                    continue;
+
+                int xx = x + dx;
+                int yy = y + dy;
+                if((xx < 0) || (yy < 0) || (xx >= MAP_SIZE) || (yy >= MAP_SIZE) ||
+                   (keys[yy * MAP_SIZE + xx] == RoomFootprint::NOT_COVERED) || isCenter[yy * MAP_SIZE + xx])
+                {
+                    isTileCenter = false;
+                }
+            }
+        }
+
+        if(!isTileCenter)
+            continue;
+
+        isCenter[y * MAP_SIZE + x] = true;
+        centers.emplace(tile.first, tile.second);
+    }
+    return centers;
+}
+
+//! \brief Key of a tile when the room tiles are sorted like Room::compareTile does
+inline int64_t sortedKey(int x, int y)
+{
+    return static_cast<int64_t>(x) * MAP_SIZE + y;
+}
+} // namespace <none>
+
+BOOST_AUTO_TEST_CASE(test_RoomFootprintSquare)
+{
+    // A 6x6 room sorted column by column gets 4 centers
+    RoomFootprint footprint;
+    RoomTiles tiles;
+    for(int x = 5; x < 11; ++x)
+    {
+        for(int y = 5; y < 11; ++y)
+        {
+            footprint.addTile(x, y, sortedKey(x, y));
+            tiles.emplace(sortedKey(x, y), std::make_pair(x, y));
+        }
+    }
+    footprint.updateCenters();
+    BOOST_CHECK(footprint.getNbTiles() == 36);
+    BOOST_CHECK(footprint.getCenters() == buildReference(tiles));
+    BOOST_CHECK(footprint.getCenters().size() == 4);
+    BOOST_CHECK(footprint.isCenter(6, 6));
+    BOOST_CHECK(!footprint.isCenter(7, 7));
+
+    // Removing the first center shifts the centers next to it
+    BOOST_CHECK(footprint.removeTile(6, 6) == sortedKey(6, 6));
+    tiles.erase(sortedKey(6, 6));
+    footprint.updateCenters();
+    BOOST_CHECK(footprint.getCenters() == buildReference(tiles));
+    BOOST_CHECK(footprint.getKey(6, 6) == RoomFootprint::NOT_COVERED);
+    BOOST_CHECK(footprint.removeTile(6, 6) == RoomFootprint::NOT_COVERED);
+
+    // Tiles outside of the grid make it grow
+    footprint.addTile(0, 0, sortedKey(0, 0));
+    footprint.addTile(MAP_SIZE - 1, MAP_SIZE - 1, sortedKey(MAP_SIZE - 1, MAP_SIZE - 1));
+    tiles.emplace(sortedKey(0, 0), std::make_pair(0, 0));
+    tiles.emplace(sortedKey(MAP_SIZE - 1, MAP_SIZE - 1), std::make_pair(MAP_SIZE - 1, MAP_SIZE - 1));
+    footprint.updateCenters();
+    BOOST_CHECK(footprint.getCenters() == buildReference(tiles));
+    BOOST_CHECK(footprint.getKey(10, 10) == sortedKey(10, 10));
+
+    footprint.clear();
+    BOOST_CHECK(footprint.getNbTiles() == 0);
+    BOOST_CHECK(footprint.getCenters().empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_RoomFootprintIncremental)
+{
+    std::srand(42);
+    RoomFootprint footprint;
+    RoomTiles tiles;
+    std::vector<int64_t> keys(MAP_SIZE * MAP_SIZE, RoomFootprint::NOT_COVERED);
+    // Tiles added with the sorted key are placed in the room order like after an absorption. Tiles
+    // added with a greater key are added at the end like when a room is repaired
+    int64_t nextAppendedKey = MAP_SIZE * MAP_SIZE;
+    for(uint32_t step = 0; step < 400; ++step)
+    {
+        uint32_t nbChanges = 1 + static_cast<uint32_t>(std::rand() % 8);
+        for(uint32_t i = 0; i < nbChanges; ++i)
+        {
+            // Rooms are mostly made of blocks so that there are centers to find
+            int x = 2 + std::rand() % (MAP_SIZE - 4);
+            int y = 2 + std::rand() % (MAP_SIZE - 4);
+            int64_t& key = keys[y * MAP_SIZE + x];
+            if(key != RoomFootprint::NOT_COVERED && (std::rand() % 3 == 0))
+            {
+                BOOST_REQUIRE(footprint.removeTile(x, y) == key);
+                tiles.erase(key);
+                key = RoomFootprint::NOT_COVERED;
+                continue;
+            }
+
+            if(key != RoomFootprint::NOT_COVERED)
+                continue;
+
+            key = (std::rand() % 4 == 0) ? nextAppendedKey++ : sortedKey(x, y);
+            footprint.addTile(x, y, key);
+            tiles.emplace(key, std::make_pair(x, y));
+        }
+        footprint.updateCenters();
+        BOOST_REQUIRE(footprint.getNbTiles() == tiles.size());
+        BOOST_REQUIRE(footprint.getCenters() == buildReference(tiles));
+    }
+
+    // Nothing changed
+    footprint.updateCenters();
+    BOOST_CHECK(footprint.getCenters() == buildReference(tiles));
+}
@@ -0,0 +1,215 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE TileBitPlane
+#include "BoostTestTargetConfig.h"
+
+#include "gamemap/TileAreaTable.h"
+#include "gamemap/TileBitPlane.h"
+#include "gamemap/TileLineWalker.h"
+#include "gamemap/TileWindowPlane.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(test_TileBitPlane)
+{
+    // 13 x 11 tiles do not fit in a whole number of words
+    TileBitPlane plane;
+    plane.resize(13, 11);
+    BOOST_CHECK(plane.empty());
+    BOOST_CHECK(plane.count() == 0);
+
+    plane.set(0, 0, true);
+    plane.set(12, 4, true);
+    plane.set(5, 10, true);
+    plane.set(12, 10, true);
+    // Out of the plane
+    plane.set(13, 0, true);
+    plane.set(-1, 3, true);
+    BOOST_CHECK(plane.get(12, 4));
+    BOOST_CHECK(!plane.get(13, 0));
+    BOOST_CHECK(!plane.get(0, 1));
+    BOOST_CHECK(plane.count() == 4);
+
+    // Set bits are returned row by row
+    std::vector<std::pair<int, int>> tiles;
+    plane.forEachSet([&](int x, int y)
+    {
+        tiles.push_back(std::make_pair(x, y));
+    });
+    BOOST_CHECK(tiles.size() == 4);
+    BOOST_CHECK(tiles[0] == std::make_pair(0, 0));
+    BOOST_CHECK(tiles[1] == std::make_pair(12, 4));
+    BOOST_CHECK(tiles[2] == std::make_pair(5, 10));
+    BOOST_CHECK(tiles[3] == std::make_pair(12, 10));
+
+    uint32_t nbUnset = 0;
+    plane.forEachUnset([&](int x, int y)
+    {
+        BOOST_CHECK(x < 13 && y < 11);
+        ++nbUnset;
+    });
+    BOOST_CHECK(nbUnset == 13 * 11 - 4);
+
+    TileBitPlane other;
+    other.resize(13, 11);
+    other.set(12, 4, true);
+    other.set(6, 10, true);
+    other.set(12, 10, true);
+    BOOST_CHECK(plane.countIntersection(other) == 2);
+
+    tiles.clear();
+    plane.forEachSetIntersection(other, [&](int x, int y)
+    {
+        tiles.push_back(std::make_pair(x, y));
+    });
+    BOOST_CHECK(tiles.size() == 2);
+    BOOST_CHECK(tiles[1] == std::make_pair(12, 10));
+
+    plane.set(12, 4, false);
+    BOOST_CHECK(!plane.get(12, 4));
+    BOOST_CHECK(plane.count() == 3);
+
+    plane.clear();
+    BOOST_CHECK(plane.empty());
+
+    // Bits after the last tile stay unset
+    plane.setAll();
+    BOOST_CHECK(plane.count() == 13 * 11);
+    BOOST_CHECK(plane.get(12, 10));
+
+    BOOST_CHECK(TileBitPlane::popCount(0xF0F0) == 8);
+    BOOST_CHECK(TileBitPlane::lowestBitIndex(static_cast<uint64_t>(1) << 40) == 40);
+}
+
+BOOST_AUTO_TEST_CASE(test_TileAreaTable)
+{
+    TileBitPlane plane;
+    plane.resize(10, 8);
+    for(int yy = 2; yy < 5; ++yy)
+    {
+        for(int xx = 3; xx < 7; ++xx)
+            plane.set(xx, yy, true);
+    }
+    plane.set(9, 7, true);
+
+    TileAreaTable table;
+    BOOST_CHECK(table.update(plane));
+    // Nothing changed, the table should not be rebuilt
+    BOOST_CHECK(!table.update(plane));
+
+    BOOST_CHECK(table.count(0, 0, 10, 8) == 13);
+    BOOST_CHECK(table.count(3, 2, 4, 3) == 12);
+    BOOST_CHECK(table.count(4, 3, 2, 2) == 4);
+    BOOST_CHECK(table.count(0, 0, 3, 8) == 0);
+    // Parts outside the map are ignored
+    BOOST_CHECK(table.count(8, 6, 5, 5) == 1);
+    BOOST_CHECK(table.count(-5, -5, 9, 8) == 1);
+
+    plane.set(0, 0, true);
+    BOOST_CHECK(table.update(plane));
+    BOOST_CHECK(table.count(0, 0, 1, 1) == 1);
+
+    // Another plane with the same content is not mistaken for the first one
+    TileBitPlane other = plane;
+    other.set(1, 1, true);
+    BOOST_CHECK(table.update(other));
+    BOOST_CHECK(table.count(0, 0, 2, 2) == 2);
+}
+
+static std::vector<std::pair<int, int>> walkLine(int x1, int y1, int x2, int y2)
+{
+    std::vector<std::pair<int, int>> tiles;
+    TileLineWalker walker(x1, y1, x2, y2);
+    int x;
+    int y;
+    while(walker.next(x, y))
+        tiles.push_back(std::make_pair(x, y));
+
+    return tiles;
+}
+
+BOOST_AUTO_TEST_CASE(test_TileLineWalker)
+{
+    std::vector<std::pair<int, int>> tiles = walkLine(0, 0, 5, 2);
+    std::vector<std::pair<int, int>> expected = { {0, 0}, {1, 0}, {2, 1}, {3, 1}, {4, 2}, {5, 2} };
+    BOOST_CHECK(tiles == expected);
+
+    // Same tiles when x and y are swapped
+    tiles = walkLine(0, 0, 2, 5);
+    expected = { {0, 0}, {0, 1}, {1, 2}, {1, 3}, {2, 4}, {2, 5} };
+    BOOST_CHECK(tiles == expected);
+
+    tiles = walkLine(3, 4, 3, 1);
+    expected = { {3, 4}, {3, 3}, {3, 2}, {3, 1} };
+    BOOST_CHECK(tiles == expected);
+
+    tiles = walkLine(2, 2, -1, 1);
+    expected = { {2, 2}, {1, 2}, {0, 1}, {-1, 1} };
+    BOOST_CHECK(tiles == expected);
+
+    // A line always starts and ends on the given tiles
+    for(int x = -6; x <= 6; ++x)
+    {
+        for(int y = -6; y <= 6; ++y)
+        {
+            tiles = walkLine(1, -2, x, y);
+            BOOST_CHECK(tiles.size() == static_cast<uint32_t>(std::max(std::abs(x - 1), std::abs(y + 2)) + 1));
+            BOOST_CHECK(tiles.front() == std::make_pair(1, -2));
+            BOOST_CHECK(tiles.back() == std::make_pair(x, y));
+        }
+    }
+
+    TileLineWalker walker;
+    int x;
+    int y;
+    BOOST_CHECK(!walker.next(x, y));
+}
+
+BOOST_AUTO_TEST_CASE(test_TileWindowPlane)
+{
+    TileWindowPlane window;
+    window.reset(10, 20, 3);
+    window.set(7, 17);
+    window.set(13, 23);
+    window.set(10, 20);
+    // Outside the window
+    window.set(14, 20);
+    window.set(6, 20);
+    BOOST_CHECK(window.get(7, 17));
+    BOOST_CHECK(window.get(13, 23));
+    BOOST_CHECK(window.get(10, 20));
+    BOOST_CHECK(!window.get(14, 20));
+    BOOST_CHECK(!window.get(6, 20));
+    BOOST_CHECK(!window.get(11, 20));
+    BOOST_CHECK(!window.get(-1, -1));
+
+    // Moving the window clears it. Negative positions are allowed
+    window.reset(0, 0, 3);
+    BOOST_CHECK(!window.get(0, 0));
+    window.set(-3, 2);
+    BOOST_CHECK(window.get(-3, 2));
+    BOOST_CHECK(!window.get(7, 17));
+
+    window.reset(0, 0, 5);
+    BOOST_CHECK(!window.get(-3, 2));
+    window.set(5, 5);
+    BOOST_CHECK(window.get(5, 5));
+}
@@ -0,0 +1,277 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE TileChunkGrid
+#include "BoostTestTargetConfig.h"
+
+#include "render/TileChunkGrid.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef OD_TEST_LEVELS_DIR
+#define OD_TEST_LEVELS_DIR "levels"
+#endif
+
+namespace
+{
+//! \brief Minimal level reader: only the tiles section is read. Tiles not listed in the
+//! level are full dirt tiles
+struct TestLevel
+{
+    std::string mName;
+    int mSizeX = 0;
+    int mSizeY = 0;
+    std::vector<bool> mFull;
+    std::vector<bool> mClaimed;
+};
+
+bool readLevel(const boost::filesystem::path& path, TestLevel& level)
+{
+    std::ifstream file(path.string());
+    if(!file.is_open())
+        return false;
+
+    level.mName = path.filename().string();
+    std::string line;
+    while(std::getline(file, line))
+    {
+        if(line.compare(0, 7, "[Tiles]") == 0)
+            break;
+    }
+
+    // Map size. Comment lines start with #
+    std::vector<int> sizes;
+    while((sizes.size() < 2) && std::getline(file, line))
+    {
+        if(line.empty() || line[0] == '#')
+            continue;
+
+        std::stringstream ss(line);
+        int size;
+        ss >> size;
+        sizes.push_back(size);
+    }
+    if(sizes.size() < 2 || sizes[0] <= 0 || sizes[1] <= 0)
+        return false;
+
+    level.mSizeX = sizes[0];
+    level.mSizeY = sizes[1];
+    uint32_t nbTiles = static_cast<uint32_t>(level.mSizeX * level.mSizeY);
+    level.mFull.assign(nbTiles, true);
+    level.mClaimed.assign(nbTiles, false);
+    while(std::getline(file, line))
+    {
+        if(line.compare(0, 8, "[/Tiles]") == 0)
+            return true;
+        if(line.empty() || line[0] == '#')
+            continue;
+
+        std::stringstream ss(line);
+        int x;
+        int y;
+        int type;
+        double fullness;
+        int seatId = 0;
+        ss >> x >> y >> type >> fullness;
+        if(ss.fail() || x < 0 || y < 0 || x >= level.mSizeX || y >= level.mSizeY)
+            continue;
+
+        ss >> seatId;
+        uint32_t index = static_cast<uint32_t>(y * level.mSizeX + x);
+        level.mFull[index] = (fullness > 0.0);
+        level.mClaimed[index] = !level.mFull[index] && (seatId > 0);
+    }
+    return false;
+}
+
+std::vector<TestLevel> readLevels()
+{
+    std::vector<TestLevel> levels;
+    for(const char* dir : {"/skirmish", "/multiplayer"})
+    {
+        boost::filesystem::path path(std::string(OD_TEST_LEVELS_DIR) + dir);
+        if(!boost::filesystem::is_directory(path))
+            continue;
+
+        for(boost::filesystem::directory_iterator it(path); it != boost::filesystem::directory_iterator(); ++it)
+        {
+            if(it->path().extension() != ".level")
+                continue;
+
+            TestLevel level;
+            if(readLevel(it->path(), level))
+                levels.push_back(level);
+        }
+    }
+    return levels;
+}
+} // namespace <none>
+
+BOOST_AUTO_TEST_CASE(test_TileChunkGrid)
+{
+    TileChunkGrid grid;
+    grid.resize(40, 20, 16);
+    BOOST_CHECK(grid.getNbChunksX() == 3);
+    BOOST_CHECK(grid.getNbChunksY() == 2);
+    BOOST_CHECK(grid.getNbChunks() == 6);
+    BOOST_CHECK(grid.getChunkIndex(0, 0) == 0);
+    BOOST_CHECK(grid.getChunkIndex(39, 19) == 5);
+    BOOST_CHECK(grid.getChunkIndex(40, 0) == -1);
+    BOOST_CHECK(grid.getChunkIndex(0, -1) == -1);
+
+    int x1;
+    int y1;
+    int x2;
+    int y2;
+    grid.getChunkTiles(5, x1, y1, x2, y2);
+    BOOST_CHECK(x1 == 32 && y1 == 16 && x2 == 40 && y2 == 20);
+
+    // Resizing marks everything dirty
+    BOOST_CHECK(grid.hasDirtyChunks());
+    uint32_t nbRebuilt = 0;
+    grid.rebuildDirtyChunks([&](uint32_t) { ++nbRebuilt; });
+    BOOST_CHECK(nbRebuilt == 6);
+    BOOST_CHECK(!grid.hasDirtyChunks());
+
+    // Several tiles in the same chunk only rebuild it once
+    grid.resetStats();
+    grid.markTileDirty(1, 1);
+    grid.markTileDirty(15, 15);
+    grid.markTileDirty(16, 15);
+    grid.markTileDirty(100, 100);
+    std::vector<uint32_t> rebuilt;
+    grid.rebuildDirtyChunks([&](uint32_t chunkIndex) { rebuilt.push_back(chunkIndex); });
+    BOOST_CHECK(rebuilt.size() == 2);
+    BOOST_CHECK(grid.getNbTilesMarked() == 3);
+    BOOST_CHECK(grid.getNbRebuilds() == 2);
+
+    // Tiles marked while rebuilding are processed on the next call
+    grid.markTileDirty(0, 0);
+    nbRebuilt = 0;
+    grid.rebuildDirtyChunks([&](uint32_t)
+    {
+        ++nbRebuilt;
+        grid.markTileDirty(0, 0);
+    });
+    BOOST_CHECK(nbRebuilt == 1);
+    BOOST_CHECK(grid.hasDirtyChunks());
+}
+
+BOOST_AUTO_TEST_CASE(test_TileChunkGridLevels)
+{
+    std::vector<TestLevel> levels = readLevels();
+    if(levels.empty())
+    {
+        BOOST_TEST_MESSAGE("No level found in " OD_TEST_LEVELS_DIR);
+        return;
+    }
+
+    for(const TestLevel& level : levels)
+    {
+        TileChunkGrid grid;
+        grid.resize(level.mSizeX, level.mSizeY, TileChunkGrid::DEFAULT_CHUNK_SIZE);
+
+        // Initial build: every tile is created and refreshed once
+        uint32_t nbTiles = static_cast<uint32_t>(level.mSizeX * level.mSizeY);
+        for(int yy = 0; yy < level.mSizeY; ++yy)
+        {
+            for(int xx = 0; xx < level.mSizeX; ++xx)
+                grid.markTileDirty(xx, yy);
+        }
+        grid.rebuildDirtyChunks([](uint32_t) {});
+        BOOST_CHECK(grid.getNbRebuilds() == grid.getNbChunks());
+        BOOST_CHECK(grid.getNbChunks() * TileChunkGrid::DEFAULT_CHUNK_SIZE * TileChunkGrid::DEFAULT_CHUNK_SIZE >= nbTiles);
+        BOOST_TEST_MESSAGE(level.mName + ": " + std::to_string(level.mSizeX) + "x" + std::to_string(level.mSizeY)
+            + ", tile nodes=" + std::to_string(nbTiles) + ", chunks=" + std::to_string(grid.getNbChunks()));
+
+        // Claim wave: starting from the claimed tiles, every frame, the ground tiles next to the
+        // claimed ones get claimed. Like in the game, claiming a tile refreshes its neighbors too
+        grid.resetStats();
+        std::vector<bool> claimed = level.mClaimed;
+        std::vector<uint32_t> front;
+        for(uint32_t i = 0; i < nbTiles; ++i)
+        {
+            if(claimed[i])
+                front.push_back(i);
+        }
+
+        uint32_t nbFrames = 0;
+        uint32_t nbTileRefreshes = 0;
+        uint32_t maxRebuildsPerFrame = 0;
+        while(!front.empty())
+        {
+            std::vector<uint32_t> newFront;
+            for(uint32_t index : front)
+            {
+                int x = static_cast<int>(index) % level.mSizeX;
+                int y = static_cast<int>(index) / level.mSizeX;
+                for(int dy = -1; dy <= 1; ++dy)
+                {
+                    for(int dx = -1; dx <= 1; ++dx)
+                    {
+                        int nx = x + dx;
+                        int ny = y + dy;
+                        if(nx < 0 || ny < 0 || nx >= level.mSizeX || ny >= level.mSizeY)
+                            continue;
+
+                        uint32_t neighIndex = static_cast<uint32_t>(ny * level.mSizeX + nx);
+                        if(level.mFull[neighIndex] || claimed[neighIndex])
+                            continue;
+
+                        claimed[neighIndex] = true;
+                        newFront.push_back(neighIndex);
+                        for(int ry = ny - 1; ry <= ny + 1; ++ry)
+                        {
+                            for(int rx = nx - 1; rx <= nx + 1; ++rx)
+                            {
+                                if(grid.getChunkIndex(rx, ry) < 0)
+                                    continue;
+
+                                grid.markTileDirty(rx, ry);
+                                ++nbTileRefreshes;
+                            }
+                        }
+                    }
+                }
+            }
+
+            if(newFront.empty())
+                break;
+
+            uint64_t nbRebuildsBefore = grid.getNbRebuilds();
+            grid.rebuildDirtyChunks([](uint32_t) {});
+            uint32_t nbRebuilds = static_cast<uint32_t>(grid.getNbRebuilds() - nbRebuildsBefore);
+            BOOST_CHECK(nbRebuilds <= grid.getNbChunks());
+            maxRebuildsPerFrame = std::max(maxRebuildsPerFrame, nbRebuilds);
+            ++nbFrames;
+            front.swap(newFront);
+        }
+
+        BOOST_CHECK(grid.getNbTilesMarked() == nbTileRefreshes);
+        BOOST_CHECK(grid.getNbRebuilds() <= nbTileRefreshes);
+        BOOST_TEST_MESSAGE(level.mName + ": claim wave frames=" + std::to_string(nbFrames)
+            + ", tile refreshes=" + std::to_string(nbTileRefreshes)
+            + ", chunk rebuilds=" + std::to_string(grid.getNbRebuilds())
+            + ", max chunk rebuilds per frame=" + std::to_string(maxRebuildsPerFrame));
+    }
+}
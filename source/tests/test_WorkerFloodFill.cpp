@@ -0,0 +1,164 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE WorkerFloodFill
+#include "BoostTestTargetConfig.h"
+
+#include "gamemap/WorkerFloodFill.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+const uint32_t NB_TILES = 400;
+const uint32_t NB_TYPES = 4;
+
+inline uint32_t teamIndex(uint32_t team, uint32_t type, uint32_t tile)
+{
+    return (team * NB_TYPES + type) * NB_TILES + tile;
+}
+
+//! \brief Reference layer built like GameMap used to: the values are refined team after team
+//! on the whole map
+std::vector<uint32_t> buildReference(const std::vector<uint32_t>& teamValues, uint32_t nbTeams)
+{
+    std::vector<uint32_t> reference(NB_TILES * NB_TYPES, 0);
+    std::unordered_map<uint64_t, uint32_t> values;
+    for(uint32_t type = 0; type < NB_TYPES; ++type)
+    {
+        for(uint32_t team = 0; team < nbTeams; ++team)
+        {
+            values.clear();
+            for(uint32_t tile = 0; tile < NB_TILES; ++tile)
+            {
+                uint32_t& value = reference[tile * NB_TYPES + type];
+                uint64_t key = (static_cast<uint64_t>(value) << 32) | teamValues[teamIndex(team, type, tile)];
+                uint32_t newValue = static_cast<uint32_t>(values.size());
+                value = values.emplace(key, newValue).first->second;
+            }
+        }
+    }
+    return reference;
+}
+
+//! \brief Checks that 2 tiles share a value in the layer if and only if they share it in the reference
+bool isSameLayer(const WorkerFloodFill& layer, const std::vector<uint32_t>& reference)
+{
+    for(uint32_t type = 0; type < NB_TYPES; ++type)
+    {
+        for(uint32_t tile1 = 0; tile1 < NB_TILES; ++tile1)
+        {
+            for(uint32_t tile2 = tile1 + 1; tile2 < NB_TILES; ++tile2)
+            {
+                bool isSame = (layer.getValue(tile1, type) == layer.getValue(tile2, type));
+                bool isSameReference = (reference[tile1 * NB_TYPES + type] == reference[tile2 * NB_TYPES + type]);
+                if(isSame != isSameReference)
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace <none>
+
+BOOST_AUTO_TEST_CASE(test_WorkerFloodFill)
+{
+    std::srand(42);
+    const uint32_t nbTeams = 3;
+    std::vector<uint32_t> teamValues(nbTeams * NB_TYPES * NB_TILES);
+    for(uint32_t& value : teamValues)
+        value = static_cast<uint32_t>(std::rand() % 6);
+
+    WorkerFloodFill layer;
+    layer.resize(NB_TILES, NB_TYPES, nbTeams);
+    BOOST_CHECK(layer.isDirty());
+    layer.refresh(teamValues);
+    BOOST_CHECK(!layer.isDirty());
+    BOOST_CHECK(isSameLayer(layer, buildReference(teamValues, nbTeams)));
+
+    // Only the tiles set dirty are computed again
+    for(uint32_t step = 0; step < 50; ++step)
+    {
+        uint32_t nbChanges = 1 + static_cast<uint32_t>(std::rand() % 20);
+        for(uint32_t i = 0; i < nbChanges; ++i)
+        {
+            uint32_t tile = static_cast<uint32_t>(std::rand()) % NB_TILES;
+            uint32_t team = static_cast<uint32_t>(std::rand()) % nbTeams;
+            uint32_t type = static_cast<uint32_t>(std::rand()) % NB_TYPES;
+            teamValues[teamIndex(team, type, tile)] = static_cast<uint32_t>(std::rand() % 6);
+            layer.setTileDirty(tile);
+        }
+        layer.refresh(teamValues);
+        BOOST_REQUIRE(isSameLayer(layer, buildReference(teamValues, nbTeams)));
+    }
+
+    // Many new combinations. Unused ones get dropped on the way
+    for(uint32_t step = 0; step < 20; ++step)
+    {
+        for(uint32_t tile = 0; tile < NB_TILES; ++tile)
+        {
+            teamValues[teamIndex(step % nbTeams, step % NB_TYPES, tile)] = 1000 * step + tile;
+            layer.setTileDirty(tile);
+        }
+        layer.refresh(teamValues);
+        BOOST_REQUIRE(isSameLayer(layer, buildReference(teamValues, nbTeams)));
+    }
+
+    // Merging regions, like when a wall is dug out
+    for(uint32_t tile = 0; tile < NB_TILES; ++tile)
+    {
+        if(teamValues[teamIndex(1, 0, tile)] != 3)
+            continue;
+
+        teamValues[teamIndex(1, 0, tile)] = 4;
+        layer.setTileDirty(tile);
+    }
+    layer.refresh(teamValues);
+    BOOST_CHECK(isSameLayer(layer, buildReference(teamValues, nbTeams)));
+
+    // Resetting every value
+    for(uint32_t& value : teamValues)
+        value = 0;
+    layer.setAllDirty();
+    layer.refresh(teamValues);
+    BOOST_CHECK(isSameLayer(layer, buildReference(teamValues, nbTeams)));
+    BOOST_CHECK(layer.getValue(0, 0) == layer.getValue(NB_TILES - 1, 0));
+}
+
+BOOST_AUTO_TEST_CASE(test_WorkerFloodFillOneTeam)
+{
+    // With one team, the layer has the same regions as the team
+    std::vector<uint32_t> teamValues(NB_TYPES * NB_TILES);
+    for(uint32_t i = 0; i < teamValues.size(); ++i)
+        teamValues[i] = (i / 7) % 5;
+
+    WorkerFloodFill layer;
+    layer.resize(NB_TILES, NB_TYPES, 1);
+    layer.refresh(teamValues);
+    BOOST_CHECK(isSameLayer(layer, buildReference(teamValues, 1)));
+
+    // Setting a tile dirty twice is fine
+    teamValues[teamIndex(0, 2, 10)] = 100;
+    layer.setTileDirty(10);
+    layer.setTileDirty(10);
+    layer.refresh(teamValues);
+    BOOST_CHECK(isSameLayer(layer, buildReference(teamValues, 1)));
+    BOOST_CHECK(layer.getValue(10, 2) != layer.getValue(11, 2));
+}
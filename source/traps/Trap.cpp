@@ -147,7 +147,7 @@ void Trap::doUpkeep()
             if(!trapTileData->decreaseShoot())
                 deactivate(tile);
 
-            const std::vector<Seat*>& seats = tile->getSeatsWithVision();
+            std::vector<Seat*> seats = tile->getSeatsWithVision();
             trapTileData->seatsSawTriggering(seats);
 
             for(Seat* seat : trapTileData->mSeatsVision)
@@ -253,6 +253,8 @@ void Trap::activate(Tile* tile)
     trapTileData->setActivated(true);
     trapTileData->setNbShootsBeforeDeactivation(mNbShootsBeforeDeactivation);
     trapTileData->setReloadTime(0);
+    // Some traps (like doors) permit vision depending on their activation
+    getGameMap()->refreshTilePlanes(*tile);
 
     BuildingObject* entity = getBuildingObjectFromTile(tile);
     if (entity == nullptr)
@@ -268,6 +270,8 @@ void Trap::deactivate(Tile* tile)
 
     TrapTileData* trapTileData = static_cast<TrapTileData*>(mTileData[tile]);
     trapTileData->setActivated(false);
+    // Some traps (like doors) permit vision depending on their activation
+    getGameMap()->refreshTilePlanes(*tile);
 
     BuildingObject* entity = getBuildingObjectFromTile(tile);
     if (entity == nullptr)
@@ -123,7 +123,8 @@ TrapBoulder::TrapBoulder(GameMap* gameMap) :
 
 bool TrapBoulder::shoot(Tile* tile)
 {
-    std::vector<Tile*> tiles = tile->getAllNeighbors();
+    TileNeighbors neighbors = tile->getAllNeighbors();
+    std::vector<Tile*> tiles(neighbors.begin(), neighbors.end());
     for(std::vector<Tile*>::iterator it = tiles.begin(); it != tiles.end();)
     {
         Tile* tmpTile = *it;
@@ -356,8 +356,16 @@ void TrapDoor::doUpkeep()
             changeDoorState(doorEntity, tile, mIsLocked);
         }
     }
+    bool lockedStateChanged = (mIsLockedState != mIsLocked);
     mIsLockedState = mIsLocked;
 
+    // Vision through the door depends on the locked state
+    if(lockedStateChanged)
+    {
+        for(Tile* tile : mCoveredTiles)
+            getGameMap()->refreshTilePlanes(*tile);
+    }
+
     Trap::doUpkeep();
 }
 
@@ -367,6 +375,10 @@ void TrapDoor::notifyDoorSlapped(DoorEntity* doorEntity, Tile* tile)
     changeDoorState(doorEntity, tile, mIsLocked);
 
     mIsLockedState = mIsLocked;
+
+    // Vision through the door depends on the locked state
+    for(Tile* coveredTile : mCoveredTiles)
+        getGameMap()->refreshTilePlanes(*coveredTile);
 }
 
 void TrapDoor::changeDoorState(DoorEntity* doorEntity, Tile* tile, bool locked)
@@ -0,0 +1,184 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/BenchmarkReport.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <utility>
+
+namespace
+{
+//! \brief Returns in value the raw text of the given key in a line written by toJson. Strings
+//! are returned without their quotes
+bool readField(const std::string& line, const std::string& key, std::string& value)
+{
+    std::string search = "\"" + key + "\":";
+    std::size_t pos = line.find(search);
+    if(pos == std::string::npos)
+        return false;
+
+    pos += search.size();
+    while((pos < line.size()) && (line[pos] == ' '))
+        ++pos;
+
+    if(pos >= line.size())
+        return false;
+
+    if(line[pos] == '"')
+    {
+        std::size_t end = line.find('"', pos + 1);
+        if(end == std::string::npos)
+            return false;
+
+        value = line.substr(pos + 1, end - pos - 1);
+        return true;
+    }
+
+    std::size_t end = line.find_first_of(",}", pos);
+    if(end == std::string::npos)
+        return false;
+
+    value = line.substr(pos, end - pos);
+    return true;
+}
+
+template<typename T>
+bool readNumber(const std::string& line, const std::string& key, T& value)
+{
+    std::string text;
+    if(!readField(line, key, text))
+        return false;
+
+    std::stringstream ss(text);
+    ss >> value;
+    return !ss.fail();
+}
+
+std::string formatUs(double us)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.3f", us);
+    return buffer;
+}
+} // namespace <none>
+
+namespace BenchmarkReport
+{
+void sortResults(std::vector<BenchmarkResult>& results)
+{
+    std::sort(results.begin(), results.end(), [](const BenchmarkResult& a, const BenchmarkResult& b)
+    {
+        if(a.mLevel != b.mLevel)
+            return a.mLevel < b.mLevel;
+
+        return a.mBenchmark < b.mBenchmark;
+    });
+}
+
+std::string toJson(const std::vector<BenchmarkResult>& results)
+{
+    std::stringstream ss;
+    ss << "{\n  \"results\": [\n";
+    for(uint32_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+        ss << "    {\"level\": \"" << result.mLevel << "\""
+            << ", \"benchmark\": \"" << result.mBenchmark << "\""
+            << ", \"runs\": " << result.mRuns
+            << ", \"totalUs\": " << result.mTotalUs
+            << ", \"averageUs\": " << formatUs(result.getAverageUs())
+            << ", \"checksum\": " << result.mChecksum << "}";
+        if(i + 1 < results.size())
+            ss << ",";
+        ss << "\n";
+    }
+    ss << "  ]\n}\n";
+    return ss.str();
+}
+
+bool fromJson(std::istream& is, std::vector<BenchmarkResult>& results)
+{
+    bool found = false;
+    std::string line;
+    while(std::getline(is, line))
+    {
+        BenchmarkResult result;
+        if(!readField(line, "level", result.mLevel))
+            continue;
+        if(!readField(line, "benchmark", result.mBenchmark))
+            continue;
+        if(!readNumber(line, "runs", result.mRuns))
+            continue;
+        if(!readNumber(line, "totalUs", result.mTotalUs))
+            continue;
+        if(!readNumber(line, "checksum", result.mChecksum))
+            continue;
+
+        results.push_back(result);
+        found = true;
+    }
+    return found;
+}
+
+uint32_t compare(const std::vector<BenchmarkResult>& results, const std::vector<BenchmarkResult>& baseline,
+    double tolerance, std::string& report)
+{
+    std::map<std::pair<std::string, std::string>, const BenchmarkResult*> baselineResults;
+    for(const BenchmarkResult& result : baseline)
+        baselineResults[std::make_pair(result.mLevel, result.mBenchmark)] = &result;
+
+    uint32_t nbRegressions = 0;
+    std::stringstream ss;
+    for(const BenchmarkResult& result : results)
+    {
+        ss << result.mLevel << " " << result.mBenchmark << ": ";
+        auto it = baselineResults.find(std::make_pair(result.mLevel, result.mBenchmark));
+        if(it == baselineResults.end())
+        {
+            ss << formatUs(result.getAverageUs()) << "us (not in baseline)\n";
+            continue;
+        }
+
+        const BenchmarkResult& base = *(it->second);
+        double average = result.getAverageUs();
+        double baseAverage = base.getAverageUs();
+        ss << formatUs(baseAverage) << "us -> " << formatUs(average) << "us";
+        if(baseAverage > 0.0)
+        {
+            double change = (average - baseAverage) * 100.0 / baseAverage;
+            ss << " (" << (change >= 0.0 ? "+" : "") << formatUs(change) << "%)";
+        }
+
+        if(result.mChecksum != base.mChecksum)
+        {
+            ss << " RESULT CHANGED (checksum " << base.mChecksum << " -> " << result.mChecksum << ")";
+            ++nbRegressions;
+        }
+        else if(average > baseAverage * (1.0 + tolerance))
+        {
+            ss << " SLOWER";
+            ++nbRegressions;
+        }
+        ss << "\n";
+    }
+    report = ss.str();
+    return nbRegressions;
+}
+} // namespace BenchmarkReport
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARKREPORT_H
+#define BENCHMARKREPORT_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+//! \brief Result of one benchmark run on one level. The checksum is computed from what the timed
+//! algorithm returned (path lengths, number of tiles, ...). It allows to check that an optimization
+//! did not change the results when comparing with a baseline.
+struct BenchmarkResult
+{
+    BenchmarkResult() :
+        mRuns(0),
+        mTotalUs(0),
+        mChecksum(0)
+    {}
+
+    std::string mLevel;
+    std::string mBenchmark;
+    uint32_t mRuns;
+    int64_t mTotalUs;
+    uint64_t mChecksum;
+
+    inline double getAverageUs() const
+    { return (mRuns == 0) ? 0.0 : static_cast<double>(mTotalUs) / static_cast<double>(mRuns); }
+};
+
+//! \brief Reads, writes and compares benchmark results. Results are written as JSON, one result per
+//! line and sorted by level then benchmark name so that two reports can be diffed.
+namespace BenchmarkReport
+{
+    //! \brief Sorts the results by level then benchmark name
+    void sortResults(std::vector<BenchmarkResult>& results);
+
+    //! \brief Returns the results as a JSON document. The results are expected to be sorted
+    std::string toJson(const std::vector<BenchmarkResult>& results);
+
+    //! \brief Reads results written by toJson. This is not a generic JSON parser: every result is
+    //! expected to be on its own line. Returns false if no result could be read
+    bool fromJson(std::istream& is, std::vector<BenchmarkResult>& results);
+
+    //! \brief Compares results with baseline. A benchmark is considered as a regression if its average
+    //! time is more than tolerance (0.1 = 10%) slower than in the baseline or if its checksum differs.
+    //! Fills report with one line per benchmark and returns the number of regressions
+    uint32_t compare(const std::vector<BenchmarkResult>& results, const std::vector<BenchmarkResult>& baseline,
+        double tolerance, std::string& report);
+}
+
+#endif // BENCHMARKREPORT_H
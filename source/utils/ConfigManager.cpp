@@ -25,9 +25,11 @@
 #include "spawnconditions/SpawnCondition.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/StartupTimings.h"
 
 #include <boost/dynamic_bitset.hpp>
 #include <OgreRoot.h>
+#include <SFML/System/Thread.hpp>
 
 const std::vector<std::string> EMPTY_SPAWNPOOL;
 const std::string EMPTY_STRING;
@@ -41,7 +43,7 @@ const std::string ConfigManager::DefaultWorkerCreatureDefinition = "DefaultWorke
 template<> ConfigManager* Ogre::Singleton<ConfigManager>::msSingleton = nullptr;
 
 ConfigManager::ConfigManager(const std::string& configPath, const std::string& userConfigPath,
-        const std::string& soundPath) :
+        const std::string& soundPath, StartupTimings* startupTimings) :
     mNetworkPort(0),
     mClientConnectionTimeout(5000),
     mBaseSpawnPoint(10),
@@ -65,70 +67,30 @@ ConfigManager::ConfigManager(const std::string& configPath, const std::string& u
     mNbTurnsKoCreatureAttacked(10),
     mCreatureDefinitionDefaultWorker(nullptr),
     mNbWorkersDigSameFaceTile(2),
-    mNbWorkersClaimSameTile(1)
+    mNbWorkersClaimSameTile(1),
+    mStartupTimings(startupTimings)
 {
     // TODO: it might be better to go through the creature definitions and try to pickup the first worker we can find
     mCreatureDefinitionDefaultWorker = new CreatureDefinition(DefaultWorkerCreatureDefinition,
         CreatureDefinition::CreatureJob::Worker, "Kobold.mesh");
+    sf::Time start;
+    if(mStartupTimings != nullptr)
+        start = mStartupTimings->getElapsedTime();
+
     if(!loadGlobalConfig(configPath))
     {
         OD_LOG_ERR("Couldn't read loadCreatureDefinitions");
         exit(1);
     }
-    std::string fileName = configPath + mFilenameCreatureDefinition;
-    if(!loadCreatureDefinitions(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadCreatureDefinitions");
-        exit(1);
-    }
-    fileName = configPath + mFilenameEquipmentDefinition;
-    if(!loadEquipements(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadEquipements");
-        exit(1);
-    }
-    fileName = configPath + mFilenameSpawnConditions;
-    if(!loadSpawnConditions(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadSpawnConditions");
-        exit(1);
-    }
-    fileName = configPath + mFilenameFactions;
-    if(!loadFactions(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadFactions");
-        exit(1);
-    }
-    fileName = configPath + mFilenameRooms;
-    if(!loadRooms(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadRooms");
-        exit(1);
-    }
-    fileName = configPath + mFilenameTraps;
-    if(!loadTraps(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadTraps");
-        exit(1);
-    }
-    fileName = configPath + mFilenameSpells;
-    if(!loadSpellConfig(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadSpellConfig");
-        exit(1);
-    }
-    fileName = configPath + mFilenameSkills;
-    if(!loadSkills(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadSkills");
-        exit(1);
-    }
-    fileName = configPath + mFilenameTilesets;
-    if(!loadTilesets(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadTilesets");
-        exit(1);
-    }
+
+    if(mStartupTimings != nullptr)
+        mStartupTimings->addPhase("global config", "main", start, mStartupTimings->getElapsedTime());
+
+    // The global config gives the definition file names
+    startDefinitionsLoading(configPath);
+
+    if(mStartupTimings != nullptr)
+        start = mStartupTimings->getElapsedTime();
 
     // Reserve space in any case.
     mUserConfig.resize(Config::Ctg::TOTAL);
@@ -137,10 +99,16 @@ ConfigManager::ConfigManager(const std::string& configPath, const std::string& u
         loadUserConfig(userConfigPath);
 
     loadKeeperVoices(soundPath);
+
+    if(mStartupTimings != nullptr)
+        mStartupTimings->addPhase("user config and keeper voices", "main", start, mStartupTimings->getElapsedTime());
 }
 
 ConfigManager::~ConfigManager()
 {
+    // We cannot release the definitions while they are being loaded
+    joinLoadingThreads();
+
     for(auto pair : mCreatureDefs)
     {
         delete pair.second;
@@ -171,6 +139,99 @@ ConfigManager::~ConfigManager()
     mTileSets.clear();
 }
 
+void ConfigManager::waitDefinitionsLoaded()
+{
+    sf::Time start;
+    if(mStartupTimings != nullptr)
+        start = mStartupTimings->getElapsedTime();
+
+    if(!joinLoadingThreads())
+    {
+        OD_LOG_ERR("Couldn't read definition files");
+        exit(1);
+    }
+
+    if(mStartupTimings != nullptr)
+        mStartupTimings->addPhase("wait definitions", "main", start, mStartupTimings->getElapsedTime());
+}
+
+void ConfigManager::startDefinitionsLoading(const std::string& configPath)
+{
+    // Spawn conditions and factions refer to creature definitions so they are loaded by the
+    // same task, after them. Equipment definitions may refer to other equipment definitions
+    mLoadingTasks.clear();
+    mLoadingTasks.push_back({
+        { mFilenameCreatureDefinition, &ConfigManager::loadCreatureDefinitions },
+        { mFilenameSpawnConditions, &ConfigManager::loadSpawnConditions },
+        { mFilenameFactions, &ConfigManager::loadFactions }
+    });
+    mLoadingTasks.push_back({
+        { mFilenameEquipmentDefinition, &ConfigManager::loadEquipements }
+    });
+    mLoadingTasks.push_back({
+        { mFilenameRooms, &ConfigManager::loadRooms },
+        { mFilenameTraps, &ConfigManager::loadTraps },
+        { mFilenameSpells, &ConfigManager::loadSpellConfig },
+        { mFilenameSkills, &ConfigManager::loadSkills }
+    });
+    mLoadingTasks.push_back({
+        { mFilenameTilesets, &ConfigManager::loadTilesets }
+    });
+
+    mLoadingTasksOk.assign(mLoadingTasks.size(), 0);
+    for(uint32_t i = 0; i < mLoadingTasks.size(); ++i)
+    {
+        sf::Thread* thread = new sf::Thread([this, configPath, i]()
+        {
+            runLoadingTask(configPath, i);
+        });
+        mLoadingThreads.push_back(thread);
+    }
+
+    for(sf::Thread* thread : mLoadingThreads)
+        thread->launch();
+}
+
+void ConfigManager::runLoadingTask(const std::string& configPath, uint32_t taskIndex)
+{
+    std::string threadName = "loader " + Helper::toString(taskIndex);
+    for(const std::pair<std::string, DefinitionLoader>& file : mLoadingTasks[taskIndex])
+    {
+        sf::Time start;
+        if(mStartupTimings != nullptr)
+            start = mStartupTimings->getElapsedTime();
+
+        if(!(this->*file.second)(configPath + file.first))
+        {
+            OD_LOG_ERR("Couldn't read " + configPath + file.first);
+            return;
+        }
+
+        if(mStartupTimings != nullptr)
+            mStartupTimings->addPhase(file.first, threadName, start, mStartupTimings->getElapsedTime());
+    }
+
+    mLoadingTasksOk[taskIndex] = 1;
+}
+
+bool ConfigManager::joinLoadingThreads()
+{
+    for(sf::Thread* thread : mLoadingThreads)
+    {
+        thread->wait();
+        delete thread;
+    }
+    mLoadingThreads.clear();
+
+    for(uint8_t ok : mLoadingTasksOk)
+    {
+        if(ok == 0)
+            return false;
+    }
+
+    return true;
+}
+
 bool ConfigManager::loadGlobalConfig(const std::string& configPath)
 {
     std::stringstream configFile;
@@ -22,15 +22,22 @@
 #include <OgreColourValue.h>
 
 #include <cstdint>
+#include <utility>
+
+namespace sf
+{
+class Thread;
+}
 
 class CreatureDefinition;
+class StartupTimings;
 class Weapon;
 class SpawnCondition;
 class Skill;
 class TileSet;
 class TileSetValue;
 
-enum class TileVisual;
+enum class TileVisual : uint8_t;
 
 namespace Config
 {
@@ -73,10 +80,18 @@ public:
     //! \param userConfigPath The user profile config path or empty if not used.
     //! \note In server mode, the configuration doesn't load the user config and thus,
     //! doesn't set the userConfigPath.
+    //! \note The definition files (creatures, equipment, rooms, tilesets, ...) are parsed
+    //! concurrently in background threads so that the caller can go on with its own
+    //! initialization. waitDefinitionsLoaded() has to be called before using them.
+    //! If startupTimings is given, the duration of each loading phase is recorded in it.
     ConfigManager(const std::string& configPath, const std::string& userConfigPath,
-        const std::string& soundPath);
+        const std::string& soundPath, StartupTimings* startupTimings = nullptr);
     ~ConfigManager();
 
+    //! \brief Waits until every definition file is loaded. If one of them could not be loaded,
+    //! the game exits like when a configuration file is missing
+    void waitDefinitionsLoaded();
+
     static const std::string DefaultWorkerCreatureDefinition;
     static const std::string DEFAULT_TILESET_NAME;
     static const std::string DEFAULT_KEEPER_VOICE;
@@ -261,6 +276,21 @@ private:
     bool loadTilesets(const std::string& fileName);
     bool loadTilesetValues(std::istream& defFile, TileVisual tileVisual, std::vector<TileSetValue>& tileValues);
 
+    //! \brief Definition file loader
+    typedef bool (ConfigManager::*DefinitionLoader)(const std::string& fileName);
+
+    //! \brief List of (file name, loader) loaded in order by the same thread
+    typedef std::vector<std::pair<std::string, DefinitionLoader>> LoadingTask;
+
+    //! \brief Starts a thread for each loading task
+    void startDefinitionsLoading(const std::string& configPath);
+
+    //! \brief Loads the files of the given task. Called from the loading threads
+    void runLoadingTask(const std::string& configPath, uint32_t taskIndex);
+
+    //! \brief Waits for the loading threads. Returns true if every file could be loaded
+    bool joinLoadingThreads();
+
     //! \brief Loads the user configuration values, and use default ones if it cannot do it.
     void loadUserConfig(const std::string& fileName);
 
@@ -337,6 +367,16 @@ private:
 
     //! \brief List of the found keeper voices (in the relative sound folder)
     std::vector<std::string> mKeeperVoices;
+
+    StartupTimings* mStartupTimings;
+
+    //! \brief Files loaded by different tasks must not depend on each other. Each task fills
+    //! its own definition tables so that no lock is needed while loading
+    std::vector<LoadingTask> mLoadingTasks;
+    std::vector<sf::Thread*> mLoadingThreads;
+    //! \brief Result of each loading task. Not a std::vector<bool> as each task writes its own
+    //! result from its thread
+    std::vector<uint8_t> mLoadingTasksOk;
 };
 
 #endif //CONFIGMANAGER_H
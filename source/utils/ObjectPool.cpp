@@ -0,0 +1,285 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/ObjectPool.h"
+
+#include <SFML/System/Lock.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <new>
+#include <sstream>
+
+const uint32_t ObjectPool::NO_SLOT = std::numeric_limits<uint32_t>::max();
+
+namespace
+{
+//! \brief Every object is aligned like the memory returned by operator new
+const std::size_t SLOT_ALIGNMENT = alignof(std::max_align_t);
+
+std::size_t alignSize(std::size_t size)
+{
+    return ((size + SLOT_ALIGNMENT - 1) / SLOT_ALIGNMENT) * SLOT_ALIGNMENT;
+}
+
+//! \brief The registry is built on first use so that pools defined as static objects in any
+//! translation unit can register themselves
+std::vector<ObjectPool*>& getRegistry()
+{
+    static std::vector<ObjectPool*> registry;
+    return registry;
+}
+
+sf::Mutex& getRegistryMutex()
+{
+    static sf::Mutex mutex;
+    return mutex;
+}
+} // namespace <none>
+
+ObjectPool::ObjectPool(const std::string& name, std::size_t objectSize, uint32_t nbObjectsPerSlab) :
+    mName(name),
+    mObjectSize(objectSize),
+    mNbObjectsPerSlab(std::max(nbObjectsPerSlab, static_cast<uint32_t>(1))),
+    mHeaderSize(alignSize(sizeof(SlotHeader))),
+    mSlotSize(mHeaderSize + alignSize(objectSize)),
+    mFirstFree(NO_SLOT),
+    mNbUsed(0),
+    mPeakUsed(0),
+    mNbAllocations(0),
+    mNbHeapAllocations(0)
+{
+    sf::Lock lock(getRegistryMutex());
+    getRegistry().push_back(this);
+}
+
+ObjectPool::~ObjectPool()
+{
+    {
+        sf::Lock lock(getRegistryMutex());
+        std::vector<ObjectPool*>& registry = getRegistry();
+        registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+    }
+
+    // If some objects are still alive (pools are static objects and can be destroyed before
+    // the objects they hold), the memory is not released
+    if(mNbUsed > 0)
+        return;
+
+    for(char* slab : mSlabs)
+        ::operator delete(slab);
+}
+
+void* ObjectPool::allocate(std::size_t size)
+{
+    sf::Lock lock(mMutex);
+    ++mNbAllocations;
+    if(size > mObjectSize)
+    {
+        ++mNbHeapAllocations;
+        return ::operator new(size);
+    }
+
+    if(mFirstFree == NO_SLOT)
+        addSlab();
+
+    uint32_t index = mFirstFree;
+    SlotHeader& slot = getSlot(index);
+    mFirstFree = slot.mNextFree;
+    slot.mNextFree = NO_SLOT;
+    slot.mUsed = true;
+    ++mNbUsed;
+    mPeakUsed = std::max(mPeakUsed, mNbUsed);
+    return reinterpret_cast<char*>(&slot) + mHeaderSize;
+}
+
+void ObjectPool::release(void* ptr, std::size_t size)
+{
+    if(ptr == nullptr)
+        return;
+
+    if(size > mObjectSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    sf::Lock lock(mMutex);
+    uint32_t index = findSlot(ptr);
+    if(index == NO_SLOT || !getSlot(index).mUsed)
+    {
+        // Releasing twice the same object or an object not allocated here would corrupt the
+        // free list. We prefer leaking it
+        return;
+    }
+
+    SlotHeader& slot = getSlot(index);
+    slot.mUsed = false;
+    ++slot.mGeneration;
+    slot.mNextFree = mFirstFree;
+    mFirstFree = index;
+    --mNbUsed;
+}
+
+ObjectPoolHandle ObjectPool::getHandle(const void* ptr) const
+{
+    ObjectPoolHandle handle;
+    sf::Lock lock(mMutex);
+    uint32_t index = findSlot(ptr);
+    if(index == NO_SLOT)
+        return handle;
+
+    const SlotHeader& slot = getSlot(index);
+    if(!slot.mUsed)
+        return handle;
+
+    handle.mPool = this;
+    handle.mIndex = index;
+    handle.mGeneration = slot.mGeneration;
+    return handle;
+}
+
+bool ObjectPool::isAlive(const ObjectPoolHandle& handle) const
+{
+    if(handle.mPool != this)
+        return false;
+
+    sf::Lock lock(mMutex);
+    if(handle.mIndex >= mSlabs.size() * mNbObjectsPerSlab)
+        return false;
+
+    const SlotHeader& slot = getSlot(handle.mIndex);
+    return slot.mUsed && (slot.mGeneration == handle.mGeneration);
+}
+
+ObjectPoolHandle ObjectPool::findHandle(const void* ptr)
+{
+    sf::Lock lock(getRegistryMutex());
+    for(const ObjectPool* pool : getRegistry())
+    {
+        ObjectPoolHandle handle = pool->getHandle(ptr);
+        if(!handle.isNull())
+            return handle;
+    }
+    return ObjectPoolHandle();
+}
+
+uint32_t ObjectPool::getNbSlabs() const
+{
+    sf::Lock lock(mMutex);
+    return static_cast<uint32_t>(mSlabs.size());
+}
+
+uint64_t ObjectPool::getReservedBytes() const
+{
+    sf::Lock lock(mMutex);
+    return static_cast<uint64_t>(mSlabs.size()) * mNbObjectsPerSlab * mSlotSize;
+}
+
+uint32_t ObjectPool::getNbUsed() const
+{
+    sf::Lock lock(mMutex);
+    return mNbUsed;
+}
+
+uint32_t ObjectPool::getPeakUsed() const
+{
+    sf::Lock lock(mMutex);
+    return mPeakUsed;
+}
+
+uint64_t ObjectPool::getNbAllocations() const
+{
+    sf::Lock lock(mMutex);
+    return mNbAllocations;
+}
+
+uint64_t ObjectPool::getNbHeapAllocations() const
+{
+    sf::Lock lock(mMutex);
+    return mNbHeapAllocations;
+}
+
+std::vector<const ObjectPool*> ObjectPool::getPools()
+{
+    sf::Lock lock(getRegistryMutex());
+    return std::vector<const ObjectPool*>(getRegistry().begin(), getRegistry().end());
+}
+
+std::string ObjectPool::getStatsReport()
+{
+    std::stringstream ss;
+    for(const ObjectPool* pool : getPools())
+    {
+        uint32_t nbSlabs = pool->getNbSlabs();
+        ss << pool->getName()
+            << ": object size=" << pool->getObjectSize()
+            << ", slabs=" << nbSlabs
+            << ", capacity=" << nbSlabs * pool->getNbObjectsPerSlab()
+            << ", used=" << pool->getNbUsed()
+            << ", peak=" << pool->getPeakUsed()
+            << ", allocations=" << pool->getNbAllocations()
+            << ", heap fallbacks=" << pool->getNbHeapAllocations()
+            << "\n";
+    }
+    return ss.str();
+}
+
+ObjectPool::SlotHeader& ObjectPool::getSlot(uint32_t index) const
+{
+    char* slab = mSlabs[index / mNbObjectsPerSlab];
+    return *reinterpret_cast<SlotHeader*>(slab + (index % mNbObjectsPerSlab) * mSlotSize);
+}
+
+uint32_t ObjectPool::findSlot(const void* ptr) const
+{
+    const char* address = static_cast<const char*>(ptr);
+    std::size_t slabSize = mSlotSize * mNbObjectsPerSlab;
+    for(uint32_t slabIndex = 0; slabIndex < mSlabs.size(); ++slabIndex)
+    {
+        const char* slab = mSlabs[slabIndex];
+        // std::less gives a total order on pointers even if they do not belong to the same array
+        if(std::less<const char*>()(address, slab) || !std::less<const char*>()(address, slab + slabSize))
+            continue;
+
+        std::size_t offset = static_cast<std::size_t>(address - slab);
+        // Addresses within the slot header do not belong to the object
+        if((offset % mSlotSize) < mHeaderSize)
+            return NO_SLOT;
+
+        return slabIndex * mNbObjectsPerSlab + static_cast<uint32_t>(offset / mSlotSize);
+    }
+    return NO_SLOT;
+}
+
+void ObjectPool::addSlab()
+{
+    char* slab = static_cast<char*>(::operator new(mSlotSize * mNbObjectsPerSlab));
+    uint32_t firstIndex = static_cast<uint32_t>(mSlabs.size()) * mNbObjectsPerSlab;
+    mSlabs.push_back(slab);
+    // Slots are chained in address order so that new objects are allocated next to each other
+    for(uint32_t i = mNbObjectsPerSlab; i > 0; --i)
+    {
+        uint32_t index = firstIndex + i - 1;
+        SlotHeader* slot = new (slab + (i - 1) * mSlotSize) SlotHeader();
+        slot->mGeneration = 0;
+        slot->mUsed = false;
+        slot->mNextFree = mFirstFree;
+        mFirstFree = index;
+    }
+}
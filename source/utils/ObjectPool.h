@@ -0,0 +1,156 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <SFML/System/Mutex.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ObjectPool;
+
+//! \brief Reference to an object allocated from an ObjectPool. Unlike a raw pointer, a handle can
+//! be checked after the object has been deleted: each time a slot is released, its generation
+//! changes and the handles taken on the previous object become invalid.
+struct ObjectPoolHandle
+{
+    ObjectPoolHandle() :
+        mPool(nullptr),
+        mIndex(0),
+        mGeneration(0)
+    {}
+
+    const ObjectPool* mPool;
+    uint32_t mIndex;
+    uint32_t mGeneration;
+
+    //! \brief Returns true if the handle does not reference a pooled object (for
+    //! example, if it was taken on an object allocated from the heap)
+    inline bool isNull() const
+    { return mPool == nullptr; }
+};
+
+//! \brief Fixed size allocator used for the game objects that are created and deleted often
+//! (creatures, missiles, notifications, ...). Memory is allocated by slabs of several objects
+//! and released slots are reused by the next allocations, which avoids going through the heap
+//! for every object. Classes use it by defining their own operator new/delete that forward to a
+//! static pool. Slots are sized for the pool object size and smaller objects can use them too (for
+//! example, to share a pool between the classes of a hierarchy). Since derived classes may be
+//! bigger than the pooled class, bigger requests fall back to the heap.
+//! Every pool registers itself so that allocation stats can be displayed from the console.
+//! Pools are thread safe.
+class ObjectPool
+{
+public:
+    static const uint32_t DEFAULT_OBJECTS_PER_SLAB = 256;
+
+    ObjectPool(const std::string& name, std::size_t objectSize, uint32_t nbObjectsPerSlab = DEFAULT_OBJECTS_PER_SLAB);
+    ~ObjectPool();
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    //! \brief Returns memory for an object of the given size. If it is bigger than the pool
+    //! object size, the memory comes from the heap
+    void* allocate(std::size_t size);
+
+    //! \brief Releases memory returned by allocate. size must be the one given to allocate
+    void release(void* ptr, std::size_t size);
+
+    //! \brief Returns a handle on the pooled object containing the given address. If the
+    //! address does not belong to this pool, a null handle is returned
+    ObjectPoolHandle getHandle(const void* ptr) const;
+
+    //! \brief Returns true if the object the handle was taken on has not been released
+    bool isAlive(const ObjectPoolHandle& handle) const;
+
+    //! \brief Looks for the given address in every pool. Returns a null handle if it
+    //! does not belong to any of them
+    static ObjectPoolHandle findHandle(const void* ptr);
+
+    //! \brief Returns true if the handle is not null and the object it was taken on has not been released
+    static bool isHandleAlive(const ObjectPoolHandle& handle)
+    { return (handle.mPool != nullptr) && handle.mPool->isAlive(handle); }
+
+    inline const std::string& getName() const
+    { return mName; }
+
+    inline std::size_t getObjectSize() const
+    { return mObjectSize; }
+
+    inline uint32_t getNbObjectsPerSlab() const
+    { return mNbObjectsPerSlab; }
+
+    uint32_t getNbSlabs() const;
+    //! \brief Number of bytes allocated for the slabs
+    uint64_t getReservedBytes() const;
+    uint32_t getNbUsed() const;
+    uint32_t getPeakUsed() const;
+    uint64_t getNbAllocations() const;
+
+    //! \brief Number of allocations that did not fit in the pool and went to the heap
+    uint64_t getNbHeapAllocations() const;
+
+    //! \brief Returns every existing pool, in creation order
+    static std::vector<const ObjectPool*> getPools();
+
+    //! \brief Returns a printable summary of the stats of every pool
+    static std::string getStatsReport();
+
+private:
+    //! \brief Stored in front of each object
+    struct SlotHeader
+    {
+        uint32_t mGeneration;
+        uint32_t mNextFree;
+        bool mUsed;
+    };
+
+    static const uint32_t NO_SLOT;
+
+    std::string mName;
+    std::size_t mObjectSize;
+    uint32_t mNbObjectsPerSlab;
+    //! \brief Size of a slot (header + object), rounded so that every object is correctly aligned
+    std::size_t mHeaderSize;
+    std::size_t mSlotSize;
+
+    std::vector<char*> mSlabs;
+    uint32_t mFirstFree;
+
+    uint32_t mNbUsed;
+    uint32_t mPeakUsed;
+    uint64_t mNbAllocations;
+    uint64_t mNbHeapAllocations;
+
+    mutable sf::Mutex mMutex;
+
+    //! \brief Returns the header of the given slot
+    SlotHeader& getSlot(uint32_t index) const;
+
+    //! \brief Returns the index of the slot containing the given address, or NO_SLOT
+    uint32_t findSlot(const void* ptr) const;
+
+    //! \brief Allocates a new slab and puts its slots in the free list
+    void addSlab();
+};
+
+#endif // OBJECTPOOL_H
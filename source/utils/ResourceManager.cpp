@@ -84,7 +84,9 @@ const std::string ResourceManager::RESOURCEGROUPSOUND = "Sound";
  */
 ResourceManager::ResourceManager(boost::program_options::variables_map& options) :
         mServerMode(false),
+        mBenchmarkMode(false),
         mForcedNetworkPort(-1),
+        mSpectatorPort(-1),
         mLogLevel(LogMessageLevel::NORMAL),
         mGameDataPath("./"),
         mUserDataPath("./"),
@@ -425,10 +427,43 @@ void ResourceManager::setupUserDataFolders(boost::program_options::variables_map
         }
     }
 
+    itOption = options.find("benchmark");
+    if(itOption != options.end())
+    {
+        mBenchmarkMode = true;
+        mBenchmarkOutput = itOption->second.as<std::string>();
+
+        auto it2 = options.find("benchmarkbaseline");
+        if(it2 != options.end())
+        {
+            mBenchmarkBaseline = it2->second.as<std::string>();
+            if(!boost::filesystem::exists(mBenchmarkBaseline))
+            {
+                std::cerr << "Wanted benchmark baseline not found: " << mBenchmarkBaseline <<  std::endl;
+                exit(1);
+            }
+        }
+    }
+
     itOption = options.find("port");
     if(itOption != options.end())
         mForcedNetworkPort = itOption->second.as<int32_t>();
 
+    itOption = options.find("spectatorport");
+    if(itOption != options.end())
+        mSpectatorPort = itOption->second.as<int32_t>();
+
+    itOption = options.find("spectate");
+    if(itOption != options.end())
+    {
+        mSpectateHost = itOption->second.as<std::string>();
+        if(mSpectatorPort == -1)
+        {
+            std::cerr << "spectatorport option is needed to spectate a game" << std::endl;
+            exit(1);
+        }
+    }
+
     itOption = options.find("loglevel");
     if(itOption != options.end())
         mLogLevel = static_cast<LogMessageLevel>(itOption->second.as<int32_t>());
@@ -576,7 +611,11 @@ void ResourceManager::buildCommandOptions(boost::program_options::options_descri
         ("serversave", boost::program_options::value<std::string>(), "Launches the game on server mode and opens the given saved game")
         ("appData", boost::program_options::value<std::string>(), "Sets appData to the given path (where logs, replays, ... are saved)")
         ("mscreator", boost::program_options::value<std::string>(), "Sets the creator for this map to connect to the master server. server/servercustom/serversave option needs to be on")
+        ("benchmark", boost::program_options::value<std::string>(), "Runs the map algorithms benchmarks on the official levels without rendering and writes the results to the given JSON file")
+        ("benchmarkbaseline", boost::program_options::value<std::string>(), "Compares the benchmark results with the given JSON file written by a previous run. benchmark option needs to be on")
         ("port", boost::program_options::value<int32_t>(), "Sets the port used. Note that the port is used for both single and multi player")
+        ("spectatorport", boost::program_options::value<int32_t>(), "Sets the port the server relays the game to spectators on. Spectators are disabled if not set")
+        ("spectate", boost::program_options::value<std::string>(), "Watches the game relayed by the given server. spectatorport option needs to be on")
         ("loglevel", boost::program_options::value<int32_t>(), "Sets the log level (between 0=Trivial and 3=Critical)")
     ;
 }
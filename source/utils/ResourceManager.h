@@ -145,9 +145,24 @@ public:
     inline const std::string& getServerModeCreator() const
     { return mServerModeCreator; }
 
+    inline bool isBenchmarkMode() const
+    { return mBenchmarkMode; }
+
+    inline const std::string& getBenchmarkOutput() const
+    { return mBenchmarkOutput; }
+
+    inline const std::string& getBenchmarkBaseline() const
+    { return mBenchmarkBaseline; }
+
     inline int32_t getForcedNetworkPort() const
     { return mForcedNetworkPort; }
 
+    inline int32_t getSpectatorPort() const
+    { return mSpectatorPort; }
+
+    inline const std::string& getSpectateHost() const
+    { return mSpectateHost; }
+
     inline LogMessageLevel getLogLevel() const
     { return mLogLevel; }
 
@@ -157,9 +172,19 @@ private:
     std::string mServerModeLevel;
     std::string mServerModeCreator;
 
+    //! \brief used when the executable is launched in benchmark mode
+    bool mBenchmarkMode;
+    std::string mBenchmarkOutput;
+    std::string mBenchmarkBaseline;
+
     //! \brief used when the network port is forced
     int32_t mForcedNetworkPort;
 
+    //! \brief used when the game is relayed to spectators (server side) or
+    //! watched as a spectator (client side)
+    int32_t mSpectatorPort;
+    std::string mSpectateHost;
+
     //! \brief The log level
     LogMessageLevel mLogLevel;
 
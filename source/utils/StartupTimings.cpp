@@ -0,0 +1,62 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/StartupTimings.h"
+
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <SFML/System/Lock.hpp>
+
+#include <algorithm>
+
+StartupTimings::StartupTimings()
+{
+}
+
+void StartupTimings::addPhase(const std::string& name, const std::string& thread, sf::Time start, sf::Time end)
+{
+    sf::Lock locked(mLock);
+    Phase phase;
+    phase.mName = name;
+    phase.mThread = thread;
+    phase.mStart = start;
+    phase.mEnd = end;
+    mPhases.push_back(phase);
+}
+
+void StartupTimings::logReport()
+{
+    sf::Lock locked(mLock);
+    std::stable_sort(mPhases.begin(), mPhases.end(), [](const Phase& p1, const Phase& p2)
+    {
+        return p1.mStart < p2.mStart;
+    });
+
+    sf::Time total = sf::Time::Zero;
+    for(const Phase& phase : mPhases)
+        total = std::max(total, phase.mEnd);
+
+    OD_LOG_INF("Startup took " + Helper::toString(total.asMilliseconds()) + " ms");
+    for(const Phase& phase : mPhases)
+    {
+        OD_LOG_INF("  " + phase.mName + " [" + phase.mThread + "]: "
+            + Helper::toString((phase.mEnd - phase.mStart).asMilliseconds()) + " ms (from "
+            + Helper::toString(phase.mStart.asMilliseconds()) + " to "
+            + Helper::toString(phase.mEnd.asMilliseconds()) + " ms)");
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STARTUPTIMINGS_H
+#define STARTUPTIMINGS_H
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Mutex.hpp>
+
+#include <string>
+#include <vector>
+
+//! \brief Records how long each startup phase took. Phases may run concurrently (and be
+//! recorded from different threads) so each one is stored with its start and end relative
+//! to the creation of the StartupTimings. The report then shows both the duration of every
+//! phase and the wall clock time of the whole startup.
+class StartupTimings
+{
+public:
+    StartupTimings();
+
+    //! \brief Time elapsed since the creation of the timings. Used to get the start and the end of a phase
+    inline sf::Time getElapsedTime() const
+    { return mClock.getElapsedTime(); }
+
+    //! \brief Records a phase. thread is the name of the thread that ran it (only used in the report)
+    void addPhase(const std::string& name, const std::string& thread, sf::Time start, sf::Time end);
+
+    //! \brief Logs every recorded phase, in the order they started
+    void logReport();
+
+private:
+    struct Phase
+    {
+        std::string mName;
+        std::string mThread;
+        sf::Time mStart;
+        sf::Time mEnd;
+    };
+
+    sf::Clock mClock;
+    sf::Mutex mLock;
+    std::vector<Phase> mPhases;
+};
+
+#endif // STARTUPTIMINGS_H
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/ThreadPool.h"
+
+ThreadPool::ThreadPool(uint32_t maxThreads) :
+    mMaxThreads(maxThreads),
+    mTask(nullptr),
+    mNbTasks(0),
+    mNextTask(0),
+    mNbTasksDone(0),
+    mIsStopping(false)
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsStopping = true;
+    }
+    mTasksAvailable.notify_all();
+
+    for(std::thread& thread : mThreads)
+        thread.join();
+}
+
+void ThreadPool::run(uint32_t nbTasks, const std::function<void(uint32_t)>& task)
+{
+    if(nbTasks == 0)
+        return;
+
+    // The calling thread takes one of the tasks
+    while((mThreads.size() < mMaxThreads) && (mThreads.size() + 1 < nbTasks))
+        mThreads.emplace_back(&ThreadPool::threadLoop, this);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mTask = &task;
+    mNbTasks = nbTasks;
+    mNextTask = 0;
+    mNbTasksDone = 0;
+    mTasksAvailable.notify_all();
+
+    runTasks(lock);
+    mTasksDone.wait(lock, [this]() { return mNbTasksDone == mNbTasks; });
+
+    mTask = nullptr;
+    mNbTasks = 0;
+    mNextTask = 0;
+    mNbTasksDone = 0;
+}
+
+void ThreadPool::threadLoop()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while(true)
+    {
+        mTasksAvailable.wait(lock, [this]() { return mIsStopping || (mNextTask < mNbTasks); });
+        if(mIsStopping)
+            return;
+
+        runTasks(lock);
+    }
+}
+
+void ThreadPool::runTasks(std::unique_lock<std::mutex>& lock)
+{
+    while(mNextTask < mNbTasks)
+    {
+        uint32_t index = mNextTask;
+        ++mNextTask;
+        const std::function<void(uint32_t)>& task = *mTask;
+        lock.unlock();
+        task(index);
+        lock.lock();
+
+        ++mNbTasksDone;
+        if(mNbTasksDone == mNbTasks)
+            mTasksDone.notify_all();
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \brief Threads running batches of small tasks. The threads are created the first time they are
+//! needed and then wait for the next batch, so running a batch every turn does not pay for creating
+//! and destroying threads. The thread calling run() processes tasks too.
+class ThreadPool
+{
+public:
+    //! \brief At most maxThreads threads will be created (the calling thread excluded)
+    ThreadPool(uint32_t maxThreads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    //! \brief Calls task with every index in [0, nbTasks) and returns once every call is done.
+    //! Calls may run at the same time in different threads
+    void run(uint32_t nbTasks, const std::function<void(uint32_t)>& task);
+
+private:
+    uint32_t mMaxThreads;
+    std::vector<std::thread> mThreads;
+
+    //! \brief Protects the batch state below
+    std::mutex mMutex;
+    std::condition_variable mTasksAvailable;
+    std::condition_variable mTasksDone;
+
+    const std::function<void(uint32_t)>* mTask;
+    uint32_t mNbTasks;
+    uint32_t mNextTask;
+    uint32_t mNbTasksDone;
+    bool mIsStopping;
+
+    void threadLoop();
+
+    //! \brief Runs the remaining tasks of the current batch. The lock must be held. It is released
+    //! while a task runs
+    void runTasks(std::unique_lock<std::mutex>& lock);
+};
+
+#endif // THREADPOOL_H